@@ -0,0 +1,196 @@
+/**************************************************************************************************
+// file:	Benchmarks\a2de_bitmap_bench\main.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Startup image loading benchmark. Loads every image under a directory with the image
+//          decoders, fills the PixelCache, then loads them again from the PixelCache, and reports
+//          the times as JSON on stdout.
+//
+//          Build as a console executable against the Engine sources. Link allegro and
+//          allegro_image.
+//
+//          The operating system's file cache is warm after the first pass, so both timings
+//          measure decoding and uploading rather than the disk. Use --phase to run one pass per
+//          process after dropping the file cache for cold disk numbers.
+//
+//          usage: a2de_bitmap_bench assets_dir [--cache dir] [--runs n] [--memory]
+//                                   [--phase decode|cached|both]
+ **************************************************************************************************/
+#include "../../Engine/a2de_vals.h"
+#include "../../Engine/GFX/CPixelCache.h"
+#include "../../Engine/Time/CHighResolutionClock.h"
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// <summary> The results of timing one way of loading the asset set.</summary>
+struct PassResult {
+    PassResult() : best_seconds(0.0), mean_seconds(0.0), loaded(0), pixels(0) { /* DO NOTHING */ }
+    double best_seconds;
+    double mean_seconds;
+    unsigned long loaded;
+    unsigned long long pixels;
+};
+
+bool IsImageFile(const std::string& path) {
+    static const char* EXTENSIONS[] = { ".png", ".bmp", ".jpg", ".jpeg", ".tga", ".pcx" };
+    std::string::size_type dot = path.find_last_of('.');
+    if(dot == std::string::npos) return false;
+    std::string extension = path.substr(dot);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](char c)->char { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+    for(std::size_t i = 0; i < sizeof(EXTENSIONS) / sizeof(EXTENSIONS[0]); ++i) {
+        if(extension == EXTENSIONS[i]) return true;
+    }
+    return false;
+}
+
+void CollectImages(ALLEGRO_FS_ENTRY* directory, std::vector<std::string>& files) {
+    if(al_open_directory(directory) == false) return;
+    ALLEGRO_FS_ENTRY* entry = nullptr;
+    while((entry = al_read_directory(directory)) != nullptr) {
+        if(al_get_fs_entry_mode(entry) & ALLEGRO_FILEMODE_ISDIR) {
+            CollectImages(entry, files);
+        } else if(IsImageFile(al_get_fs_entry_name(entry))) {
+            files.push_back(al_get_fs_entry_name(entry));
+        }
+        al_destroy_fs_entry(entry);
+    }
+    al_close_directory(directory);
+}
+
+PassResult RunPass(const std::vector<std::string>& files, unsigned long runs) {
+    PassResult result;
+    double total = 0.0;
+    for(unsigned long run = 0; run < runs; ++run) {
+        std::vector<ALLEGRO_BITMAP*> bitmaps;
+        bitmaps.reserve(files.size());
+        unsigned long long start = a2de::HighResolutionClock::GetTicks();
+        for(std::vector<std::string>::const_iterator _iter = files.begin(); _iter != files.end(); ++_iter) {
+            bitmaps.push_back(a2de::PixelCache::Load(*_iter));
+        }
+        double seconds = a2de::HighResolutionClock::ToSeconds(a2de::HighResolutionClock::GetTicks() - start);
+        total += seconds;
+        if(run == 0 || seconds < result.best_seconds) result.best_seconds = seconds;
+
+        result.loaded = 0;
+        result.pixels = 0;
+        for(std::vector<ALLEGRO_BITMAP*>::iterator _iter = bitmaps.begin(); _iter != bitmaps.end(); ++_iter) {
+            if(*_iter == nullptr) continue;
+            ++result.loaded;
+            result.pixels += static_cast<unsigned long long>(al_get_bitmap_width(*_iter)) * al_get_bitmap_height(*_iter);
+            al_destroy_bitmap(*_iter);
+        }
+    }
+    result.mean_seconds = runs ? total / runs : 0.0;
+    return result;
+}
+
+void PrintPass(const char* name, const PassResult& result, bool last) {
+    std::printf("    \"%s\": {\n", name);
+    std::printf("      \"loaded\": %lu,\n", result.loaded);
+    std::printf("      \"pixels\": %llu,\n", result.pixels);
+    std::printf("      \"best_seconds\": %.6f,\n", result.best_seconds);
+    std::printf("      \"mean_seconds\": %.6f\n", result.mean_seconds);
+    std::printf("    }%s\n", last ? "" : ",");
+}
+
+}
+
+int main(int argc, char** argv) {
+    const char* assets = nullptr;
+    std::string cache_directory = "a2de_pixel_cache";
+    unsigned long runs = 3;
+    bool memory_bitmaps = false;
+    std::string phase = "both";
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cache_directory = argv[++i];
+        } else if(std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--memory") == 0) {
+            memory_bitmaps = true;
+        } else if(std::strcmp(argv[i], "--phase") == 0 && i + 1 < argc) {
+            phase = argv[++i];
+        } else if(argv[i][0] != '-' && assets == nullptr) {
+            assets = argv[i];
+        } else {
+            assets = nullptr;
+            break;
+        }
+    }
+    if(assets == nullptr || runs == 0 || (phase != "decode" && phase != "cached" && phase != "both")) {
+        std::fprintf(stderr, "usage: %s assets_dir [--cache dir] [--runs n] [--memory] [--phase decode|cached|both]\n", argv[0]);
+        return 1;
+    }
+
+    if(al_init() == false || al_init_image_addon() == false) {
+        std::fprintf(stderr, "Allegro failed to initialize.\n");
+        return 1;
+    }
+
+    //Video bitmaps include the upload, which is what startup pays. Fall back to memory bitmaps without a display.
+    ALLEGRO_DISPLAY* display = memory_bitmaps ? nullptr : al_create_display(64, 64);
+    if(display == nullptr) {
+        memory_bitmaps = true;
+        al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    }
+
+    std::vector<std::string> files;
+    ALLEGRO_FS_ENTRY* root = al_create_fs_entry(assets);
+    if(root != nullptr) {
+        CollectImages(root, files);
+        al_destroy_fs_entry(root);
+    }
+    std::sort(files.begin(), files.end());
+    if(files.empty()) {
+        std::fprintf(stderr, "No images found under '%s'.\n", assets);
+        return 1;
+    }
+
+    PassResult decode;
+    PassResult populate;
+    PassResult cached;
+    if(phase != "cached") {
+        a2de::PixelCache::SetDirectory("");
+        decode = RunPass(files, runs);
+    }
+    if(phase != "decode") {
+        if(a2de::PixelCache::SetDirectory(cache_directory) == false) {
+            std::fprintf(stderr, "Could not use '%s' for the pixel cache.\n", cache_directory.c_str());
+            return 1;
+        }
+        //Decodes whatever is missing or stale and writes it; a no-op pass if the cache is current.
+        populate = RunPass(files, 1);
+        cached = RunPass(files, runs);
+    }
+
+    std::printf("{\n");
+    std::printf("  \"files\": %lu,\n", static_cast<unsigned long>(files.size()));
+    std::printf("  \"runs\": %lu,\n", runs);
+    std::printf("  \"memory_bitmaps\": %s,\n", memory_bitmaps ? "true" : "false");
+    std::printf("  \"passes\": {\n");
+    if(phase != "cached") PrintPass("decode", decode, phase == "decode");
+    if(phase != "decode") {
+        PrintPass("populate", populate, false);
+        PrintPass("cached", cached, true);
+    }
+    std::printf("  }");
+    if(phase == "both") {
+        std::printf(",\n  \"speedup\": %.3f", cached.best_seconds > 0.0 ? decode.best_seconds / cached.best_seconds : 0.0);
+    }
+    std::printf("\n}\n");
+
+    if(display != nullptr) al_destroy_display(display);
+    return 0;
+}
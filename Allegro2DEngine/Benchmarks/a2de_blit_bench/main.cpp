@@ -0,0 +1,267 @@
+/**************************************************************************************************
+// file:	Benchmarks\a2de_blit_bench\main.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Software blit benchmark. Draws frames of sprites onto a memory bitmap with Allegro's
+//          own memory bitmap path and with each SoftwareBlitter kernel the processor supports,
+//          and reports the times as JSON on stdout.
+//
+//          Build as a console executable against the Engine sources. Link allegro.
+//
+//          Scenes are opaque copies, premultiplied alpha blends, tinted blends and horizontally
+//          flipped blends of one sprite at fixed pseudo-random positions, some of them clipped by
+//          the edges. Each kernel's first frame is compared with Allegro's; max_difference is the
+//          largest difference in any channel of any pixel and should be 0 or 1.
+//
+//          usage: a2de_blit_bench [--sprites n] [--frames n] [--runs n] [--size n]
+//                                 [--width n] [--height n]
+ **************************************************************************************************/
+#include "../../Engine/a2de_vals.h"
+#include "../../Engine/GFX/CSoftwareBlitter.h"
+#include "../../Engine/Time/CHighResolutionClock.h"
+
+#include <allegro5/allegro.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// <summary> One way of drawing the sprites.</summary>
+struct Scene {
+    const char* name;
+    bool copy;
+    ALLEGRO_COLOR tint;
+    int flags;
+};
+
+/// <summary> The results of timing one scene with one path.</summary>
+struct PassResult {
+    PassResult() : best_seconds(0.0), mean_seconds(0.0), fallbacks(0), max_difference(0) { /* DO NOTHING */ }
+    double best_seconds;
+    double mean_seconds;
+    unsigned long fallbacks;
+    int max_difference;
+};
+
+/// <summary> Where a sprite is drawn.</summary>
+struct Position {
+    float x;
+    float y;
+};
+
+/// <summary> Makes a sprite that is opaque in the middle, fades at the rim and is clear in the corners.</summary>
+ALLEGRO_BITMAP* CreateSprite(int size) {
+    ALLEGRO_BITMAP* sprite = al_create_bitmap(size, size);
+    if(sprite == nullptr) return nullptr;
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(sprite, ALLEGRO_PIXEL_FORMAT_ARGB_8888, ALLEGRO_LOCK_WRITEONLY);
+    if(region == nullptr) {
+        al_destroy_bitmap(sprite);
+        return nullptr;
+    }
+    float radius = size * 0.5f;
+    for(int y = 0; y < size; ++y) {
+        unsigned int* row = reinterpret_cast<unsigned int*>(static_cast<char*>(region->data) + y * region->pitch);
+        for(int x = 0; x < size; ++x) {
+            float dx = x + 0.5f - radius;
+            float dy = y + 0.5f - radius;
+            float edge = (radius - std::sqrt(dx * dx + dy * dy)) / (radius * 0.25f);
+            if(edge < 0.0f) edge = 0.0f;
+            if(edge > 1.0f) edge = 1.0f;
+            unsigned int alpha = static_cast<unsigned int>(edge * 255.0f + 0.5f);
+            //Premultiplied, as Allegro loads images by default.
+            unsigned int red = alpha * static_cast<unsigned int>(x * 255 / size) / 255;
+            unsigned int green = alpha * static_cast<unsigned int>(y * 255 / size) / 255;
+            unsigned int blue = alpha / 2;
+            row[x] = (alpha << 24) | (red << 16) | (green << 8) | blue;
+        }
+    }
+    al_unlock_bitmap(sprite);
+    return sprite;
+}
+
+unsigned long DrawFrame(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* sprite, const Scene& scene, const std::vector<Position>& positions, bool software) {
+    float width = static_cast<float>(al_get_bitmap_width(sprite));
+    float height = static_cast<float>(al_get_bitmap_height(sprite));
+    unsigned long fallbacks = 0;
+    if(software) a2de::SoftwareBlitter::Begin(dest);
+    for(std::vector<Position>::const_iterator _iter = positions.begin(); _iter != positions.end(); ++_iter) {
+        if(software && a2de::SoftwareBlitter::Blit(dest, sprite, 0.0f, 0.0f, width, height, scene.tint, _iter->x, _iter->y, scene.flags)) continue;
+        if(software) ++fallbacks;
+        al_draw_tinted_bitmap_region(sprite, scene.tint, 0.0f, 0.0f, width, height, _iter->x, _iter->y, scene.flags);
+    }
+    a2de::SoftwareBlitter::End();
+    return fallbacks;
+}
+
+void ReadPixels(ALLEGRO_BITMAP* bitmap, std::vector<unsigned int>& pixels) {
+    int width = al_get_bitmap_width(bitmap);
+    int height = al_get_bitmap_height(bitmap);
+    pixels.resize(static_cast<std::size_t>(width) * height);
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ARGB_8888, ALLEGRO_LOCK_READONLY);
+    if(region == nullptr) return;
+    for(int y = 0; y < height; ++y) {
+        std::memcpy(&pixels[static_cast<std::size_t>(y) * width], static_cast<const char*>(region->data) + y * region->pitch, width * sizeof(unsigned int));
+    }
+    al_unlock_bitmap(bitmap);
+}
+
+int MaxDifference(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b) {
+    int result = 0;
+    std::size_t count = a.size() < b.size() ? a.size() : b.size();
+    for(std::size_t i = 0; i < count; ++i) {
+        for(int shift = 0; shift < 32; shift += 8) {
+            int difference = static_cast<int>((a[i] >> shift) & 0xFF) - static_cast<int>((b[i] >> shift) & 0xFF);
+            if(difference < 0) difference = -difference;
+            if(difference > result) result = difference;
+        }
+    }
+    return result;
+}
+
+PassResult RunPass(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* sprite, const Scene& scene, const std::vector<Position>& positions, bool software, unsigned long frames, unsigned long runs, const std::vector<unsigned int>* reference, std::vector<unsigned int>& first_frame) {
+    PassResult result;
+    al_set_target_bitmap(dest);
+    if(scene.copy) {
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    } else {
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_INVERSE_ALPHA);
+    }
+
+    al_clear_to_color(al_map_rgb(32, 64, 96));
+    result.fallbacks = DrawFrame(dest, sprite, scene, positions, software);
+    ReadPixels(dest, first_frame);
+    if(reference != nullptr) result.max_difference = MaxDifference(*reference, first_frame);
+
+    double total = 0.0;
+    for(unsigned long run = 0; run < runs; ++run) {
+        al_clear_to_color(al_map_rgb(32, 64, 96));
+        unsigned long long start = a2de::HighResolutionClock::GetTicks();
+        for(unsigned long frame = 0; frame < frames; ++frame) {
+            DrawFrame(dest, sprite, scene, positions, software);
+        }
+        double seconds = a2de::HighResolutionClock::ToSeconds(a2de::HighResolutionClock::GetTicks() - start);
+        total += seconds;
+        if(run == 0 || seconds < result.best_seconds) result.best_seconds = seconds;
+    }
+    result.mean_seconds = total / runs;
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_INVERSE_ALPHA);
+    return result;
+}
+
+void PrintPass(const char* name, const PassResult& result, const PassResult* stock, bool last) {
+    std::printf("      \"%s\": {\n", name);
+    std::printf("        \"best_seconds\": %.6f,\n", result.best_seconds);
+    std::printf("        \"mean_seconds\": %.6f", result.mean_seconds);
+    if(stock != nullptr) {
+        std::printf(",\n        \"speedup\": %.3f,\n", result.best_seconds > 0.0 ? stock->best_seconds / result.best_seconds : 0.0);
+        std::printf("        \"fallbacks\": %lu,\n", result.fallbacks);
+        std::printf("        \"max_difference\": %d", result.max_difference);
+    }
+    std::printf("\n      }%s\n", last ? "" : ",");
+}
+
+}
+
+int main(int argc, char** argv) {
+    unsigned long sprites = 2000;
+    unsigned long frames = 60;
+    unsigned long runs = 3;
+    int size = 64;
+    int width = 640;
+    int height = 480;
+    bool valid = true;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--sprites") == 0 && i + 1 < argc) {
+            sprites = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            size = std::atoi(argv[++i]);
+        } else if(std::strcmp(argv[i], "--width") == 0 && i + 1 < argc) {
+            width = std::atoi(argv[++i]);
+        } else if(std::strcmp(argv[i], "--height") == 0 && i + 1 < argc) {
+            height = std::atoi(argv[++i]);
+        } else {
+            valid = false;
+            break;
+        }
+    }
+    if(valid == false || sprites == 0 || frames == 0 || runs == 0 || size <= 0 || width <= 0 || height <= 0) {
+        std::fprintf(stderr, "usage: %s [--sprites n] [--frames n] [--runs n] [--size n] [--width n] [--height n]\n", argv[0]);
+        return 1;
+    }
+
+    if(al_init() == false) {
+        std::fprintf(stderr, "Allegro failed to initialize.\n");
+        return 1;
+    }
+
+    //No display: every bitmap is a memory bitmap, the case the software blitter is for.
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    al_set_new_bitmap_format(ALLEGRO_PIXEL_FORMAT_ARGB_8888);
+    ALLEGRO_BITMAP* dest = al_create_bitmap(width, height);
+    ALLEGRO_BITMAP* sprite = CreateSprite(size);
+    if(dest == nullptr || sprite == nullptr) {
+        std::fprintf(stderr, "Could not create the bitmaps.\n");
+        return 1;
+    }
+
+    //A fixed generator so every path draws the same frame.
+    std::vector<Position> positions(sprites);
+    unsigned long seed = 12345;
+    for(std::vector<Position>::iterator _iter = positions.begin(); _iter != positions.end(); ++_iter) {
+        seed = seed * 1103515245UL + 12345UL;
+        _iter->x = static_cast<float>(static_cast<long>((seed >> 8) % static_cast<unsigned long>(width + size)) - size / 2);
+        seed = seed * 1103515245UL + 12345UL;
+        _iter->y = static_cast<float>(static_cast<long>((seed >> 8) % static_cast<unsigned long>(height + size)) - size / 2);
+    }
+
+    Scene scenes[] = {
+        { "opaque_copy", true, al_map_rgba(255, 255, 255, 255), 0 },
+        { "alpha_blend", false, al_map_rgba(255, 255, 255, 255), 0 },
+        { "tint", false, al_map_rgba(255, 128, 64, 192), 0 },
+        { "flip_horizontal", false, al_map_rgba(255, 255, 255, 255), ALLEGRO_FLIP_HORIZONTAL },
+    };
+    std::size_t scene_count = sizeof(scenes) / sizeof(scenes[0]);
+    a2de::SoftwareBlitter::KERNEL best = a2de::SoftwareBlitter::GetBestKernel();
+
+    std::printf("{\n");
+    std::printf("  \"sprites\": %lu,\n", sprites);
+    std::printf("  \"sprite_size\": %d,\n", size);
+    std::printf("  \"frames\": %lu,\n", frames);
+    std::printf("  \"runs\": %lu,\n", runs);
+    std::printf("  \"best_kernel\": \"%s\",\n", a2de::SoftwareBlitter::GetKernelName(best));
+    std::printf("  \"scenes\": {\n");
+    for(std::size_t i = 0; i < scene_count; ++i) {
+        const Scene& scene = scenes[i];
+        std::vector<unsigned int> reference;
+        std::vector<unsigned int> first_frame;
+
+        a2de::SoftwareBlitter::SetEnabled(false);
+        PassResult stock = RunPass(dest, sprite, scene, positions, false, frames, runs, nullptr, reference);
+
+        std::printf("    \"%s\": {\n", scene.name);
+        PrintPass("stock", stock, nullptr, false);
+        a2de::SoftwareBlitter::SetEnabled(true);
+        for(int kernel = a2de::SoftwareBlitter::KERNEL_SCALAR; kernel <= best; ++kernel) {
+            a2de::SoftwareBlitter::SetKernel(static_cast<a2de::SoftwareBlitter::KERNEL>(kernel));
+            PassResult software = RunPass(dest, sprite, scene, positions, true, frames, runs, &reference, first_frame);
+            PrintPass(a2de::SoftwareBlitter::GetKernelName(static_cast<a2de::SoftwareBlitter::KERNEL>(kernel)), software, &stock, kernel == best);
+        }
+        a2de::SoftwareBlitter::SetEnabled(false);
+        std::printf("    }%s\n", i + 1 == scene_count ? "" : ",");
+    }
+    std::printf("  }\n");
+    std::printf("}\n");
+
+    al_destroy_bitmap(sprite);
+    al_destroy_bitmap(dest);
+    return 0;
+}
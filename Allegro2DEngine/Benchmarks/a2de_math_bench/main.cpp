@@ -0,0 +1,204 @@
+/**************************************************************************************************
+// file:	Benchmarks\a2de_math_bench\main.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Math benchmark. Times the Vector2D and matrix work a frame does on many points and
+//          reports nanoseconds per point as JSON on stdout.
+//
+//          Build as a console executable against the Engine sources. Link allegro.
+//
+//          vector_integrate      p += v * dt on an array of Vector2D.
+//          matrix3x3_points      m * p.GetHomogeneous(), the only way to transform a point before
+//                                Matrix2x3.
+//          matrix2x3_point       Matrix2x3::TransformPoint one point at a time.
+//          matrix2x3_batch       Matrix2x3::TransformPoints on an array of Vector2D.
+//          matrix2x3_batch_soa   Matrix2x3::TransformPoints on separate x and y arrays.
+//
+//          Define A2DE_BENCH_BASELINE to leave out the Matrix2x3 scenes, so the same file builds
+//          against older Engine sources for a before and after comparison. checksum only guards
+//          against the work being optimized away; compare it between scenes, not between builds.
+//
+//          usage: a2de_math_bench [--points n] [--frames n] [--runs n]
+ **************************************************************************************************/
+#include "../../Engine/a2de_vals.h"
+#include "../../Engine/Math/CVector2D.h"
+#include "../../Engine/Math/CVector3D.h"
+#include "../../Engine/Math/CMatrix3x3.h"
+#ifndef A2DE_BENCH_BASELINE
+#include "../../Engine/Math/CMatrix2x3.h"
+#endif
+#include "../../Engine/Time/CHighResolutionClock.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// <summary> Seconds in one frame at 60 Hz.</summary>
+const double FRAME_SECONDS = 1.0 / 60.0;
+
+/// <summary> The scenes.</summary>
+enum SCENE {
+    SCENE_VECTOR_INTEGRATE,
+    SCENE_MATRIX3X3_POINTS,
+#ifndef A2DE_BENCH_BASELINE
+    SCENE_MATRIX2X3_POINT,
+    SCENE_MATRIX2X3_BATCH,
+    SCENE_MATRIX2X3_BATCH_SOA,
+#endif
+    SCENE_COUNT
+};
+
+const char* SCENE_NAMES[] = {
+    "vector_integrate",
+    "matrix3x3_points",
+#ifndef A2DE_BENCH_BASELINE
+    "matrix2x3_point",
+    "matrix2x3_batch",
+    "matrix2x3_batch_soa",
+#endif
+};
+
+/// <summary> The points and their velocities, kept both as Vector2D and as separate arrays.</summary>
+struct Points {
+    std::vector<a2de::Vector2D> positions;
+    std::vector<a2de::Vector2D> velocities;
+    std::vector<a2de::Vector2D> results;
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> result_x;
+    std::vector<double> result_y;
+};
+
+/// <summary> The results of timing one scene.</summary>
+struct SceneResult {
+    SceneResult() : best_seconds(0.0), mean_seconds(0.0), checksum(0.0) { /* DO NOTHING */ }
+    double best_seconds;
+    double mean_seconds;
+    double checksum;
+};
+
+void Fill(Points& points, std::size_t count) {
+    points.positions.resize(count);
+    points.velocities.resize(count);
+    points.results.resize(count);
+    points.x.resize(count);
+    points.y.resize(count);
+    points.result_x.resize(count);
+    points.result_y.resize(count);
+    for(std::size_t i = 0; i < count; ++i) {
+        double x = static_cast<double>(i % 640);
+        double y = static_cast<double>(i / 640 % 480);
+        points.positions[i] = a2de::Vector2D(x, y);
+        points.velocities[i] = a2de::Vector2D(1.0 + (i % 7), -1.0 - (i % 5));
+        points.x[i] = x;
+        points.y[i] = y;
+    }
+}
+
+double RunScene(SCENE scene, Points& points, unsigned long frames) {
+    std::size_t count = points.positions.size();
+    a2de::Matrix3x3 world3x3(a2de::Matrix3x3::GetTranslationMatrix(320.0, 240.0) * a2de::Matrix3x3::GetRotationMatrix(0.5) * a2de::Matrix3x3::GetScaleMatrix(2.0, 2.0));
+#ifndef A2DE_BENCH_BASELINE
+    a2de::Matrix2x3 world2x3(world3x3);
+#endif
+    double checksum = 0.0;
+    for(unsigned long frame = 0; frame < frames; ++frame) {
+        switch(scene) {
+            case SCENE_VECTOR_INTEGRATE:
+                for(std::size_t i = 0; i < count; ++i) {
+                    points.positions[i] += points.velocities[i] * FRAME_SECONDS;
+                }
+                checksum += points.positions[frame % count].GetX();
+                break;
+            case SCENE_MATRIX3X3_POINTS:
+                for(std::size_t i = 0; i < count; ++i) {
+                    a2de::Vector3D result(world3x3 * points.positions[i].GetHomogeneous());
+                    points.results[i] = a2de::Vector2D(result.GetX(), result.GetY());
+                }
+                checksum += points.results[frame % count].GetX();
+                break;
+#ifndef A2DE_BENCH_BASELINE
+            case SCENE_MATRIX2X3_POINT:
+                for(std::size_t i = 0; i < count; ++i) {
+                    points.results[i] = world2x3.TransformPoint(points.positions[i]);
+                }
+                checksum += points.results[frame % count].GetX();
+                break;
+            case SCENE_MATRIX2X3_BATCH:
+                world2x3.TransformPoints(&points.positions[0], &points.results[0], count);
+                checksum += points.results[frame % count].GetX();
+                break;
+            case SCENE_MATRIX2X3_BATCH_SOA:
+                world2x3.TransformPoints(&points.x[0], &points.y[0], &points.result_x[0], &points.result_y[0], count);
+                checksum += points.result_x[frame % count];
+                break;
+#endif
+            default:
+                break;
+        }
+    }
+    return checksum;
+}
+
+void PrintScene(const char* name, const SceneResult& result, unsigned long long items, bool last) {
+    std::printf("  \"%s\": {\n", name);
+    std::printf("    \"best_ns_per_point\": %.3f,\n", result.best_seconds * 1.0e9 / items);
+    std::printf("    \"mean_ns_per_point\": %.3f,\n", result.mean_seconds * 1.0e9 / items);
+    std::printf("    \"checksum\": %.6f\n", result.checksum);
+    std::printf("  }%s\n", last ? "" : ",");
+}
+
+}
+
+int main(int argc, char** argv) {
+    unsigned long point_count = 100000;
+    unsigned long frames = 300;
+    unsigned long runs = 3;
+    bool valid = true;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--points") == 0 && i + 1 < argc) {
+            point_count = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            valid = false;
+            break;
+        }
+    }
+    if(valid == false || point_count == 0 || frames == 0 || runs == 0) {
+        std::fprintf(stderr, "usage: %s [--points n] [--frames n] [--runs n]\n", argv[0]);
+        return 1;
+    }
+
+    Points points;
+    unsigned long long items = static_cast<unsigned long long>(point_count) * frames;
+
+    std::printf("{\n");
+    std::printf("  \"points\": %lu,\n", point_count);
+    std::printf("  \"frames\": %lu,\n", frames);
+    std::printf("  \"runs\": %lu,\n", runs);
+    std::printf("  \"vector2d_bytes\": %u,\n", static_cast<unsigned int>(sizeof(a2de::Vector2D)));
+    for(int scene = 0; scene < SCENE_COUNT; ++scene) {
+        SceneResult result;
+        double total = 0.0;
+        for(unsigned long run = 0; run < runs; ++run) {
+            Fill(points, point_count);
+            unsigned long long start = a2de::HighResolutionClock::GetTicks();
+            result.checksum = RunScene(static_cast<SCENE>(scene), points, frames);
+            double seconds = a2de::HighResolutionClock::ToSeconds(a2de::HighResolutionClock::GetTicks() - start);
+            total += seconds;
+            if(run == 0 || seconds < result.best_seconds) result.best_seconds = seconds;
+        }
+        result.mean_seconds = total / runs;
+        PrintScene(SCENE_NAMES[scene], result, items, scene + 1 == SCENE_COUNT);
+    }
+    std::printf("}\n");
+
+    return 0;
+}
@@ -0,0 +1,148 @@
+/**************************************************************************************************
+// file:	Benchmarks\a2de_particle_bench\main.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Particle benchmark. Keeps one ParticleEmitter full and reports the time Update and
+//          Draw take per frame as JSON on stdout.
+//
+//          Build as a console executable against the Engine sources. Link allegro and
+//          allegro_primitives.
+//
+//          Draw is timed while a RenderCommandList records, so it covers building the vertices
+//          and handing them over but not rasterizing them, which is the video card's work.
+//          frame_fraction is the share of a 60 Hz frame the two take together.
+//
+//          usage: a2de_particle_bench [--particles n] [--frames n] [--runs n] [--seed n]
+ **************************************************************************************************/
+#include "../../Engine/a2de_vals.h"
+#include "../../Engine/GFX/CParticleEmitter.h"
+#include "../../Engine/GFX/CRenderCommandList.h"
+#include "../../Engine/Time/CHighResolutionClock.h"
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_primitives.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+/// <summary> Seconds in one frame at 60 Hz.</summary>
+const double FRAME_SECONDS = 1.0 / 60.0;
+
+/// <summary> The results of timing one part of a frame.</summary>
+struct PartResult {
+    PartResult() : best_seconds(0.0), mean_seconds(0.0) { /* DO NOTHING */ }
+    double best_seconds;
+    double mean_seconds;
+};
+
+void PrintPart(const char* name, const PartResult& result, unsigned long frames, bool last) {
+    std::printf("  \"%s\": {\n", name);
+    std::printf("    \"best_ms_per_frame\": %.4f,\n", result.best_seconds * 1000.0 / frames);
+    std::printf("    \"mean_ms_per_frame\": %.4f\n", result.mean_seconds * 1000.0 / frames);
+    std::printf("  }%s\n", last ? "" : ",");
+}
+
+}
+
+int main(int argc, char** argv) {
+    unsigned long particles = 100000;
+    unsigned long frames = 300;
+    unsigned long runs = 3;
+    unsigned long seed = 12345;
+    bool valid = true;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--particles") == 0 && i + 1 < argc) {
+            particles = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            valid = false;
+            break;
+        }
+    }
+    if(valid == false || particles == 0 || frames == 0 || runs == 0) {
+        std::fprintf(stderr, "usage: %s [--particles n] [--frames n] [--runs n] [--seed n]\n", argv[0]);
+        return 1;
+    }
+
+    if(al_init() == false || al_init_primitives_addon() == false) {
+        std::fprintf(stderr, "Allegro failed to initialize.\n");
+        return 1;
+    }
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    ALLEGRO_BITMAP* dest = al_create_bitmap(640, 480);
+    if(dest == nullptr) {
+        std::fprintf(stderr, "Could not create the bitmap.\n");
+        return 1;
+    }
+
+    //A fountain whose particles live one to three seconds, emitted fast enough to stay full.
+    a2de::ParticleEmitterDef definition;
+    definition.max_particles = particles;
+    definition.emission_rate = particles / 2.0;
+    definition.position_x = 320.0;
+    definition.position_y = 400.0;
+    definition.spread_x = 8.0;
+    definition.angle = -1.5707963267948966;
+    definition.angle_spread = 0.5;
+    definition.speed_min = 100.0;
+    definition.speed_max = 300.0;
+    definition.acceleration_y = 150.0;
+    definition.life_min = 1.0;
+    definition.life_max = 3.0;
+    definition.size = 2.0;
+    definition.start_color = al_map_rgba_f(1.0f, 0.75f, 0.25f, 1.0f);
+    definition.end_color = al_map_rgba_f(0.0f, 0.0f, 0.0f, 0.0f);
+
+    PartResult update;
+    PartResult draw;
+    double update_total = 0.0;
+    double draw_total = 0.0;
+    a2de::RenderCommandList list;
+    for(unsigned long run = 0; run < runs; ++run) {
+        a2de::ParticleEmitter emitter(definition);
+        emitter.SetSeed(seed);
+        emitter.Emit(particles);
+
+        double update_seconds = 0.0;
+        double draw_seconds = 0.0;
+        for(unsigned long frame = 0; frame < frames; ++frame) {
+            unsigned long long start = a2de::HighResolutionClock::GetTicks();
+            emitter.Update(FRAME_SECONDS);
+            unsigned long long middle = a2de::HighResolutionClock::GetTicks();
+            list.BeginRecording();
+            emitter.Draw(dest);
+            list.EndRecording();
+            unsigned long long end = a2de::HighResolutionClock::GetTicks();
+            list.Clear();
+            update_seconds += a2de::HighResolutionClock::ToSeconds(middle - start);
+            draw_seconds += a2de::HighResolutionClock::ToSeconds(end - middle);
+        }
+        update_total += update_seconds;
+        draw_total += draw_seconds;
+        if(run == 0 || update_seconds < update.best_seconds) update.best_seconds = update_seconds;
+        if(run == 0 || draw_seconds < draw.best_seconds) draw.best_seconds = draw_seconds;
+    }
+    update.mean_seconds = update_total / runs;
+    draw.mean_seconds = draw_total / runs;
+
+    std::printf("{\n");
+    std::printf("  \"particles\": %lu,\n", particles);
+    std::printf("  \"frames\": %lu,\n", frames);
+    std::printf("  \"runs\": %lu,\n", runs);
+    PrintPart("update", update, frames, false);
+    PrintPart("draw", draw, frames, false);
+    std::printf("  \"frame_fraction\": %.4f\n", (update.best_seconds + draw.best_seconds) / frames / FRAME_SECONDS);
+    std::printf("}\n");
+
+    al_destroy_bitmap(dest);
+    return 0;
+}
@@ -0,0 +1,371 @@
+/**************************************************************************************************
+// file:	Benchmarks\a2de_physics_bench\main.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Headless physics benchmark. Runs canned World scenes without a display and reports
+//          steps per second, per-phase step times and peak memory as JSON on stdout.
+//
+//          Build as a console executable against the Engine sources with A2DE_PROFILE_PHYSICS
+//          defined for both; without it the phase times and counters are reported as zero.
+//          Link allegro and allegro_primitives.
+//
+//          usage: a2de_physics_bench [--scene name] [--steps n] [--seed n] [--deterministic]
+ **************************************************************************************************/
+#include "../../Engine/a2de_vals.h"
+#include "../../Engine/a2de_physics.h"
+#include "../../Engine/a2de_math.h"
+#include "../../Engine/Objects/ADTObject.h"
+#include "../../Engine/Time/CHighResolutionClock.h"
+
+#include <allegro5/allegro.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#  include <psapi.h>
+#  pragma comment(lib, "psapi.lib")
+#else
+#  include <sys/resource.h>
+#endif
+
+namespace {
+
+/**************************************************************************************************
+ * <summary>Minimal Object that owns a single rigid body.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.</remarks>
+ **************************************************************************************************/
+class BenchBody : public a2de::Object {
+public:
+    BenchBody(const a2de::RigidBodyDef& body_definition, a2de::Shape* collision_shape, const a2de::Vector2D& half_extents)
+        : a2de::Object(), _body(new a2de::RigidBody(body_definition)) {
+        _body->SetBoundingRectangle(new a2de::AABB(a2de::Transform2D(), half_extents));
+        _body->SetCollisionShape(collision_shape);
+        _body->SetPosition(body_definition.position_x, body_definition.position_y);
+    }
+
+    virtual ~BenchBody() {
+        delete _body;
+        _body = nullptr;
+    }
+
+    virtual void Update(double deltaTime) {
+        _body->Update(deltaTime);
+    }
+
+    virtual const a2de::RigidBody* GetBody() const {
+        return _body;
+    }
+
+    virtual a2de::RigidBody* GetBody() {
+        return _body;
+    }
+
+    virtual void Draw(ALLEGRO_BITMAP* /*dest*/) { /* DO NOTHING */ }
+
+private:
+    BenchBody(const BenchBody&);
+    BenchBody& operator=(const BenchBody&);
+
+    a2de::RigidBody* _body;
+};
+
+/**************************************************************************************************
+ * <summary>Small xorshift generator so scenes are identical on every platform and CRT.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.</remarks>
+ **************************************************************************************************/
+class SceneRandom {
+public:
+    SceneRandom(unsigned long long seed) : _state(seed ? seed : 0x9E3779B97F4A7C15ULL) { /* DO NOTHING */ }
+
+    double Next(double low, double high) {
+        _state ^= _state << 13;
+        _state ^= _state >> 7;
+        _state ^= _state << 17;
+        double unit = static_cast<double>(_state >> 11) / 9007199254740992.0;
+        return low + (high - low) * unit;
+    }
+
+private:
+    unsigned long long _state;
+};
+
+/// <summary> A scene: its World, the objects it owns and how many steps to run by default.</summary>
+struct Scene {
+    Scene() : world(nullptr), objects(), default_steps(0) { /* DO NOTHING */ }
+    a2de::World* world;
+    std::vector<BenchBody*> objects;
+    unsigned long default_steps;
+};
+
+const double STEP_SIZE = 1.0 / 60.0;
+
+a2de::RigidBodyDef MakeBodyDef(double mass, double x, double y, double vx, double vy) {
+    a2de::RigidBodyDef def;
+    def.mass = mass;
+    def.position_x = x;
+    def.position_y = y;
+    def.velocity_x = vx;
+    def.velocity_y = vy;
+    return def;
+}
+
+void AddCircle(Scene& scene, double mass, double x, double y, double vx, double vy, double radius) {
+    a2de::RigidBodyDef def(MakeBodyDef(mass, x, y, vx, vy));
+    BenchBody* body = new BenchBody(def, new a2de::Circle(x, y, radius, al_map_rgb(255, 255, 255), false), a2de::Vector2D(radius, radius));
+    scene.objects.push_back(body);
+    scene.world->AddObject(body);
+}
+
+void AddBox(Scene& scene, double mass, double x, double y, double vx, double vy, double half_width, double half_height) {
+    a2de::RigidBodyDef def(MakeBodyDef(mass, x, y, vx, vy));
+    BenchBody* body = new BenchBody(def, new a2de::Rectangle(x, y, half_width, half_height, al_map_rgb(255, 255, 255), false), a2de::Vector2D(half_width, half_height));
+    scene.objects.push_back(body);
+    scene.world->AddObject(body);
+}
+
+void AddLine(Scene& scene, double x1, double y1, double x2, double y2) {
+    double x = (x1 + x2) / 2.0;
+    double y = (y1 + y2) / 2.0;
+    a2de::RigidBodyDef def(MakeBodyDef(0.0, x, y, 0.0, 0.0));
+    def.gravity_mod_y = 0.0;
+    BenchBody* body = new BenchBody(def, new a2de::Line(x1, y1, x2, y2, al_map_rgb(255, 255, 255)), a2de::Vector2D(std::abs(x2 - x1) / 2.0 + 0.01, std::abs(y2 - y1) / 2.0 + 0.01));
+    scene.objects.push_back(body);
+    scene.world->AddObject(body);
+}
+
+a2de::World* MakeWorld(double width, double height, double gravity_y, bool deterministic) {
+    a2de::WorldDef def;
+    def.width = width;
+    def.height = height;
+    def.gravity_y = gravity_y;
+    def.deterministic = deterministic;
+    return new a2de::World(def);
+}
+
+//Rain of circles: 2000 circles falling onto a static floor.
+void BuildRainOfCircles(Scene& scene, SceneRandom& random, bool deterministic) {
+    scene.world = MakeWorld(200.0, 200.0, a2de::GravityForceGenerator::DEFAULT_GRAVITY_VALUE, deterministic);
+    scene.default_steps = 600;
+    AddLine(scene, 0.0, 195.0, 200.0, 195.0);
+    for(int i = 0; i < 2000; ++i) {
+        AddCircle(scene, 1.0, random.Next(2.0, 198.0), random.Next(2.0, 120.0), 0.0, 0.0, random.Next(0.25, 1.0));
+    }
+}
+
+//Box pyramid: a 40-wide stack of resting boxes on a static floor.
+void BuildBoxPyramid(Scene& scene, SceneRandom& /*random*/, bool deterministic) {
+    scene.world = MakeWorld(100.0, 100.0, a2de::GravityForceGenerator::DEFAULT_GRAVITY_VALUE, deterministic);
+    scene.default_steps = 600;
+    AddLine(scene, 0.0, 95.0, 100.0, 95.0);
+    const int base = 40;
+    const double half_size = 0.5;
+    for(int row = 0; row < base; ++row) {
+        int count = base - row;
+        double start_x = 50.0 - (count * half_size);
+        double y = 95.0 - half_size - (row * half_size * 2.0);
+        for(int i = 0; i < count; ++i) {
+            AddBox(scene, 1.0, start_x + half_size + (i * half_size * 2.0), y, 0.0, 0.0, half_size, half_size);
+        }
+    }
+}
+
+//Mixed shapes: circles and boxes dropped into a bowl of static lines.
+void BuildMixedShapes(Scene& scene, SceneRandom& random, bool deterministic) {
+    scene.world = MakeWorld(100.0, 100.0, a2de::GravityForceGenerator::DEFAULT_GRAVITY_VALUE, deterministic);
+    scene.default_steps = 600;
+    AddLine(scene, 0.0, 60.0, 50.0, 98.0);
+    AddLine(scene, 50.0, 98.0, 100.0, 60.0);
+    for(int i = 0; i < 1000; ++i) {
+        double x = random.Next(5.0, 95.0);
+        double y = random.Next(2.0, 50.0);
+        if(i % 2) {
+            AddCircle(scene, random.Next(0.5, 2.0), x, y, 0.0, 0.0, random.Next(0.3, 0.8));
+        } else {
+            AddBox(scene, random.Next(0.5, 2.0), x, y, 0.0, 0.0, random.Next(0.3, 0.8), random.Next(0.3, 0.8));
+        }
+    }
+}
+
+//Sparse: 100000 slow circles spread over a large world with no gravity. Stresses per-body overhead.
+void BuildSparse(Scene& scene, SceneRandom& random, bool deterministic) {
+    scene.world = MakeWorld(10000.0, 10000.0, 0.0, deterministic);
+    scene.default_steps = 60;
+    for(int i = 0; i < 100000; ++i) {
+        AddCircle(scene, 1.0, random.Next(1.0, 9999.0), random.Next(1.0, 9999.0), random.Next(-1.0, 1.0), random.Next(-1.0, 1.0), 0.5);
+    }
+}
+
+//Bullet swarm: 3000 tiny fast circles packed into a small area. Stresses the broad and narrow phase.
+void BuildBulletSwarm(Scene& scene, SceneRandom& random, bool deterministic) {
+    scene.world = MakeWorld(50.0, 50.0, 0.0, deterministic);
+    scene.default_steps = 300;
+    for(int i = 0; i < 3000; ++i) {
+        AddCircle(scene, 0.05, random.Next(1.0, 49.0), random.Next(1.0, 49.0), random.Next(-60.0, 60.0), random.Next(-60.0, 60.0), 0.1);
+    }
+}
+
+typedef void (*SceneBuilder)(Scene&, SceneRandom&, bool);
+
+struct SceneEntry {
+    const char* name;
+    SceneBuilder build;
+};
+
+const SceneEntry SCENES[] = {
+    { "rain_of_circles", &BuildRainOfCircles },
+    { "box_pyramid", &BuildBoxPyramid },
+    { "mixed_shapes", &BuildMixedShapes },
+    { "sparse_100k", &BuildSparse },
+    { "bullet_swarm", &BuildBulletSwarm },
+};
+
+unsigned long long GetPeakMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) == 0) return 0;
+    return static_cast<unsigned long long>(counters.PeakWorkingSetSize);
+#else
+    struct rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+    //ru_maxrss is in kilobytes on Linux.
+    return static_cast<unsigned long long>(usage.ru_maxrss) * 1024ULL;
+#endif
+}
+
+void DestroyScene(Scene& scene) {
+    delete scene.world;
+    scene.world = nullptr;
+    for(std::size_t i = 0; i < scene.objects.size(); ++i) {
+        delete scene.objects[i];
+    }
+    scene.objects.clear();
+}
+
+void RunScene(const SceneEntry& entry, unsigned long steps_override, unsigned long long seed, bool deterministic, bool first) {
+    Scene scene;
+    SceneRandom random(seed);
+    entry.build(scene, random, deterministic);
+
+    unsigned long steps = steps_override ? steps_override : scene.default_steps;
+    a2de::WorldStepStats totals;
+    unsigned long long max_contacts = 0;
+
+    unsigned long long start = a2de::HighResolutionClock::GetTicks();
+    for(unsigned long i = 0; i < steps; ++i) {
+        scene.world->Update(STEP_SIZE);
+        const a2de::WorldStepStats& stats = scene.world->GetStepStats();
+        totals.force_generation_time += stats.force_generation_time;
+        totals.integration_time += stats.integration_time;
+        totals.grid_time += stats.grid_time;
+        totals.broad_phase_time += stats.broad_phase_time;
+        totals.narrow_phase_time += stats.narrow_phase_time;
+        totals.solver_time += stats.solver_time;
+        totals.candidate_pair_count += stats.candidate_pair_count;
+        totals.aabb_rejected_pair_count += stats.aabb_rejected_pair_count;
+        totals.contact_count += stats.contact_count;
+        if(stats.contact_count > max_contacts) max_contacts = stats.contact_count;
+        if(stats.quadtree_depth > totals.quadtree_depth) totals.quadtree_depth = stats.quadtree_depth;
+        if(stats.quadtree_node_count > totals.quadtree_node_count) totals.quadtree_node_count = stats.quadtree_node_count;
+    }
+    double seconds = a2de::HighResolutionClock::ToSeconds(a2de::HighResolutionClock::GetTicks() - start);
+
+    double per_step_ms = steps ? 1000.0 / steps : 0.0;
+    std::printf("%s    {\n", first ? "" : ",\n");
+    std::printf("      \"name\": \"%s\",\n", entry.name);
+    std::printf("      \"bodies\": %lu,\n", static_cast<unsigned long>(scene.objects.size()));
+    std::printf("      \"steps\": %lu,\n", steps);
+    std::printf("      \"seconds\": %.6f,\n", seconds);
+    std::printf("      \"steps_per_sec\": %.3f,\n", seconds > 0.0 ? steps / seconds : 0.0);
+    std::printf("      \"phase_ms_per_step\": {\n");
+    std::printf("        \"force_generation\": %.6f,\n", totals.force_generation_time * per_step_ms);
+    std::printf("        \"integration\": %.6f,\n", totals.integration_time * per_step_ms);
+    std::printf("        \"grid\": %.6f,\n", totals.grid_time * per_step_ms);
+    std::printf("        \"broad_phase\": %.6f,\n", totals.broad_phase_time * per_step_ms);
+    std::printf("        \"narrow_phase\": %.6f,\n", totals.narrow_phase_time * per_step_ms);
+    std::printf("        \"solver\": %.6f\n", totals.solver_time * per_step_ms);
+    std::printf("      },\n");
+    std::printf("      \"counters_per_step\": {\n");
+    std::printf("        \"candidate_pairs\": %.3f,\n", steps ? static_cast<double>(totals.candidate_pair_count) / steps : 0.0);
+    std::printf("        \"aabb_rejected_pairs\": %.3f,\n", steps ? static_cast<double>(totals.aabb_rejected_pair_count) / steps : 0.0);
+    std::printf("        \"contacts\": %.3f,\n", steps ? static_cast<double>(totals.contact_count) / steps : 0.0);
+    std::printf("        \"max_contacts\": %llu,\n", max_contacts);
+    std::printf("        \"max_quadtree_depth\": %lu,\n", totals.quadtree_depth);
+    std::printf("        \"max_quadtree_nodes\": %lu\n", totals.quadtree_node_count);
+    std::printf("      },\n");
+    std::printf("      \"state_hash\": \"%016llx\",\n", scene.world->GetStateHash());
+    //Process-wide high water mark, so it never decreases between scenes. Run one scene per process
+    //with --scene for a per-scene figure.
+    std::printf("      \"peak_memory_bytes\": %llu\n", GetPeakMemoryBytes());
+    std::printf("    }");
+    std::fflush(stdout);
+
+    DestroyScene(scene);
+}
+
+}
+
+int main(int argc, char** argv) {
+
+    const char* only_scene = nullptr;
+    unsigned long steps = 0;
+    unsigned long long seed = 12345;
+    bool deterministic = false;
+
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            only_scene = argv[++i];
+        } else if(std::strcmp(argv[i], "--steps") == 0 && i + 1 < argc) {
+            steps = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--deterministic") == 0) {
+            deterministic = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--scene name] [--steps n] [--seed n] [--deterministic]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    //No display is created: World runs headless.
+    if(al_init() == false) {
+        std::fprintf(stderr, "Allegro failed to initialize.\n");
+        return 1;
+    }
+
+#ifdef A2DE_PROFILE_PHYSICS
+    const char* profiled = "true";
+#else
+    const char* profiled = "false";
+#endif
+
+    std::printf("{\n  \"profiled\": %s,\n  \"deterministic\": %s,\n  \"seed\": %llu,\n  \"step_size\": %.9f,\n  \"scenes\": [\n", profiled, deterministic ? "true" : "false", seed, STEP_SIZE);
+
+    bool first = true;
+    std::size_t scene_count = sizeof(SCENES) / sizeof(SCENES[0]);
+    for(std::size_t i = 0; i < scene_count; ++i) {
+        if(only_scene && std::strcmp(only_scene, SCENES[i].name) != 0) continue;
+        RunScene(SCENES[i], steps, seed, deterministic, first);
+        first = false;
+    }
+
+    std::printf("\n  ]\n}\n");
+
+    if(first && only_scene) {
+        std::fprintf(stderr, "Unknown scene '%s'.\n", only_scene);
+        return 1;
+    }
+    return 0;
+}
@@ -17,6 +17,9 @@
 #include <string>
 
 #include "CAnimationHandler.h"
+#include "CAssetPack.h"
+#include "CBitmapCache.h"
+#include "CRenderThread.h"
 
 A2DE_BEGIN
 
@@ -32,7 +35,7 @@ AnimatedSprite* AnimatedSprite::CreateAnimatedSprite(const std::string& name, AL
 
 AnimatedSprite* AnimatedSprite::CreateAnimatedSprite(const std::string& file, double frameRate) {
     if(file.empty() == false) {
-        if(al_filename_exists(file.c_str()) == false) {
+        if(AssetPack::FileExists(file) == false) {
             throw FileNotFoundException(file);
         }
     } else {
@@ -46,27 +49,27 @@ AnimatedSprite* AnimatedSprite::CreateAnimatedSprite(const AnimatedSprite& anima
 }
 
 AnimatedSprite::AnimatedSprite(const std::string& name, ALLEGRO_BITMAP* file, double frameRate)
-    : Sprite(name, file), _frameImage(nullptr), _frameRate(frameRate), _animation(nullptr), _accumulator(0.0) {
+    : Sprite(name, file), _frameImage(nullptr), _frameRegion(), _frameSheet(nullptr), _frameImages(), _frameRate(frameRate), _animation(nullptr), _accumulator(0.0) {
         if(_frameRate < 0.0) _frameRate = 0.0;
         _frameDimensions = Vector2D(0.0, 0.0);
         _animation = new AnimationHandler(*this);
 }
 
 AnimatedSprite::AnimatedSprite(const std::string& file, double frameRate)
-    : Sprite(file), _frameImage(nullptr), _frameRate(frameRate), _animation(nullptr), _accumulator(0.0) {
+    : Sprite(file), _frameImage(nullptr), _frameRegion(), _frameSheet(nullptr), _frameImages(), _frameRate(frameRate), _animation(nullptr), _accumulator(0.0) {
         if(_frameRate < 0.0) _frameRate = 0.0;
         _frameDimensions = Vector2D(0.0, 0.0);
         _animation = new AnimationHandler(*this);
 }
 
 AnimatedSprite::AnimatedSprite(const AnimatedSprite& animatedSprite)
- : Sprite(animatedSprite), _frameImage(nullptr), _frameRate(animatedSprite._frameRate), _animation(nullptr), _accumulator(0.0) {
-    this->_frameImage = al_create_bitmap(al_get_bitmap_width(animatedSprite._frameImage), al_get_bitmap_height(animatedSprite._frameImage));
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(this->_frameImage);
-    al_clear_to_color(al_map_rgb(0, 0, 0));
-    al_set_target_bitmap(old_target);
+ : Sprite(animatedSprite), _frameImage(nullptr), _frameRegion(), _frameSheet(nullptr), _frameImages(), _frameRate(animatedSprite._frameRate), _animation(nullptr), _accumulator(0.0) {
     this->_frameDimensions = animatedSprite._frameDimensions;
+    //Show the same region of the shared sheet; nothing is drawn.
+    if(animatedSprite._frameImage != nullptr) {
+        const FrameRegion& region = animatedSprite._frameRegion;
+        SetFrameRegion(region.x, region.y, region.width, region.height);
+    }
     if(animatedSprite._animation != nullptr) {
         delete this->_animation;
         this->_animation = new AnimationHandler(*animatedSprite._animation);
@@ -77,8 +80,8 @@ AnimatedSprite::AnimatedSprite(const AnimatedSprite& animatedSprite)
 }
 
 AnimatedSprite::~AnimatedSprite() {
-    al_destroy_bitmap(_frameImage);
-    _frameImage = nullptr;
+    //The frame images are sub-bitmaps of the sheet; they go before Sprite releases it.
+    ReleaseFrameImages();
     delete _animation;
     _animation = nullptr;
 }
@@ -87,6 +90,10 @@ ALLEGRO_BITMAP* AnimatedSprite::GetImage() const {
     return _frameImage;
 }
 ALLEGRO_BITMAP* AnimatedSprite::GetImage() {
+    //Move the frame onto the real sheet once an asynchronously loaded one is ready.
+    if(_frameImage != nullptr && Sprite::GetImage() != _frameSheet) {
+        SetFrameRegion(_frameRegion.x, _frameRegion.y, _frameRegion.width, _frameRegion.height);
+    }
     return static_cast<const AnimatedSprite&>(*this).GetImage();
 }
 
@@ -97,6 +104,24 @@ ALLEGRO_BITMAP* AnimatedSprite::GetSheet() {
     return static_cast<const AnimatedSprite&>(*this).GetSheet();
 }
 
+bool AnimatedSprite::GenerateCollisionMask() {
+    _useCollisionMask = true;
+    if(_animation == nullptr) return true;
+    bool generated = true;
+    for(AnimationHandler::AnimMapIter _iter = _animation->Begin(); _iter != _animation->End(); ++_iter) {
+        std::size_t frame_count = _iter->second.Size();
+        for(std::size_t i = 0; i < frame_count; ++i) {
+            if(_iter->second.GetFrameAt(i).GetCollisionMask(_file) == nullptr) generated = false;
+        }
+    }
+    return generated;
+}
+
+const CollisionMask* AnimatedSprite::GetCollisionMask() {
+    if(_useCollisionMask == false || _frameImage == nullptr) return nullptr;
+    return BitmapCache::GetCollisionMask(_file, _frameRegion.x, _frameRegion.y, _frameRegion.width, _frameRegion.height);
+}
+
 void AnimatedSprite::Animate(const std::string& name, AnimationHandler::DIRECTION dir, double deltaTime) {
 
     _accumulator += deltaTime;
@@ -156,33 +181,58 @@ AnimationHandler* AnimatedSprite::GetAnimationHandler() {
 }
 
 void AnimatedSprite::ResizeFrame(unsigned int width, unsigned int height) {
+    SetFrameRegion(_frameRegion.x, _frameRegion.y, width, height);
+}
 
-    //Frame Image hasn't been created yet, create and re-call method.
-    if(_frameImage == nullptr) {
-        this->_frameDimensions = Vector2D(width, height);
-        CalcCenterFrame();
-        _frameImage = al_create_bitmap(width, height);
-        ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-        al_set_target_bitmap(_frameImage);
-        al_clear_to_color(al_map_rgb(0, 0, 0));
-        al_set_target_bitmap(old_target);
-        ResizeFrame(width, height);
-        return;
+void AnimatedSprite::SetFrameRegion(int x, int y, int width, int height) {
+    if(width <= 0 || height <= 0) return;
+
+    ALLEGRO_BITMAP* sheet = Sprite::GetImage();
+    if(sheet == nullptr) return;
+    if(sheet != _frameSheet) {
+        ReleaseFrameImages();
+        _frameSheet = sheet;
     }
 
-    double fdX = this->_frameDimensions.GetX();
-    double fdY = this->_frameDimensions.GetY();
-    if(static_cast<unsigned int>(fdX) == width && static_cast<unsigned int>(fdY) == height) return;
+    FrameRegion region;
+    region.x = x;
+    region.y = y;
+    region.width = width;
+    region.height = height;
+
+    std::map<FrameRegion, ALLEGRO_BITMAP*>::iterator _iter = _frameImages.find(region);
+    if(_iter == _frameImages.end()) {
+        ALLEGRO_BITMAP* frame = al_create_sub_bitmap(sheet, x, y, width, height);
+        if(frame == nullptr) return;
+        _iter = _frameImages.insert(std::make_pair(region, frame)).first;
+    }
+    //Cover both the old frame and the new one, which may be a different size.
+    bool changed = _iter->second != _frameImage;
+    if(changed) InvalidateDrawnArea();
+    _frameImage = _iter->second;
+    _frameRegion = region;
+
+    if(static_cast<int>(_frameDimensions.GetX()) != width || static_cast<int>(_frameDimensions.GetY()) != height) {
+        _frameDimensions = Vector2D(width, height);
+        CalcCenterFrame();
+    }
+    if(changed) InvalidateDrawnArea();
+}
 
-    this->_frameDimensions = Vector2D(width, height);
-    CalcCenterFrame();
-    al_destroy_bitmap(this->_frameImage);
-    this->_frameImage = al_create_bitmap(width, height);
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(_frameImage);
-    al_clear_to_color(al_map_rgb(0, 0, 0));
-    al_set_target_bitmap(old_target);
+void AnimatedSprite::ReleaseFrameImages() {
+    for(std::map<FrameRegion, ALLEGRO_BITMAP*>::iterator _iter = _frameImages.begin(); _iter != _frameImages.end(); ++_iter) {
+        RenderThread::DestroyBitmap(_iter->second);
+    }
+    _frameImages.clear();
+    _frameImage = nullptr;
+    _frameSheet = nullptr;
+}
 
+bool AnimatedSprite::FrameRegion::operator<(const FrameRegion& rhs) const {
+    if(x != rhs.x) return x < rhs.x;
+    if(y != rhs.y) return y < rhs.y;
+    if(width != rhs.width) return width < rhs.width;
+    return height < rhs.height;
 }
 
 int AnimatedSprite::GetWidth() const {
@@ -10,6 +10,7 @@
 
 #include "../a2de_vals.h"
 #include "CSprite.h"
+#include <map>
 #include <vector>
 #include <iostream>
 
@@ -18,6 +19,7 @@ struct ALLEGRO_BITMAP;
 A2DE_BEGIN
 
 class AnimationHandler;
+class AnimationSystem;
 
 /**************************************************************************************************
  * <summary>Animated sprite.</summary>
@@ -161,6 +163,21 @@ public:
      **************************************************************************************************/
     virtual AnimationHandler* GetAnimationHandler();
 
+    /**************************************************************************************************
+     * <summary>Builds the collision mask of every frame of every animation and turns them on.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Add the animations first. Frames added later get their masks when first shown.</remarks>
+     * <returns>true if it succeeds, false if the sheet is still loading.</returns>
+     **************************************************************************************************/
+    virtual bool GenerateCollisionMask();
+
+    /**************************************************************************************************
+     * <summary>Gets the collision mask of the current frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>null if GenerateCollisionMask was not called, no frame is shown or the sheet is still loading, else the mask.</returns>
+     **************************************************************************************************/
+    virtual const CollisionMask* GetCollisionMask();
+
 protected:
 
     /**************************************************************************************************
@@ -205,9 +222,47 @@ protected:
      **************************************************************************************************/
     virtual void ResizeFrame(unsigned int width, unsigned int height);
 
+    /**************************************************************************************************
+     * <summary>Sets the region of the sheet shown as the current frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <remarks>The first time a region is shown a sub-bitmap of the sheet is made for it and kept,
+     *          so changing frames afterwards neither allocates nor draws.</remarks>
+     * <param name="x">     The left edge of the frame on the sheet.</param>
+     * <param name="y">     The top edge of the frame on the sheet.</param>
+     * <param name="width"> The width.</param>
+     * <param name="height">The height.</param>
+     **************************************************************************************************/
+    virtual void SetFrameRegion(int x, int y, int width, int height);
+
 private:
-    /// <summary> The current frame image </summary>
+
+    /**************************************************************************************************
+     * <summary>A region of the sheet.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct FrameRegion {
+        FrameRegion() : x(0), y(0), width(0), height(0) { /* DO NOTHING */ }
+        int x;
+        int y;
+        int width;
+        int height;
+        bool operator<(const FrameRegion& rhs) const;
+    };
+
+    /**************************************************************************************************
+     * <summary>Destroys the sub-bitmaps of every region shown so far.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void ReleaseFrameImages();
+
+    /// <summary> The current frame image, a sub-bitmap of the sheet.</summary>
     ALLEGRO_BITMAP* _frameImage;
+    /// <summary> The region of the sheet the current frame shows.</summary>
+    FrameRegion _frameRegion;
+    /// <summary> The sheet the frame images were made from.</summary>
+    ALLEGRO_BITMAP* _frameSheet;
+    /// <summary> The sub-bitmap of every region shown so far.</summary>
+    std::map<FrameRegion, ALLEGRO_BITMAP*> _frameImages;
     /// <summary> The frame rate </summary>
     double _frameRate;
     /// <summary> The animation handler.</summary>
@@ -216,6 +271,7 @@ private:
     double _accumulator;
 
     friend AnimationHandler;
+    friend AnimationSystem;
 };
 
 A2DE_END
@@ -10,6 +10,8 @@
 #include <iostream>
 #include <fstream>
 
+#include "CBitmapCache.h"
+
 A2DE_BEGIN
 
 AnimationFrame::AnimationFrame() : _position(0, 0), _dimensions(1, 1) { }
@@ -71,4 +73,8 @@ int AnimationFrame::GetY() {
     return static_cast<const AnimationFrame&>(*this).GetY();
 }
 
+const CollisionMask* AnimationFrame::GetCollisionMask(const std::string& sheet) const {
+    return BitmapCache::GetCollisionMask(sheet, _position.first, _position.second, _dimensions.first, _dimensions.second);
+}
+
 A2DE_END
\ No newline at end of file
@@ -9,10 +9,13 @@
 #define A2DE_CANIMATIONFRAME_H
 
 #include "../a2de_vals.h"
+#include <string>
 #include <utility>
 
 A2DE_BEGIN
 
+class CollisionMask;
+
 /**************************************************************************************************
  * <summary>Animation frame. </summary>
  * <remarks>Casey Ugone, 6/29/2012.</remarks>
@@ -130,6 +133,15 @@ public:
      **************************************************************************************************/
     int GetY();
 
+    /**************************************************************************************************
+     * <summary>Gets the collision mask of the frame, building it on first request.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The mask is kept with the sheet in the BitmapCache.</remarks>
+     * <param name="sheet">The name or filename of the sheet the frame is on.</param>
+     * <returns>null if the sheet is not cached or is still loading, else the mask.</returns>
+     **************************************************************************************************/
+    const CollisionMask* GetCollisionMask(const std::string& sheet) const;
+
 protected:
 
 private:
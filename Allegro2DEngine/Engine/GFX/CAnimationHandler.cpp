@@ -13,9 +13,6 @@
 
 #include "../a2de_exceptions.h"
 
-#include <allegro5/display.h>
-#include <allegro5/bitmap_draw.h>
-
 A2DE_BEGIN
 
 typedef std::map<std::string, AnimationFrameSet> AnimMap;
@@ -43,7 +40,7 @@ bool AnimationHandler::AddAnimation(const std::string& name, const AnimationFram
     if(was_empty) {
         AnimMapIter first_animation = _animations.begin();
         first_animation->second.First();
-        CopyCurrentFrameToImageFrame(first_animation);
+        SelectCurrentFrame(first_animation);
     }
     return true;
 }
@@ -133,7 +130,7 @@ void AnimationHandler::Animate(const std::string& name, AnimationHandler::DIRECT
         }
     }
 
-    CopyCurrentFrameToImageFrame(_iter);
+    SelectCurrentFrame(_iter);
 }
 
 void AnimationHandler::Play(const std::string& name, bool rewindOnCompletion) {
@@ -168,21 +165,9 @@ a2de::AnimMapIter AnimationHandler::End() {
     return _animations.end();
 }
 
-void AnimationHandler::CopyCurrentFrameToImageFrame(AnimMapIter _iter) {
-    a2de::AnimationFrame curFrame = _iter->second.GetCurFrame();
-    double curFrameWidth = curFrame.GetWidth();
-    double curFrameHeight = curFrame.GetHeight();
-    double curFrameX = curFrame.GetX();
-    double curFrameY = curFrame.GetY();
-
-    _observed->ResizeFrame(curFrameWidth, curFrameHeight);
-    
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(_observed->GetImage());
-
-    al_draw_bitmap_region(_observed->GetSheet(), curFrameX, curFrameY, curFrameWidth, curFrameHeight, 0, 0, 0);
-
-    al_set_target_bitmap(old_target);
+void AnimationHandler::SelectCurrentFrame(AnimMapIter _iter) {
+    const a2de::AnimationFrame& curFrame = _iter->second.GetCurFrame();
+    _observed->SetFrameRegion(curFrame.GetX(), curFrame.GetY(), curFrame.GetWidth(), curFrame.GetHeight());
 }
 
 
@@ -211,7 +211,12 @@ protected:
      **************************************************************************************************/
     void Animate(const std::string& name, AnimationHandler::DIRECTION dir);
 
-    void CopyCurrentFrameToImageFrame(AnimMapIter _iter);
+    /**************************************************************************************************
+     * <summary>Points the observed sprite at the current frame of an animation.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="_iter">The animation.</param>
+     **************************************************************************************************/
+    void SelectCurrentFrame(AnimMapIter _iter);
 
 private:
     /// <summary> The animations </summary>
@@ -0,0 +1,267 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CAnimationSystem.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the animation system class.
+ **************************************************************************************************/
+#include "CAnimationSystem.h"
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+#include "../a2de_exceptions.h"
+#include "CAnimatedSprite.h"
+#include "CAnimationFrame.h"
+#include "CAnimationFrameSet.h"
+
+A2DE_BEGIN
+
+/************************************************************************/
+/* DO NOT DEFINE CONSTRUCTORS, DESTRUCTOR, ASSIGNMENT OPERATOR!         */
+/************************************************************************/
+
+namespace {
+
+    /// <summary> A region of a sheet.</summary>
+    struct Frame {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    /// <summary> A compiled clip: a run of the frame array.</summary>
+    struct Clip {
+        unsigned int first_frame;
+        unsigned int frame_count;
+        double frame_time;
+    };
+
+    /// <summary> The playback state of one instance.</summary>
+    struct Playback {
+        AnimationSystem::ClipId clip;
+        unsigned int frame;
+        double time;
+        AnimationHandler::DIRECTION dir;
+        bool playing;
+    };
+
+    /// <summary> The frames of every clip, clip after clip.</summary>
+    std::vector<Frame> frames;
+    /// <summary> The clips, by id.</summary>
+    std::vector<Clip> clips;
+    /// <summary> The named clips.</summary>
+    std::map<std::string, AnimationSystem::ClipId> clip_names;
+    /// <summary> The playback state of every instance, packed so Update walks it front to back.</summary>
+    std::vector<Playback> playbacks;
+    /// <summary> The sprite of every instance, parallel to playbacks.</summary>
+    std::vector<AnimatedSprite*> sprites;
+    /// <summary> The instance id of every entry, parallel to playbacks.</summary>
+    std::vector<AnimationSystem::InstanceId> owners;
+    /// <summary> Maps instance ids to their index in playbacks, or INVALID_ID if free.</summary>
+    std::vector<unsigned int> slots;
+    /// <summary> Instance ids free for reuse.</summary>
+    std::vector<AnimationSystem::InstanceId> free_ids;
+    /// <summary> The entries whose frame changed during the current Update.</summary>
+    std::vector<std::size_t> changed;
+
+    std::size_t GetSlot(AnimationSystem::InstanceId instance) {
+        if(instance >= slots.size() || slots[instance] == AnimationSystem::INVALID_ID) throw IndexOutOfBoundsException("instance", "0", "slots.size() - 1");
+        return slots[instance];
+    }
+
+}
+
+const unsigned int AnimationSystem::INVALID_ID;
+
+AnimationSystem::ClipId AnimationSystem::CompileClip(const AnimationFrameSet& frame_set, double frame_time) {
+    std::size_t count = frame_set.Size();
+    if(count == 0) return INVALID_ID;
+
+    Clip clip;
+    clip.first_frame = static_cast<unsigned int>(frames.size());
+    clip.frame_count = static_cast<unsigned int>(count);
+    clip.frame_time = frame_time < 0.0 ? 0.0 : frame_time;
+
+    frames.reserve(frames.size() + count);
+    for(std::size_t i = 0; i < count; ++i) {
+        const AnimationFrame& source = frame_set.GetFrameAt(i);
+        Frame frame;
+        frame.x = source.GetX();
+        frame.y = source.GetY();
+        frame.width = source.GetWidth();
+        frame.height = source.GetHeight();
+        frames.push_back(frame);
+    }
+    clips.push_back(clip);
+    return static_cast<ClipId>(clips.size() - 1);
+}
+
+AnimationSystem::ClipId AnimationSystem::CompileClip(const std::string& name, const AnimationFrameSet& frame_set, double frame_time) {
+    if(clip_names.find(name) != clip_names.end()) return INVALID_ID;
+    ClipId clip = CompileClip(frame_set, frame_time);
+    if(clip != INVALID_ID) clip_names.insert(std::make_pair(name, clip));
+    return clip;
+}
+
+AnimationSystem::ClipId AnimationSystem::FindClip(const std::string& name) {
+    std::map<std::string, ClipId>::const_iterator _iter = clip_names.find(name);
+    if(_iter == clip_names.end()) return INVALID_ID;
+    return _iter->second;
+}
+
+std::size_t AnimationSystem::GetFrameCount(ClipId clip) {
+    if(clip >= clips.size()) throw IndexOutOfBoundsException("clip", "0", "clips.size() - 1");
+    return clips[clip].frame_count;
+}
+
+AnimationSystem::InstanceId AnimationSystem::AddInstance(AnimatedSprite* sprite) {
+    if(sprite == nullptr) return INVALID_ID;
+
+    InstanceId instance = INVALID_ID;
+    if(free_ids.empty()) {
+        instance = static_cast<InstanceId>(slots.size());
+        slots.push_back(INVALID_ID);
+    } else {
+        instance = free_ids.back();
+        free_ids.pop_back();
+    }
+
+    Playback playback;
+    playback.clip = INVALID_ID;
+    playback.frame = 0;
+    playback.time = 0.0;
+    playback.dir = AnimationHandler::DIR_FORWARD_LOOPING;
+    playback.playing = false;
+
+    slots[instance] = static_cast<unsigned int>(playbacks.size());
+    playbacks.push_back(playback);
+    sprites.push_back(sprite);
+    owners.push_back(instance);
+    return instance;
+}
+
+bool AnimationSystem::RemoveInstance(InstanceId instance) {
+    if(instance >= slots.size() || slots[instance] == INVALID_ID) return false;
+
+    //Move the last entry into the hole so the arrays stay packed.
+    std::size_t slot = slots[instance];
+    std::size_t last = playbacks.size() - 1;
+    if(slot != last) {
+        playbacks[slot] = playbacks[last];
+        sprites[slot] = sprites[last];
+        owners[slot] = owners[last];
+        slots[owners[slot]] = static_cast<unsigned int>(slot);
+    }
+    playbacks.pop_back();
+    sprites.pop_back();
+    owners.pop_back();
+    slots[instance] = INVALID_ID;
+    free_ids.push_back(instance);
+    return true;
+}
+
+void AnimationSystem::Play(InstanceId instance, ClipId clip, AnimationHandler::DIRECTION dir) {
+    std::size_t slot = GetSlot(instance);
+    if(clip >= clips.size()) throw IndexOutOfBoundsException("clip", "0", "clips.size() - 1");
+
+    bool reverse = dir == AnimationHandler::DIR_REVERSE_LOOPING || dir == AnimationHandler::DIR_REVERSE_NONLOOPING;
+    Playback& playback = playbacks[slot];
+    playback.clip = clip;
+    playback.frame = reverse ? clips[clip].frame_count - 1 : 0;
+    playback.time = 0.0;
+    playback.dir = dir;
+    playback.playing = true;
+    ShowFrame(slot);
+}
+
+void AnimationSystem::Stop(InstanceId instance) {
+    playbacks[GetSlot(instance)].playing = false;
+}
+
+bool AnimationSystem::IsPlaying(InstanceId instance) {
+    if(instance >= slots.size() || slots[instance] == INVALID_ID) return false;
+    return playbacks[slots[instance]].playing;
+}
+
+std::size_t AnimationSystem::GetCurFrame(InstanceId instance) {
+    return playbacks[GetSlot(instance)].frame;
+}
+
+void AnimationSystem::Update(double deltaTime) {
+    changed.clear();
+
+    //Touch only the packed state here; the sprites are visited afterwards, and only if their frame changed.
+    std::size_t count = playbacks.size();
+    for(std::size_t i = 0; i < count; ++i) {
+        Playback& playback = playbacks[i];
+        if(playback.playing == false) continue;
+        const Clip& clip = clips[playback.clip];
+
+        unsigned long long steps = 1;
+        if(clip.frame_time > 0.0) {
+            playback.time += deltaTime;
+            if(playback.time < clip.frame_time) continue;
+            double whole = std::floor(playback.time / clip.frame_time);
+            playback.time -= whole * clip.frame_time;
+            steps = static_cast<unsigned long long>(whole);
+        }
+
+        unsigned int old_frame = playback.frame;
+        unsigned int last = clip.frame_count - 1;
+        switch(playback.dir) {
+            case AnimationHandler::DIR_FORWARD_LOOPING:
+                playback.frame = static_cast<unsigned int>((playback.frame + steps % clip.frame_count) % clip.frame_count);
+                break;
+            case AnimationHandler::DIR_FORWARD_NONLOOPING:
+                if(steps >= last - playback.frame) {
+                    playback.frame = last;
+                    playback.playing = false;
+                } else {
+                    playback.frame += static_cast<unsigned int>(steps);
+                }
+                break;
+            case AnimationHandler::DIR_REVERSE_LOOPING:
+                playback.frame = static_cast<unsigned int>((playback.frame + clip.frame_count - steps % clip.frame_count) % clip.frame_count);
+                break;
+            case AnimationHandler::DIR_REVERSE_NONLOOPING:
+                if(steps >= playback.frame) {
+                    playback.frame = 0;
+                    playback.playing = false;
+                } else {
+                    playback.frame -= static_cast<unsigned int>(steps);
+                }
+                break;
+            default:
+                /* DO NOTHING */;
+        }
+        if(playback.frame != old_frame) changed.push_back(i);
+    }
+
+    for(std::vector<std::size_t>::const_iterator _iter = changed.begin(); _iter != changed.end(); ++_iter) {
+        ShowFrame(*_iter);
+    }
+}
+
+void AnimationSystem::Clear() {
+    frames.clear();
+    clips.clear();
+    clip_names.clear();
+    playbacks.clear();
+    sprites.clear();
+    owners.clear();
+    slots.clear();
+    free_ids.clear();
+    changed.clear();
+}
+
+void AnimationSystem::ShowFrame(std::size_t slot) {
+    const Playback& playback = playbacks[slot];
+    if(playback.clip == INVALID_ID) return;
+    const Frame& frame = frames[clips[playback.clip].first_frame + playback.frame];
+    sprites[slot]->SetFrameRegion(frame.x, frame.y, frame.width, frame.height);
+}
+
+A2DE_END
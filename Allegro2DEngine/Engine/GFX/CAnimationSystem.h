@@ -0,0 +1,167 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CAnimationSystem.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the animation system class.
+ **************************************************************************************************/
+#ifndef A2DE_CANIMATIONSYSTEM_H
+#define A2DE_CANIMATIONSYSTEM_H
+
+#include "../a2de_vals.h"
+
+#include <string>
+
+#include "CAnimationHandler.h"
+
+A2DE_BEGIN
+
+class AnimatedSprite;
+
+/**************************************************************************************************
+ * <summary>Plays animations on many AnimatedSprites at once.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Clips are compiled once from AnimationFrameSets into one flat array of frame regions
+ *          and named by integer id; names are looked up only when a clip is compiled or found.
+ *          The playback state of every instance sits in one dense array that Update advances in a
+ *          single loop, and only the sprites whose frame changed are touched afterwards. Sprites
+ *          played here should not also be animated through their AnimationHandler. Game calls
+ *          Update once per fixed time step.</remarks>
+ **************************************************************************************************/
+class AnimationSystem {
+public:
+
+    /// <summary> Identifies a compiled clip.</summary>
+    typedef unsigned int ClipId;
+    /// <summary> Identifies a sprite added to the system.</summary>
+    typedef unsigned int InstanceId;
+
+    /// <summary> Returned when there is no clip or instance.</summary>
+    static const unsigned int INVALID_ID = 0xFFFFFFFFu;
+
+    /**************************************************************************************************
+     * <summary>Compiles an unnamed clip.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="frames">    The frames, in playing order.</param>
+     * <param name="frame_time">Length of time per frame in seconds. Zero advances one frame per Update.</param>
+     * <returns>INVALID_ID if there are no frames, else the clip.</returns>
+     **************************************************************************************************/
+    static ClipId CompileClip(const AnimationFrameSet& frames, double frame_time);
+
+    /**************************************************************************************************
+     * <summary>Compiles a named clip.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="name">      The name to find the clip by.</param>
+     * <param name="frames">    The frames, in playing order.</param>
+     * <param name="frame_time">Length of time per frame in seconds. Zero advances one frame per Update.</param>
+     * <returns>INVALID_ID if there are no frames or the name is taken, else the clip.</returns>
+     **************************************************************************************************/
+    static ClipId CompileClip(const std::string& name, const AnimationFrameSet& frames, double frame_time);
+
+    /**************************************************************************************************
+     * <summary>Finds a named clip.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Look names up at load time and keep the id.</remarks>
+     * <param name="name">The name.</param>
+     * <returns>INVALID_ID if there is no such clip, else the clip.</returns>
+     **************************************************************************************************/
+    static ClipId FindClip(const std::string& name);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of frames in a clip.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="clip">The clip.</param>
+     * <returns>The frame count.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the clip does not exist.</exception>
+     **************************************************************************************************/
+    static std::size_t GetFrameCount(ClipId clip);
+
+    /**************************************************************************************************
+     * <summary>Adds a sprite to play clips on.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Remove the instance before destroying the sprite.</remarks>
+     * <param name="sprite">The sprite.</param>
+     * <returns>INVALID_ID if sprite is null, else the instance.</returns>
+     **************************************************************************************************/
+    static InstanceId AddInstance(AnimatedSprite* sprite);
+
+    /**************************************************************************************************
+     * <summary>Removes a sprite. Its id may be handed out again.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="instance">The instance.</param>
+     * <returns>true if it was removed, false if there is no such instance.</returns>
+     **************************************************************************************************/
+    static bool RemoveInstance(InstanceId instance);
+
+    /**************************************************************************************************
+     * <summary>Starts a clip on an instance from its first frame, or its last frame when reversed.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Non-looping playback stops on the final frame.</remarks>
+     * <param name="instance">The instance.</param>
+     * <param name="clip">    The clip.</param>
+     * <param name="dir">     The direction and loop mode.</param>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the instance or clip does not exist.</exception>
+     **************************************************************************************************/
+    static void Play(InstanceId instance, ClipId clip, AnimationHandler::DIRECTION dir);
+
+    /**************************************************************************************************
+     * <summary>Stops an instance on its current frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="instance">The instance.</param>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the instance does not exist.</exception>
+     **************************************************************************************************/
+    static void Stop(InstanceId instance);
+
+    /**************************************************************************************************
+     * <summary>Query if an instance is playing.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="instance">The instance.</param>
+     * <returns>true if playing, false if stopped, finished or not an instance.</returns>
+     **************************************************************************************************/
+    static bool IsPlaying(InstanceId instance);
+
+    /**************************************************************************************************
+     * <summary>Gets the frame an instance is showing.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="instance">The instance.</param>
+     * <returns>Zero-based index of the frame in its clip.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the instance does not exist.</exception>
+     **************************************************************************************************/
+    static std::size_t GetCurFrame(InstanceId instance);
+
+    /**************************************************************************************************
+     * <summary>Advances every playing instance.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="deltaTime">The elapsed time in seconds.</param>
+     **************************************************************************************************/
+    static void Update(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Removes every instance and clip.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void Clear();
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Shows an instance's current frame on its sprite.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="slot">Zero-based index of the instance's playback state.</param>
+     **************************************************************************************************/
+    static void ShowFrame(std::size_t slot);
+
+    //Creation of object of type AnimationSystem is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    AnimationSystem();
+    AnimationSystem(const AnimationSystem&);
+    //NO COPYING ALLOWED!
+    AnimationSystem& operator=(const AnimationSystem&);
+    ~AnimationSystem();
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,311 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CAssetPack.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the asset pack class.
+ **************************************************************************************************/
+#include "CAssetPack.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_image.h>
+#include <allegro5/allegro_memfile.h>
+
+#include "CMappedFile.h"
+
+A2DE_BEGIN
+
+namespace {
+
+    /// <summary> Identifies a pack.</summary>
+    const char MAGIC[4] = { 'A', '2', 'P', 'K' };
+    /// <summary> Bumped whenever the layout changes.</summary>
+    const unsigned int VERSION = 1;
+    /// <summary> Every file's bytes start on a multiple of this.</summary>
+    const unsigned int ALIGNMENT = 64;
+    /// <summary> The size of the reads used to copy files into a pack.</summary>
+    const std::size_t COPY_BUFFER_SIZE = 64 * 1024;
+
+    /**************************************************************************************************
+     * <summary>The start of a pack.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct PackHeader {
+        char magic[4];
+        unsigned int version;
+        unsigned int entry_count;
+        unsigned int reserved0;
+        unsigned long long index_offset;
+        unsigned long long names_offset;
+        char reserved[32];
+    };
+
+    /**************************************************************************************************
+     * <summary>One file in the index. The index is sorted by path, compared bytewise.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct IndexEntry {
+        unsigned long long data_offset;
+        unsigned long long data_size;
+        unsigned int name_offset;
+        unsigned int name_length;
+    };
+
+    /**************************************************************************************************
+     * <summary>A mapped pack and where its index and paths are.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct MountedPack {
+        std::string filename;
+        MappedFile file;
+        const IndexEntry* index;
+        unsigned int entry_count;
+        const char* names;
+    };
+
+    /// <summary> The mounted packs, most recently mounted first.</summary>
+    std::vector<MountedPack*> mounted_packs;
+
+    unsigned long long AlignUp(unsigned long long value) {
+        return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    std::string NormalizePath(const std::string& path) {
+        std::string result(path);
+        std::replace(result.begin(), result.end(), '\\', '/');
+        while(result.compare(0, 2, "./") == 0) {
+            result.erase(0, 2);
+        }
+        return result;
+    }
+
+    int ComparePath(const std::string& path, const MountedPack& pack, const IndexEntry& entry) {
+        return path.compare(0, path.size(), pack.names + entry.name_offset, entry.name_length);
+    }
+
+    const IndexEntry* FindEntry(const MountedPack& pack, const std::string& path) {
+        unsigned int low = 0;
+        unsigned int high = pack.entry_count;
+        while(low < high) {
+            unsigned int middle = low + (high - low) / 2;
+            int result = ComparePath(path, pack, pack.index[middle]);
+            if(result == 0) return &pack.index[middle];
+            if(result < 0) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        return nullptr;
+    }
+
+    bool FindFile(const std::string& path, const unsigned char*& data, std::size_t& size) {
+        if(mounted_packs.empty()) return false;
+        std::string key = NormalizePath(path);
+        for(std::vector<MountedPack*>::const_iterator _iter = mounted_packs.begin(); _iter != mounted_packs.end(); ++_iter) {
+            const IndexEntry* entry = FindEntry(**_iter, key);
+            if(entry == nullptr) continue;
+            data = (*_iter)->file.GetData() + entry->data_offset;
+            size = static_cast<std::size_t>(entry->data_size);
+            return true;
+        }
+        return false;
+    }
+
+    bool ValidatePack(MountedPack& pack) {
+        const unsigned char* data = pack.file.GetData();
+        unsigned long long file_size = pack.file.GetSize();
+        if(data == nullptr || file_size < sizeof(PackHeader)) return false;
+
+        const PackHeader* header = reinterpret_cast<const PackHeader*>(data);
+        if(std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION) return false;
+        if(header->index_offset % sizeof(unsigned long long) != 0) return false;
+        if(header->index_offset > file_size || header->names_offset > file_size) return false;
+        if((file_size - header->index_offset) / sizeof(IndexEntry) < header->entry_count) return false;
+
+        pack.index = reinterpret_cast<const IndexEntry*>(data + header->index_offset);
+        pack.entry_count = header->entry_count;
+        pack.names = reinterpret_cast<const char*>(data + header->names_offset);
+
+        //Everything must be in bounds and in order, or lookups could read past the mapping.
+        unsigned long long names_size = file_size - header->names_offset;
+        for(unsigned int i = 0; i < pack.entry_count; ++i) {
+            const IndexEntry& entry = pack.index[i];
+            if(static_cast<unsigned long long>(entry.name_offset) + entry.name_length > names_size) return false;
+            if(entry.data_offset > file_size || entry.data_size > file_size - entry.data_offset) return false;
+            if(i == 0) continue;
+            const IndexEntry& previous = pack.index[i - 1];
+            std::string previous_name(pack.names + previous.name_offset, previous.name_length);
+            if(ComparePath(previous_name, pack, entry) >= 0) return false;
+        }
+        return true;
+    }
+
+    bool GetSourceSize(const std::string& filename, unsigned long long& size) {
+        ALLEGRO_FS_ENTRY* entry = al_create_fs_entry(filename.c_str());
+        if(entry == nullptr) return false;
+        bool is_file = al_fs_entry_exists(entry) && (al_get_fs_entry_mode(entry) & ALLEGRO_FILEMODE_ISDIR) == 0;
+        if(is_file) size = static_cast<unsigned long long>(al_get_fs_entry_size(entry));
+        al_destroy_fs_entry(entry);
+        return is_file;
+    }
+
+    bool CopyInto(ALLEGRO_FILE* dest, const std::string& filename, unsigned long long size) {
+        ALLEGRO_FILE* source = al_fopen(filename.c_str(), "rb");
+        if(source == nullptr) return false;
+        std::vector<char> buffer(COPY_BUFFER_SIZE);
+        unsigned long long remaining = size;
+        bool copied = true;
+        while(copied && remaining > 0) {
+            std::size_t chunk = static_cast<std::size_t>(std::min<unsigned long long>(remaining, buffer.size()));
+            copied = al_fread(source, &buffer[0], chunk) == chunk && al_fwrite(dest, &buffer[0], chunk) == chunk;
+            remaining -= chunk;
+        }
+        //The file must not have grown since its size was taken either.
+        copied = copied && al_fgetc(source) == EOF;
+        al_fclose(source);
+        return copied;
+    }
+
+}
+
+bool AssetPack::Mount(const std::string& filename) {
+    for(std::vector<MountedPack*>::iterator _iter = mounted_packs.begin(); _iter != mounted_packs.end(); ++_iter) {
+        if((*_iter)->filename == filename) return false;
+    }
+
+    MountedPack* pack = new MountedPack;
+    pack->filename = filename;
+    pack->index = nullptr;
+    pack->entry_count = 0;
+    pack->names = nullptr;
+    if(pack->file.Open(filename) == false || ValidatePack(*pack) == false) {
+        delete pack;
+        return false;
+    }
+    mounted_packs.insert(mounted_packs.begin(), pack);
+    return true;
+}
+
+bool AssetPack::Unmount(const std::string& filename) {
+    for(std::vector<MountedPack*>::iterator _iter = mounted_packs.begin(); _iter != mounted_packs.end(); ++_iter) {
+        if((*_iter)->filename != filename) continue;
+        delete *_iter;
+        mounted_packs.erase(_iter);
+        return true;
+    }
+    return false;
+}
+
+void AssetPack::UnmountAll() {
+    for(std::vector<MountedPack*>::iterator _iter = mounted_packs.begin(); _iter != mounted_packs.end(); ++_iter) {
+        delete *_iter;
+    }
+    mounted_packs.clear();
+}
+
+bool AssetPack::Contains(const std::string& path) {
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    return FindFile(path, data, size);
+}
+
+bool AssetPack::FileExists(const std::string& path) {
+    return Contains(path) || al_filename_exists(path.c_str());
+}
+
+ALLEGRO_FILE* AssetPack::Open(const std::string& path) {
+    const unsigned char* data = nullptr;
+    std::size_t size = 0;
+    //Allegro will not open an empty memfile.
+    if(FindFile(path, data, size) == false || size == 0) return nullptr;
+    //The mapping is read-only; opening with "r" means Allegro never writes through the pointer.
+    return al_open_memfile(const_cast<unsigned char*>(data), static_cast<int64_t>(size), "r");
+}
+
+ALLEGRO_BITMAP* AssetPack::ReadBitmap(const std::string& path) {
+    std::string::size_type dot = path.find_last_of('.');
+    std::string::size_type slash = path.find_last_of("/\\");
+    if(dot == std::string::npos || (slash != std::string::npos && dot < slash)) return nullptr;
+
+    ALLEGRO_FILE* file = Open(path);
+    if(file == nullptr) return nullptr;
+    ALLEGRO_BITMAP* bmp = al_load_bitmap_f(file, path.substr(dot).c_str());
+    al_fclose(file);
+    return bmp;
+}
+
+bool AssetPack::Build(const std::string& filename, const std::vector<std::string>& files) {
+
+    //Sorted by stored path, which is the order the index needs.
+    std::vector<std::pair<std::string, std::string> > sources;
+    sources.reserve(files.size());
+    for(std::vector<std::string>::const_iterator _iter = files.begin(); _iter != files.end(); ++_iter) {
+        sources.push_back(std::make_pair(NormalizePath(*_iter), *_iter));
+    }
+    std::sort(sources.begin(), sources.end());
+    std::vector<std::pair<std::string, std::string> >::iterator last = sources.begin();
+    for(std::vector<std::pair<std::string, std::string> >::iterator _iter = sources.begin(); _iter != sources.end(); ++_iter) {
+        if(last != sources.begin() && (last - 1)->first == _iter->first) continue;
+        *last++ = *_iter;
+    }
+    sources.erase(last, sources.end());
+
+    PackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.entry_count = static_cast<unsigned int>(sources.size());
+    header.index_offset = sizeof(PackHeader);
+    header.names_offset = header.index_offset + sources.size() * sizeof(IndexEntry);
+
+    std::vector<IndexEntry> index(sources.size());
+    unsigned long long names_size = 0;
+    for(std::size_t i = 0; i < sources.size(); ++i) {
+        index[i].name_offset = static_cast<unsigned int>(names_size);
+        index[i].name_length = static_cast<unsigned int>(sources[i].first.size());
+        names_size += sources[i].first.size();
+    }
+    unsigned long long offset = AlignUp(header.names_offset + names_size);
+    for(std::size_t i = 0; i < sources.size(); ++i) {
+        if(GetSourceSize(sources[i].second, index[i].data_size) == false) return false;
+        index[i].data_offset = offset;
+        offset = AlignUp(offset + index[i].data_size);
+    }
+
+    std::string temp_filename = filename + ".tmp";
+    ALLEGRO_FILE* file = al_fopen(temp_filename.c_str(), "wb");
+    if(file == nullptr) return false;
+
+    char padding[ALIGNMENT] = { 0 };
+    bool written = al_fwrite(file, &header, sizeof(header)) == sizeof(header);
+    if(written && index.empty() == false) {
+        written = al_fwrite(file, &index[0], index.size() * sizeof(IndexEntry)) == index.size() * sizeof(IndexEntry);
+    }
+    for(std::size_t i = 0; written && i < sources.size(); ++i) {
+        written = al_fwrite(file, sources[i].first.data(), sources[i].first.size()) == sources[i].first.size();
+    }
+    unsigned long long position = header.names_offset + names_size;
+    for(std::size_t i = 0; written && i < sources.size(); ++i) {
+        std::size_t padding_size = static_cast<std::size_t>(index[i].data_offset - position);
+        written = al_fwrite(file, padding, padding_size) == padding_size;
+        written = written && CopyInto(file, sources[i].second, index[i].data_size);
+        position = index[i].data_offset + index[i].data_size;
+    }
+    written = written && al_ferror(file) == false;
+    al_fclose(file);
+
+    if(written) {
+        std::remove(filename.c_str());
+        written = std::rename(temp_filename.c_str(), filename.c_str()) == 0;
+    }
+    if(written == false) std::remove(temp_filename.c_str());
+    return written;
+}
+
+A2DE_END
@@ -0,0 +1,121 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CAssetPack.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the asset pack class.
+ **************************************************************************************************/
+#ifndef A2DE_CASSETPACK_H
+#define A2DE_CASSETPACK_H
+
+#include "../a2de_vals.h"
+
+#include <string>
+#include <vector>
+
+struct ALLEGRO_BITMAP;
+struct ALLEGRO_FILE;
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Serves asset files out of single pack files instead of loose files.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          A pack is a header, an index sorted by path, the paths, then each file's bytes starting
+ *          on a 64-byte boundary. A mounted pack is memory-mapped once and stays mapped; files are
+ *          found by binary search and read through an Allegro memfile over the mapping, so nothing
+ *          is copied before the decoder sees it. Paths use forward slashes; lookups accept either
+ *          slash. BitmapCache, and through it Sprite, AnimatedSprite, TileSet and TextureAtlas, try
+ *          the mounted packs before the disk. Packs are written by Build or the a2de_pack
+ *          tool.</remarks>
+ **************************************************************************************************/
+class AssetPack {
+public:
+
+    /**************************************************************************************************
+     * <summary>Maps a pack and searches it before the packs mounted earlier and before the disk.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Mount and unmount before loading starts; the list of packs is not guarded against
+     *          the BitmapCache loader threads.</remarks>
+     * <param name="filename">Path and Filename of the pack.</param>
+     * <returns>true if it succeeds, false if the pack is missing, malformed or already mounted.</returns>
+     **************************************************************************************************/
+    static bool Mount(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Unmaps a pack.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Files opened from the pack must be closed first.</remarks>
+     * <param name="filename">Path and Filename of the pack.</param>
+     * <returns>true if it was mounted, false if not.</returns>
+     **************************************************************************************************/
+    static bool Unmount(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Unmaps every pack.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void UnmountAll();
+
+    /**************************************************************************************************
+     * <summary>Query if a mounted pack holds a file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="path">The path of the file.</param>
+     * <returns>true if it does, false if not.</returns>
+     **************************************************************************************************/
+    static bool Contains(const std::string& path);
+
+    /**************************************************************************************************
+     * <summary>Query if a file is in a mounted pack or on disk.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="path">The path of the file.</param>
+     * <returns>true if it exists, false if not.</returns>
+     **************************************************************************************************/
+    static bool FileExists(const std::string& path);
+
+    /**************************************************************************************************
+     * <summary>Opens a packed file for reading without copying it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="path">The path of the file.</param>
+     * <returns>null if no mounted pack holds it or it is empty, else a read-only memfile the caller closes with al_fclose.</returns>
+     **************************************************************************************************/
+    static ALLEGRO_FILE* Open(const std::string& path);
+
+    /**************************************************************************************************
+     * <summary>Decodes a packed image.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The bitmap is created with the calling thread's new bitmap flags and the decoder is
+     *          chosen by the path's extension.</remarks>
+     * <param name="path">The path of the image.</param>
+     * <returns>null if no mounted pack holds it or it fails to decode, else the bitmap. The caller owns it.</returns>
+     **************************************************************************************************/
+    static ALLEGRO_BITMAP* ReadBitmap(const std::string& path);
+
+    /**************************************************************************************************
+     * <summary>Writes a pack.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Each file is stored under its path as given, with back slashes turned into forward
+     *          slashes. Duplicate paths are stored once. The pack is written beside the destination
+     *          and renamed over it, so a mounted copy is never half written.</remarks>
+     * <param name="filename">Path and Filename of the pack to write.</param>
+     * <param name="files">   The files to store.</param>
+     * <returns>true if it succeeds, false if a file could not be read or the pack could not be written.</returns>
+     **************************************************************************************************/
+    static bool Build(const std::string& filename, const std::vector<std::string>& files);
+
+protected:
+private:
+
+    //Creation of object of type AssetPack is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    AssetPack();
+    AssetPack(const AssetPack&);
+    //NO COPYING ALLOWED!
+    AssetPack& operator=(const AssetPack&);
+    ~AssetPack();
+};
+
+A2DE_END
+
+#endif
@@ -8,65 +8,173 @@
 #include "CBitmapCache.h"
 
 #include <algorithm>
+#include <deque>
 #include <map>
 
+#include <allegro5/allegro.h>
 #include <allegro5/bitmap.h>
 #include <allegro5/bitmap_io.h>
 #include <allegro5/allegro_image.h>
+#include <allegro5/allegro_primitives.h>
 #include <allegro5/fshook.h>
+#include <allegro5/threads.h>
+
+#include "CAssetPack.h"
+#include "CPixelCache.h"
+#include "CRenderThread.h"
 
 A2DE_BEGIN
 
-//filename or name of bitmap, reference count, memory location...
-typedef std::map<std::string, std::pair<long, ALLEGRO_BITMAP*> > MapStrBmp;
-typedef MapStrBmp::iterator MapStrBmpIter;
+namespace {
+
+    /// <summary> Pixels with at least this alpha are solid in collision masks.</summary>
+    const unsigned char MASK_ALPHA_THRESHOLD = 128;
+
+    /// <summary> The number of loader threads started on first use.</summary>
+    const unsigned int DEFAULT_LOADER_COUNT = 2;
+
+    /// <summary> Guards everything below except the placeholder.</summary>
+    ALLEGRO_MUTEX* load_mutex = nullptr;
+    /// <summary> Signalled when a file is queued or the loaders should stop.</summary>
+    ALLEGRO_COND* work_ready = nullptr;
+    /// <summary> Signalled when a file finishes decoding.</summary>
+    ALLEGRO_COND* work_done = nullptr;
+    /// <summary> The loader threads.</summary>
+    std::vector<ALLEGRO_THREAD*> loaders;
+    /// <summary> Files waiting to be decoded.</summary>
+    std::deque<std::string> decode_queue;
+    /// <summary> Decoded memory bitmaps waiting to be uploaded on the display thread. Null if decoding failed.</summary>
+    std::deque<std::pair<std::string, ALLEGRO_BITMAP*> > upload_queue;
+    /// <summary> The progress of every file requested asynchronously.</summary>
+    std::map<std::string, a2de::BitmapCache::LOADSTATE> load_states;
+    /// <summary> The files in each group.</summary>
+    std::multimap<unsigned int, std::string> load_groups;
+    /// <summary> Handed out under a file's name until it loads. Never destroyed; Allegro frees it at shutdown.</summary>
+    ALLEGRO_BITMAP* placeholder = nullptr;
+
+    ALLEGRO_BITMAP* LoadSource(const std::string& filename) {
+        //Mounted packs shadow loose files.
+        ALLEGRO_BITMAP* bmp = AssetPack::ReadBitmap(filename);
+        if(bmp != nullptr) return bmp;
+        return PixelCache::Load(filename);
+    }
+
+    void* LoaderThread(ALLEGRO_THREAD* thread, void* /*arg*/) {
+        //New bitmap flags are per thread; decode into system memory, the display thread uploads.
+        al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+        al_lock_mutex(load_mutex);
+        while(true) {
+            while(decode_queue.empty() && al_get_thread_should_stop(thread) == false) {
+                al_wait_cond(work_ready, load_mutex);
+            }
+            if(decode_queue.empty()) break;
+            std::string filename = decode_queue.front();
+            decode_queue.pop_front();
+            al_unlock_mutex(load_mutex);
+
+            ALLEGRO_BITMAP* decoded = LoadSource(filename);
 
-MapStrBmp BitmapCache::_cache;
+            al_lock_mutex(load_mutex);
+            upload_queue.push_back(std::make_pair(filename, decoded));
+            al_broadcast_cond(work_done);
+        }
+        al_unlock_mutex(load_mutex);
+        return nullptr;
+    }
+
+    ALLEGRO_BITMAP* GetPlaceholder() {
+        if(placeholder != nullptr) return placeholder;
+
+        //The usual magenta and black checkerboard so missing art stands out.
+        placeholder = al_create_bitmap(16, 16);
+        if(placeholder == nullptr) return nullptr;
+        ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
+        al_set_target_bitmap(placeholder);
+        al_clear_to_color(al_map_rgb(255, 0, 255));
+        al_draw_filled_rectangle(0, 0, 8, 8, al_map_rgb(0, 0, 0));
+        al_draw_filled_rectangle(8, 8, 16, 16, al_map_rgb(0, 0, 0));
+        al_set_target_bitmap(old_target_bmp);
+        return placeholder;
+    }
+
+    bool IsGroupLoadedLocked(unsigned int group) {
+        typedef std::multimap<unsigned int, std::string>::iterator GroupIter;
+        std::pair<GroupIter, GroupIter> range = load_groups.equal_range(group);
+        for(GroupIter _iter = range.first; _iter != range.second; ++_iter) {
+            std::map<std::string, a2de::BitmapCache::LOADSTATE>::iterator state = load_states.find(_iter->second);
+            if(state != load_states.end() && state->second == a2de::BitmapCache::LOADSTATE_PENDING) return false;
+        }
+        return true;
+    }
+
+}
+
+BitmapCache::CacheMap BitmapCache::_cache;
+std::list<std::string> BitmapCache::_lru;
+std::size_t BitmapCache::_budget = 64 * 1024 * 1024;
+BitmapCache::Statistics BitmapCache::_statistics = { 0, 0, 0, 0, 0 };
+std::map<std::string, BitmapCache::AtlasRegion> BitmapCache::_atlas_regions;
+std::vector<ALLEGRO_BITMAP*> BitmapCache::_retired_pages;
 
 ALLEGRO_BITMAP* BitmapCache::GetBitmap(const std::string& filename) {
     //Return NULL if a bad filename was passed.
     if(filename.empty()) return nullptr;
-    if(al_filename_exists(filename.c_str()) == false) return nullptr;
-
-    //Clean the cache if it's dirty.
-    CleanCache();
 
     //Search for requested BITMAP.
-    MapStrBmpIter _iter = _cache.find(filename);
+    CacheMap::iterator _iter = _cache.find(filename);
 
     //If found, return it.
     if(_iter != _cache.end()) {
-        _iter->second.first++;
-        return _iter->second.second;
+        ++_statistics.hits;
+        return AddReference(_iter->second);
+    }
+
+    //If the image was packed into an atlas, hand out its region instead of loading the file.
+    std::map<std::string, AtlasRegion>::iterator _region = _atlas_regions.find(filename);
+    if(_region != _atlas_regions.end()) {
+        const AtlasRegion& region = _region->second;
+        ALLEGRO_BITMAP* sub = al_create_sub_bitmap(region.page, region.x, region.y, region.width, region.height);
+        if(sub != nullptr) {
+            ++_statistics.misses;
+            Insert(filename, sub, 1);
+            return sub;
+        }
     }
 
+    if(AssetPack::FileExists(filename) == false) return nullptr;
+
+    //Make room before loading more.
+    CleanCache();
+
     //Otherwise, create it, store it, then return it.
-    ALLEGRO_BITMAP* result = al_load_bitmap(filename.c_str());
+    ALLEGRO_BITMAP* result = LoadSource(filename);
     if(result == nullptr) return nullptr;
-    _cache.insert(std::make_pair(filename, std::make_pair(static_cast<long>(1), result)));
+    ++_statistics.misses;
+    Insert(filename, result, 1);
     return result;
 }
 
 void BitmapCache::StoreBitmap(const std::string& name, ALLEGRO_BITMAP* bmp) {
     if(name.empty() || bmp == nullptr) return;
 
+    //Clean first; the caller retrieves the new entry right after storing it.
     CleanCache();
 
-    MapStrBmpIter _iter = _cache.find(name);
+    CacheMap::iterator _iter = _cache.find(name);
     //Bitmap already exists in cache, do not store it.
     if(_iter != _cache.end()) {
         return;
     }
-    _cache.insert(std::make_pair(name, std::make_pair(static_cast<long>(0), bmp)));
+    Insert(name, bmp, 0);
 }
 
 ALLEGRO_BITMAP* BitmapCache::RetrieveBitmap(const std::string& name) {
     if(name.empty()) return nullptr;
 
-    MapStrBmpIter _iter = _cache.find(name);
+    CacheMap::iterator _iter = _cache.find(name);
     if(_iter != _cache.end()) {
-        _iter->second.first++;
-        return _iter->second.second;
+        ++_statistics.hits;
+        return AddReference(_iter->second);
     }
     return nullptr;
 }
@@ -74,26 +182,347 @@ ALLEGRO_BITMAP* BitmapCache::RetrieveBitmap(const std::string& name) {
 void BitmapCache::RemoveBitmap(const std::string& name) {
     if(name.empty()) return;
 
-    MapStrBmpIter _iter = _cache.find(name);
+    CacheMap::iterator _iter = _cache.find(name);
+    if(_iter == _cache.end()) return;
 
-    if(_iter != _cache.end()) {
-        _iter->second.first--;
-        CleanCache();
+    CacheEntry& entry = _iter->second;
+    if(entry.references <= 0) return;
+    if(--entry.references > 0) return;
+
+    //Nothing worth keeping for a file that is still loading.
+    if(IsPlaceholder(entry.bitmap)) {
+        _cache.erase(_iter);
+        return;
+    }
+    //Nor for a region of an atlas that has moved on; it only keeps the old page alive.
+    if(GetRetiredPage(entry.bitmap) != nullptr) {
+        Evict(_iter);
+        return;
     }
+    _lru.push_front(name);
+    entry.lru_position = _lru.begin();
+    _statistics.unused_bytes += entry.bytes;
+    CleanCache();
 }
 
 void BitmapCache::CleanCache() {
 
-    //Clean the cache of any bitmaps that are no longer referenced.
-    for(MapStrBmpIter _iter = _cache.begin(); _iter != _cache.end(); /* DO NOTHING */ ) {
-        if(_iter->second.first > 0) {
-            ++_iter;
-            continue;
+    //Evict from the cold end of the LRU list until the cache fits its budget.
+    while(_lru.empty() == false && _statistics.resident_bytes > _budget) {
+        Evict(_cache.find(_lru.back()));
+    }
+}
+
+void BitmapCache::Insert(const std::string& name, ALLEGRO_BITMAP* bmp, long references) {
+    CacheEntry entry;
+    entry.references = references;
+    entry.bitmap = bmp;
+    entry.bytes = EstimateBytes(bmp);
+    entry.lru_position = _lru.end();
+    if(references <= 0) {
+        _lru.push_front(name);
+        entry.lru_position = _lru.begin();
+        _statistics.unused_bytes += entry.bytes;
+    }
+    _statistics.resident_bytes += entry.bytes;
+    _cache.insert(std::make_pair(name, entry));
+}
+
+ALLEGRO_BITMAP* BitmapCache::AddReference(CacheEntry& entry) {
+    if(entry.references++ == 0 && entry.lru_position != _lru.end()) {
+        _lru.erase(entry.lru_position);
+        entry.lru_position = _lru.end();
+        _statistics.unused_bytes -= entry.bytes;
+    }
+    return entry.bitmap;
+}
+
+void BitmapCache::Evict(CacheMap::iterator position) {
+    if(position == _cache.end()) return;
+    CacheEntry& entry = position->second;
+    if(entry.lru_position != _lru.end()) {
+        _lru.erase(entry.lru_position);
+        _statistics.unused_bytes -= entry.bytes;
+    }
+    _statistics.resident_bytes -= entry.bytes;
+    ALLEGRO_BITMAP* retired_page = GetRetiredPage(entry.bitmap);
+    if(IsPlaceholder(entry.bitmap) == false) RenderThread::DestroyBitmap(entry.bitmap);
+    entry.bitmap = nullptr;
+    _cache.erase(position);
+    ++_statistics.evictions;
+    if(retired_page != nullptr) ReleaseRetiredPage(retired_page);
+}
+
+std::size_t BitmapCache::EstimateBytes(ALLEGRO_BITMAP* bmp) {
+    if(bmp == nullptr || IsPlaceholder(bmp) || al_is_sub_bitmap(bmp)) return 0;
+    std::size_t pixels = static_cast<std::size_t>(al_get_bitmap_width(bmp)) * static_cast<std::size_t>(al_get_bitmap_height(bmp));
+    return pixels * al_get_pixel_size(al_get_bitmap_format(bmp));
+}
+
+void BitmapCache::SetBudget(std::size_t bytes) {
+    _budget = bytes;
+    CleanCache();
+}
+
+std::size_t BitmapCache::GetBudget() {
+    return _budget;
+}
+
+void BitmapCache::Purge() {
+    while(_lru.empty() == false) {
+        Evict(_cache.find(_lru.back()));
+    }
+}
+
+const BitmapCache::Statistics& BitmapCache::GetStatistics() {
+    return _statistics;
+}
+
+void BitmapCache::ResetStatistics() {
+    _statistics.hits = 0;
+    _statistics.misses = 0;
+    _statistics.evictions = 0;
+}
+
+void BitmapCache::RegisterAtlasRegion(const std::string& filename, const AtlasRegion& region) {
+    if(filename.empty() || region.page == nullptr) return;
+    _atlas_regions[filename] = region;
+}
+
+void BitmapCache::UnregisterAtlasRegion(const std::string& filename) {
+    _atlas_regions.erase(filename);
+
+    //An unreferenced region kept for reuse must not outlive its page.
+    CacheMap::iterator _iter = _cache.find(filename);
+    if(_iter != _cache.end() && _iter->second.references <= 0 && al_is_sub_bitmap(_iter->second.bitmap)) {
+        Evict(_iter);
+    }
+}
+
+void BitmapCache::RetireAtlasPage(ALLEGRO_BITMAP* page) {
+    if(page == nullptr) return;
+    _retired_pages.push_back(page);
+    ReleaseRetiredPage(page);
+}
+
+void BitmapCache::ReleaseRetiredPage(ALLEGRO_BITMAP* page) {
+    for(CacheMap::iterator _iter = _cache.begin(); _iter != _cache.end(); ++_iter) {
+        ALLEGRO_BITMAP* bmp = _iter->second.bitmap;
+        if(bmp != nullptr && al_is_sub_bitmap(bmp) && al_get_parent_bitmap(bmp) == page) return;
+    }
+    _retired_pages.erase(std::remove(_retired_pages.begin(), _retired_pages.end(), page), _retired_pages.end());
+    //Queued after its regions, so they are destroyed first.
+    RenderThread::DestroyBitmap(page);
+}
+
+ALLEGRO_BITMAP* BitmapCache::GetRetiredPage(ALLEGRO_BITMAP* bmp) {
+    if(_retired_pages.empty() || bmp == nullptr || IsPlaceholder(bmp) || al_is_sub_bitmap(bmp) == false) return nullptr;
+    ALLEGRO_BITMAP* parent = al_get_parent_bitmap(bmp);
+    if(std::find(_retired_pages.begin(), _retired_pages.end(), parent) == _retired_pages.end()) return nullptr;
+    return parent;
+}
+
+ALLEGRO_BITMAP* BitmapCache::PeekBitmap(const std::string& name) {
+    CacheMap::iterator _iter = _cache.find(name);
+    if(_iter == _cache.end()) return nullptr;
+    return _iter->second.bitmap;
+}
+
+void BitmapCache::GetCachedFilenames(std::vector<std::string>& filenames) {
+    for(CacheMap::iterator _iter = _cache.begin(); _iter != _cache.end(); ++_iter) {
+        if(AssetPack::FileExists(_iter->first) == false) continue;
+        filenames.push_back(_iter->first);
+    }
+}
+
+void BitmapCache::ReleaseBitmap(const std::string& filename) {
+    RemoveBitmap(filename);
+}
+
+bool BitmapCache::LoadBitmapAsync(const std::string& filename) {
+    return LoadBitmapAsync(filename, 0);
+}
+
+bool BitmapCache::LoadBitmapAsync(const std::string& filename, unsigned int group) {
+    if(filename.empty()) return false;
+
+    //Already cached, loading, or packed into an atlas: just add the reference.
+    CacheMap::iterator _iter = _cache.find(filename);
+    if(_iter != _cache.end() || _atlas_regions.find(filename) != _atlas_regions.end()) {
+        return GetBitmap(filename) != nullptr;
+    }
+    if(AssetPack::FileExists(filename) == false) return false;
+
+    if(loaders.empty() && StartLoaders(DEFAULT_LOADER_COUNT) == false) {
+        return GetBitmap(filename) != nullptr;
+    }
+
+    ALLEGRO_BITMAP* stand_in = GetPlaceholder();
+    if(stand_in == nullptr) return false;
+    ++_statistics.misses;
+    Insert(filename, stand_in, 1);
+
+    al_lock_mutex(load_mutex);
+    load_states[filename] = LOADSTATE_PENDING;
+    load_groups.insert(std::make_pair(group, filename));
+    decode_queue.push_back(filename);
+    al_signal_cond(work_ready);
+    al_unlock_mutex(load_mutex);
+    return true;
+}
+
+BitmapCache::LOADSTATE BitmapCache::GetLoadState(const std::string& filename) {
+    if(load_mutex == nullptr) return LOADSTATE_NONE;
+    al_lock_mutex(load_mutex);
+    std::map<std::string, LOADSTATE>::iterator _iter = load_states.find(filename);
+    LOADSTATE state = _iter != load_states.end() ? _iter->second : LOADSTATE_NONE;
+    al_unlock_mutex(load_mutex);
+    return state;
+}
+
+bool BitmapCache::IsGroupLoaded(unsigned int group) {
+    if(load_mutex == nullptr) return true;
+    al_lock_mutex(load_mutex);
+    bool loaded = IsGroupLoadedLocked(group);
+    al_unlock_mutex(load_mutex);
+    return loaded;
+}
+
+void BitmapCache::WaitForGroup(unsigned int group) {
+    if(load_mutex == nullptr) return;
+
+    //Loaders queue a result and signal under the lock, so checking the upload queue under it cannot miss one.
+    while(IsGroupLoaded(group) == false) {
+        if(UpdateLoads(0.0) > 0) continue;
+        al_lock_mutex(load_mutex);
+        if(upload_queue.empty() && IsGroupLoadedLocked(group) == false) al_wait_cond(work_done, load_mutex);
+        al_unlock_mutex(load_mutex);
+    }
+
+    al_lock_mutex(load_mutex);
+    load_groups.erase(group);
+    al_unlock_mutex(load_mutex);
+}
+
+std::size_t BitmapCache::UpdateLoads(double budget) {
+    if(load_mutex == nullptr) return 0;
+
+    double start = al_get_time();
+    std::size_t finished = 0;
+    do {
+        al_lock_mutex(load_mutex);
+        if(upload_queue.empty()) {
+            al_unlock_mutex(load_mutex);
+            break;
+        }
+        std::pair<std::string, ALLEGRO_BITMAP*> decoded = upload_queue.front();
+        upload_queue.pop_front();
+        al_unlock_mutex(load_mutex);
+
+        LOADSTATE state = LOADSTATE_FAILED;
+        CacheMap::iterator _iter = _cache.find(decoded.first);
+        if(_iter == _cache.end()) {
+            //Released before it finished.
+            al_destroy_bitmap(decoded.second);
+            state = LOADSTATE_NONE;
+        } else if(decoded.second != nullptr) {
+            //Cloning uses this thread's new bitmap flags, so the copy lands in video memory.
+            ALLEGRO_BITMAP* uploaded = al_clone_bitmap(decoded.second);
+            if(uploaded != nullptr) {
+                al_destroy_bitmap(decoded.second);
+            } else {
+                uploaded = decoded.second;
+            }
+            if(IsPlaceholder(_iter->second.bitmap)) {
+                _iter->second.bitmap = uploaded;
+                _iter->second.bytes = EstimateBytes(uploaded);
+                _statistics.resident_bytes += _iter->second.bytes;
+            } else {
+                //Released and requested again while queued; an earlier decode already landed.
+                al_destroy_bitmap(uploaded);
+            }
+            state = LOADSTATE_READY;
         }
-        al_destroy_bitmap(_iter->second.second);
-        _iter->second.second = nullptr;
-        _cache.erase(_iter++);
+
+        al_lock_mutex(load_mutex);
+        load_states[decoded.first] = state;
+        al_broadcast_cond(work_done);
+        al_unlock_mutex(load_mutex);
+        ++finished;
+    } while(al_get_time() - start < budget);
+    return finished;
+}
+
+bool BitmapCache::StartLoaders(unsigned int thread_count) {
+    if(loaders.empty() == false || thread_count == 0) return false;
+
+    if(load_mutex == nullptr) {
+        load_mutex = al_create_mutex();
+        work_ready = al_create_cond();
+        work_done = al_create_cond();
+        if(load_mutex == nullptr || work_ready == nullptr || work_done == nullptr) return false;
+    }
+    for(unsigned int i = 0; i < thread_count; ++i) {
+        ALLEGRO_THREAD* thread = al_create_thread(LoaderThread, nullptr);
+        if(thread == nullptr) break;
+        loaders.push_back(thread);
+        al_start_thread(thread);
+    }
+    return loaders.empty() == false;
+}
+
+void BitmapCache::StopLoaders() {
+    if(loaders.empty()) return;
+
+    al_lock_mutex(load_mutex);
+    for(std::vector<ALLEGRO_THREAD*>::iterator _iter = loaders.begin(); _iter != loaders.end(); ++_iter) {
+        al_set_thread_should_stop(*_iter);
+    }
+    al_broadcast_cond(work_ready);
+    al_unlock_mutex(load_mutex);
+
+    for(std::vector<ALLEGRO_THREAD*>::iterator _iter = loaders.begin(); _iter != loaders.end(); ++_iter) {
+        al_join_thread(*_iter, nullptr);
+        al_destroy_thread(*_iter);
     }
+    loaders.clear();
+}
+
+bool BitmapCache::IsPlaceholder(const ALLEGRO_BITMAP* bmp) {
+    return bmp != nullptr && bmp == placeholder;
+}
+
+const CollisionMask* BitmapCache::GetCollisionMask(const std::string& name) {
+    ALLEGRO_BITMAP* bmp = PeekBitmap(name);
+    if(bmp == nullptr) return nullptr;
+    return GetCollisionMask(name, 0, 0, al_get_bitmap_width(bmp), al_get_bitmap_height(bmp));
+}
+
+const CollisionMask* BitmapCache::GetCollisionMask(const std::string& name, int x, int y, int width, int height) {
+    CacheMap::iterator _iter = _cache.find(name);
+    if(_iter == _cache.end()) return nullptr;
+    CacheEntry& entry = _iter->second;
+
+    //Nothing to build from until an asynchronous load finishes.
+    if(entry.bitmap == nullptr || IsPlaceholder(entry.bitmap)) return nullptr;
+
+    MaskRegion region = { x, y, width, height };
+    std::map<MaskRegion, CollisionMask>::iterator _mask = entry.masks.find(region);
+    if(_mask == entry.masks.end()) {
+        _mask = entry.masks.insert(std::make_pair(region, CollisionMask(entry.bitmap, x, y, width, height, MASK_ALPHA_THRESHOLD))).first;
+        std::size_t bytes = _mask->second.GetBytes();
+        entry.bytes += bytes;
+        _statistics.resident_bytes += bytes;
+        if(entry.lru_position != _lru.end()) _statistics.unused_bytes += bytes;
+    }
+    return &_mask->second;
+}
+
+bool BitmapCache::MaskRegion::operator<(const MaskRegion& rhs) const {
+    if(x != rhs.x) return x < rhs.x;
+    if(y != rhs.y) return y < rhs.y;
+    if(width != rhs.width) return width < rhs.width;
+    return height < rhs.height;
 }
 
 A2DE_END
\ No newline at end of file
@@ -10,9 +10,14 @@
 
 #include "../a2de_vals.h"
 
+#include <list>
 #include <map>
+#include <unordered_map>
 #include <utility>
 #include <string>
+#include <vector>
+
+#include "CCollisionMask.h"
 
 struct ALLEGRO_BITMAP;
 
@@ -20,9 +25,187 @@ A2DE_BEGIN
 
 /**************************************************************************************************
  * <summary>Bitmap pool.</summary>
- * <remarks>Casey Ugone, 8/2/2011.</remarks>
+ * <remarks>Casey Ugone, 8/2/2011.
+ *          Bitmaps nobody references stay loaded, least recently released first out, until the
+ *          cache holds more than its byte budget.</remarks>
  **************************************************************************************************/
 class BitmapCache {
+public:
+
+    /**************************************************************************************************
+     * <summary>Cache counters.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct Statistics {
+        /// <summary> Requests answered from the cache.</summary>
+        unsigned long hits;
+        /// <summary> Requests that had to load a file or create an atlas region.</summary>
+        unsigned long misses;
+        /// <summary> Unreferenced bitmaps destroyed to stay within the budget.</summary>
+        unsigned long evictions;
+        /// <summary> The estimated size of every cached bitmap.</summary>
+        std::size_t resident_bytes;
+        /// <summary> The estimated size of the cached bitmaps nobody references.</summary>
+        std::size_t unused_bytes;
+    };
+
+    /**************************************************************************************************
+     * <summary>Sets the number of bytes the cache may hold before it evicts unreferenced bitmaps.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Referenced bitmaps count toward the budget but are never evicted. A budget of zero
+     *          destroys bitmaps as soon as they are released. The default is 64 MiB.</remarks>
+     * <param name="bytes">The budget in bytes.</param>
+     **************************************************************************************************/
+    static void SetBudget(std::size_t bytes);
+
+    /**************************************************************************************************
+     * <summary>Gets the budget.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The budget in bytes.</returns>
+     **************************************************************************************************/
+    static std::size_t GetBudget();
+
+    /**************************************************************************************************
+     * <summary>Destroys every bitmap nobody references.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void Purge();
+
+    /**************************************************************************************************
+     * <summary>Gets the cache counters.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The statistics.</returns>
+     **************************************************************************************************/
+    static const Statistics& GetStatistics();
+
+    /**************************************************************************************************
+     * <summary>Zeroes the hit, miss and eviction counters.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void ResetStatistics();
+
+    /// <summary> The progress of an asynchronous load.</summary>
+    enum LOADSTATE {
+        /// <summary> The file was never requested asynchronously, or was released before it finished.</summary>
+        LOADSTATE_NONE,
+        /// <summary> The file is waiting to be decoded or uploaded. Users see the placeholder.</summary>
+        LOADSTATE_PENDING,
+        /// <summary> The bitmap is in the cache.</summary>
+        LOADSTATE_READY,
+        /// <summary> The file could not be decoded. Users keep the placeholder.</summary>
+        LOADSTATE_FAILED,
+    };
+
+    /**************************************************************************************************
+     * <summary>Requests a bitmap without waiting for it to load.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Adds a reference like GetBitmap; release it with ReleaseBitmap. Until the file is
+     *          decoded and uploaded, the cache hands out a shared placeholder bitmap under its name.
+     *          Starts the loader threads if they are not running.</remarks>
+     * <param name="filename">Path and Filename of the file. It is the handle for GetLoadState.</param>
+     * <returns>true if it is loading or already loaded, false if the file does not exist.</returns>
+     **************************************************************************************************/
+    static bool LoadBitmapAsync(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Requests a bitmap as part of a group without waiting for it to load.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the file. It is the handle for GetLoadState.</param>
+     * <param name="group">   The group to wait on, for example a level number.</param>
+     * <returns>true if it is loading or already loaded, false if the file does not exist.</returns>
+     **************************************************************************************************/
+    static bool LoadBitmapAsync(const std::string& filename, unsigned int group);
+
+    /**************************************************************************************************
+     * <summary>Releases the reference taken by LoadBitmapAsync.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Once nothing references the bitmap it can be evicted. A file released before it
+     *          finished loading is dropped when its decode completes.</remarks>
+     * <param name="filename">Path and Filename of the file passed to LoadBitmapAsync.</param>
+     **************************************************************************************************/
+    static void ReleaseBitmap(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Gets the progress of an asynchronous load.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the file.</param>
+     * <returns>The load state.</returns>
+     **************************************************************************************************/
+    static LOADSTATE GetLoadState(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Query if every file in a group has finished, successfully or not.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="group">The group.</param>
+     * <returns>true if nothing in the group is pending, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsGroupLoaded(unsigned int group);
+
+    /**************************************************************************************************
+     * <summary>Blocks until every file in a group is decoded, uploads everything decoded so far, then forgets the group.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Must be called from the thread that owns the display.</remarks>
+     * <param name="group">The group.</param>
+     **************************************************************************************************/
+    static void WaitForGroup(unsigned int group);
+
+    /**************************************************************************************************
+     * <summary>Uploads decoded bitmaps to video memory and swaps them into the cache.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Must be called from the thread that owns the display, usually once a frame. At least
+     *          one bitmap is uploaded per call so loading always makes progress.</remarks>
+     * <param name="budget">The time to spend in seconds.</param>
+     * <returns>The number of bitmaps finished.</returns>
+     **************************************************************************************************/
+    static std::size_t UpdateLoads(double budget);
+
+    /**************************************************************************************************
+     * <summary>Starts the loader threads.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="thread_count">The number of threads decoding files.</param>
+     * <returns>true if they are running, false if they could not be started or are already running.</returns>
+     **************************************************************************************************/
+    static bool StartLoaders(unsigned int thread_count);
+
+    /**************************************************************************************************
+     * <summary>Finishes the queued files and stops the loader threads.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Files decoded but not yet uploaded are uploaded by the next UpdateLoads.</remarks>
+     **************************************************************************************************/
+    static void StopLoaders();
+
+    /**************************************************************************************************
+     * <summary>Query if a bitmap is the shared placeholder for files still loading.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="bmp">The bitmap.</param>
+     * <returns>true if it is the placeholder, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsPlaceholder(const ALLEGRO_BITMAP* bmp);
+
+    /**************************************************************************************************
+     * <summary>Gets the collision mask of a cached bitmap, building it on first request.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Pixels with at least half alpha are solid. The mask is kept with the bitmap, counts
+     *          toward the budget and stays valid while anything references the bitmap.</remarks>
+     * <param name="name">The name or filename of the bitmap.</param>
+     * <returns>null if the bitmap is not cached or is still loading, else the mask.</returns>
+     **************************************************************************************************/
+    static const CollisionMask* GetCollisionMask(const std::string& name);
+
+    /**************************************************************************************************
+     * <summary>Gets the collision mask of a region of a cached bitmap, building it on first request.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Each region, such as each frame of a sheet, has its own mask.</remarks>
+     * <param name="name">  The name or filename of the bitmap.</param>
+     * <param name="x">     The left edge of the region.</param>
+     * <param name="y">     The top edge of the region.</param>
+     * <param name="width"> The width of the region.</param>
+     * <param name="height">The height of the region.</param>
+     * <returns>null if the bitmap is not cached or is still loading, else the mask.</returns>
+     **************************************************************************************************/
+    static const CollisionMask* GetCollisionMask(const std::string& name, int x, int y, int width, int height);
+
+private:
 
     /**************************************************************************************************
      * <summary>Pulls the requested bitmap from the cache if it has already been loaded, else it loads and stores it first.</summary>
@@ -56,20 +239,169 @@ class BitmapCache {
      **************************************************************************************************/
     static void RemoveBitmap(const std::string& name);
 
-    /// <summary> The BITMAP cache:
-    ///           std::string: The name or filepath of the ALLEGRO_BITMAP.
-    ///           long: The total number of references of the name.
-    ///           ALLEGRO_BITMAP*: The stored pixel data.</summary>
-    static std::map<std::string, std::pair<long, ALLEGRO_BITMAP*> > _cache;
+    /**************************************************************************************************
+     * <summary>The region of a bitmap a collision mask covers.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct MaskRegion {
+        /// <summary> The left edge of the region.</summary>
+        int x;
+        /// <summary> The top edge of the region.</summary>
+        int y;
+        /// <summary> The width of the region.</summary>
+        int width;
+        /// <summary> The height of the region.</summary>
+        int height;
+        /// <summary> Orders regions for the mask map.</summary>
+        bool operator<(const MaskRegion& rhs) const;
+    };
+
+    /**************************************************************************************************
+     * <summary>A cached bitmap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct CacheEntry {
+        /// <summary> The total number of references of the name.</summary>
+        long references;
+        /// <summary> The stored pixel data.</summary>
+        ALLEGRO_BITMAP* bitmap;
+        /// <summary> The estimated size of the pixel data and masks. The pixel data of sub-bitmaps and the placeholder counts as zero.</summary>
+        std::size_t bytes;
+        /// <summary> The collision masks built from the bitmap.</summary>
+        std::map<MaskRegion, CollisionMask> masks;
+        /// <summary> The entry's place in the LRU list while nobody references it.</summary>
+        std::list<std::string>::iterator lru_position;
+    };
+
+    typedef std::unordered_map<std::string, CacheEntry> CacheMap;
+
+    /// <summary> The BITMAP cache keyed by the name or filepath of the ALLEGRO_BITMAP.</summary>
+    static CacheMap _cache;
+    /// <summary> The names of unreferenced entries, most recently released first.</summary>
+    static std::list<std::string> _lru;
+    /// <summary> The budget in bytes.</summary>
+    static std::size_t _budget;
+    /// <summary> The counters.</summary>
+    static Statistics _statistics;
 
     /**************************************************************************************************
-     * <summary>Cleans the cache of any unreferenced keys.</summary>
+     * <summary>Evicts the least recently released bitmaps until the cache is within its budget.</summary>
      * <remarks>Casey Ugone, 8/2/2011.</remarks>
      **************************************************************************************************/
     static void CleanCache();
 
+    /**************************************************************************************************
+     * <summary>Adds an entry.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="name">      The name or filepath.</param>
+     * <param name="bmp">       The bitmap.</param>
+     * <param name="references">The starting reference count. Zero puts it straight on the LRU list.</param>
+     **************************************************************************************************/
+    static void Insert(const std::string& name, ALLEGRO_BITMAP* bmp, long references);
+
+    /**************************************************************************************************
+     * <summary>Adds a reference to an entry, taking it off the LRU list if nobody referenced it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="entry">[in,out] The entry.</param>
+     * <returns>The bitmap.</returns>
+     **************************************************************************************************/
+    static ALLEGRO_BITMAP* AddReference(CacheEntry& entry);
+
+    /**************************************************************************************************
+     * <summary>Destroys an unreferenced entry's bitmap and removes it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="position">The entry.</param>
+     **************************************************************************************************/
+    static void Evict(CacheMap::iterator position);
+
+    /**************************************************************************************************
+     * <summary>Estimates how much memory a bitmap owns.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="bmp">The bitmap.</param>
+     * <returns>The size in bytes. Zero for sub-bitmaps and the placeholder, which own no pixels of their own.</returns>
+     **************************************************************************************************/
+    static std::size_t EstimateBytes(ALLEGRO_BITMAP* bmp);
+
+    /**************************************************************************************************
+     * <summary>A region of an atlas page that stands in for an image file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct AtlasRegion {
+        /// <summary> The atlas page.</summary>
+        ALLEGRO_BITMAP* page;
+        /// <summary> The left edge of the region on the page.</summary>
+        int x;
+        /// <summary> The top edge of the region on the page.</summary>
+        int y;
+        /// <summary> The width of the region.</summary>
+        int width;
+        /// <summary> The height of the region.</summary>
+        int height;
+    };
+
+    /**************************************************************************************************
+     * <summary>Makes GetBitmap return a sub-bitmap of an atlas page instead of loading the file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Only affects requests made while the file is not already cached.</remarks>
+     * <param name="filename">Path and Filename of the image the region replaces.</param>
+     * <param name="region">  The region.</param>
+     **************************************************************************************************/
+    static void RegisterAtlasRegion(const std::string& filename, const AtlasRegion& region);
+
+    /**************************************************************************************************
+     * <summary>Removes an atlas region so the file is loaded from disk again.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the image.</param>
+     **************************************************************************************************/
+    static void UnregisterAtlasRegion(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Destroys an atlas page once no cached bitmap is a region of it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Unregister the page's regions first. Regions still referenced keep the page alive
+     *          and are evicted as soon as they are released, and the page goes with the last.</remarks>
+     * <param name="page">[in,out] If non-null, the page.</param>
+     **************************************************************************************************/
+    static void RetireAtlasPage(ALLEGRO_BITMAP* page);
+
+    /**************************************************************************************************
+     * <summary>Destroys a retired atlas page if no cached bitmap is a region of it any more.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="page">The page.</param>
+     **************************************************************************************************/
+    static void ReleaseRetiredPage(ALLEGRO_BITMAP* page);
+
+    /**************************************************************************************************
+     * <summary>Query if a bitmap is a region of a retired atlas page.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="bmp">The bitmap.</param>
+     * <returns>The page if it is, else null.</returns>
+     **************************************************************************************************/
+    static ALLEGRO_BITMAP* GetRetiredPage(ALLEGRO_BITMAP* bmp);
+
+    /**************************************************************************************************
+     * <summary>Gets a cached bitmap without adding a reference.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="name">The name or filename of the ALLEGRO_BITMAP.</param>
+     * <returns>null if it is not cached, else the ALLEGRO_BITMAP.</returns>
+     **************************************************************************************************/
+    static ALLEGRO_BITMAP* PeekBitmap(const std::string& name);
+
+    /**************************************************************************************************
+     * <summary>Gets the names of every cached bitmap that was loaded from a file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filenames">[out] The filenames are appended.</param>
+     **************************************************************************************************/
+    static void GetCachedFilenames(std::vector<std::string>& filenames);
+
+    /// <summary> The atlas regions by image filename.</summary>
+    static std::map<std::string, AtlasRegion> _atlas_regions;
+    /// <summary> Atlas pages given up by their atlas but still holding referenced regions.</summary>
+    static std::vector<ALLEGRO_BITMAP*> _retired_pages;
+
     friend class Sprite;
     friend class TileSet;
+    friend class TextureAtlas;
 };
 
 A2DE_END
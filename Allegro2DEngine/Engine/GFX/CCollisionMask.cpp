@@ -0,0 +1,220 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CCollisionMask.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the collision mask class.
+ **************************************************************************************************/
+#include "CCollisionMask.h"
+
+#include <algorithm>
+
+#include <allegro5/allegro.h>
+
+#if defined(__AVX2__)
+#define A2DE_MASK_AVX2
+#include <immintrin.h>
+#endif
+
+#include "../a2de_exceptions.h"
+
+A2DE_BEGIN
+
+namespace {
+
+    /// <summary> Bits in a word.</summary>
+    const int WORD_BITS = 64;
+
+    long FloorDivide(long value, long divisor) {
+        long quotient = value / divisor;
+        if(value % divisor != 0 && value < 0) --quotient;
+        return quotient;
+    }
+
+    /// <summary> Gets the 64 bits of a row starting at a bit index; bits outside the row are clear.</summary>
+    unsigned long long GetBitsAt(const unsigned long long* row, long words, long bit) {
+        long word = FloorDivide(bit, WORD_BITS);
+        int shift = static_cast<int>(bit - word * WORD_BITS);
+        unsigned long long low = (word >= 0 && word < words) ? row[word] : 0;
+        if(shift == 0) return low;
+        unsigned long long high = (word + 1 >= 0 && word + 1 < words) ? row[word + 1] : 0;
+        return (low >> shift) | (high << (WORD_BITS - shift));
+    }
+
+    std::size_t CountBits(unsigned long long word) {
+        std::size_t count = 0;
+        while(word != 0) {
+            word &= word - 1;
+            ++count;
+        }
+        return count;
+    }
+
+}
+
+CollisionMask::CollisionMask() : _width(0), _height(0), _words_per_row(0), _bits() {
+    /* DO NOTHING */
+}
+
+CollisionMask::CollisionMask(ALLEGRO_BITMAP* bitmap, unsigned char threshold) : _width(0), _height(0), _words_per_row(0), _bits() {
+    if(bitmap == nullptr) return;
+    Build(bitmap, 0, 0, al_get_bitmap_width(bitmap), al_get_bitmap_height(bitmap), threshold);
+}
+
+CollisionMask::CollisionMask(ALLEGRO_BITMAP* bitmap, int x, int y, int width, int height, unsigned char threshold) : _width(0), _height(0), _words_per_row(0), _bits() {
+    Build(bitmap, x, y, width, height, threshold);
+}
+
+CollisionMask::CollisionMask(const CollisionMask& other) : _width(other._width), _height(other._height), _words_per_row(other._words_per_row), _bits(other._bits) {
+    /* DO NOTHING */
+}
+
+CollisionMask::~CollisionMask() {
+    /* DO NOTHING */
+}
+
+CollisionMask& CollisionMask::operator=(const CollisionMask& rhs) {
+    if(this == &rhs) return *this;
+    this->_width = rhs._width;
+    this->_height = rhs._height;
+    this->_words_per_row = rhs._words_per_row;
+    this->_bits = rhs._bits;
+    return *this;
+}
+
+void CollisionMask::Build(ALLEGRO_BITMAP* bitmap, int x, int y, int width, int height, unsigned char threshold) {
+    if(bitmap == nullptr) return;
+    int left = std::max(x, 0);
+    int top = std::max(y, 0);
+    int right = std::min(x + width, al_get_bitmap_width(bitmap));
+    int bottom = std::min(y + height, al_get_bitmap_height(bitmap));
+    if(left >= right || top >= bottom) return;
+
+    _width = right - left;
+    _height = bottom - top;
+    _words_per_row = static_cast<std::size_t>((_width + WORD_BITS - 1) / WORD_BITS);
+    _bits.assign(_words_per_row * _height, 0);
+
+    //Locked as bytes in R, G, B, A order whatever the bitmap's own format.
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap_region(bitmap, left, top, _width, _height, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+    for(int row = 0; row < _height; ++row) {
+        unsigned long long* words = &_bits[row * _words_per_row];
+        const unsigned char* pixels = region != nullptr ? static_cast<const unsigned char*>(region->data) + row * region->pitch : nullptr;
+        for(int column = 0; column < _width; ++column) {
+            unsigned char alpha = 0;
+            if(pixels != nullptr) {
+                alpha = pixels[column * 4 + 3];
+            } else {
+                unsigned char r = 0;
+                unsigned char g = 0;
+                unsigned char b = 0;
+                al_unmap_rgba(al_get_pixel(bitmap, left + column, top + row), &r, &g, &b, &alpha);
+            }
+            if(alpha < threshold) continue;
+            words[column / WORD_BITS] |= 1ULL << (column % WORD_BITS);
+        }
+    }
+    if(region != nullptr) al_unlock_bitmap(bitmap);
+}
+
+int CollisionMask::GetWidth() const {
+    return _width;
+}
+
+int CollisionMask::GetHeight() const {
+    return _height;
+}
+
+std::size_t CollisionMask::GetWordsPerRow() const {
+    return _words_per_row;
+}
+
+const unsigned long long* CollisionMask::GetRow(int y) const {
+    if(y < 0 || y >= _height) throw IndexOutOfBoundsException("y", "0", "GetHeight() - 1");
+    return &_bits[y * _words_per_row];
+}
+
+bool CollisionMask::IsSolid(int x, int y) const {
+    if(x < 0 || y < 0 || x >= _width || y >= _height) return false;
+    return ((_bits[y * _words_per_row + x / WORD_BITS] >> (x % WORD_BITS)) & 1ULL) != 0;
+}
+
+std::size_t CollisionMask::GetSolidCount() const {
+    std::size_t count = 0;
+    for(std::vector<unsigned long long>::const_iterator _iter = _bits.begin(); _iter != _bits.end(); ++_iter) {
+        count += CountBits(*_iter);
+    }
+    return count;
+}
+
+std::size_t CollisionMask::GetBytes() const {
+    return _bits.size() * sizeof(unsigned long long);
+}
+
+bool CollisionMask::Overlaps(const CollisionMask& other, int offset_x, int offset_y) const {
+    int left = std::max(0, offset_x);
+    int top = std::max(0, offset_y);
+    int right = std::min(_width, offset_x + other._width);
+    int bottom = std::min(_height, offset_y + other._height);
+    if(left >= right || top >= bottom) return false;
+
+    //Only this mask's words inside the overlap are tested; other's bits outside it read as clear.
+    long first_word = left / WORD_BITS;
+    long last_word = (right - 1) / WORD_BITS;
+    long other_words = static_cast<long>(other._words_per_row);
+#ifdef A2DE_MASK_AVX2
+    long start_bit = first_word * WORD_BITS - offset_x;
+    int shift = static_cast<int>(start_bit - FloorDivide(start_bit, WORD_BITS) * WORD_BITS);
+    //Shifting a 64-bit lane by 64 clears it, so a shift of 0 needs no special case here.
+    const __m128i right_shift = _mm_cvtsi32_si128(shift);
+    const __m128i left_shift = _mm_cvtsi32_si128(WORD_BITS - shift);
+#endif
+    for(int y = top; y < bottom; ++y) {
+        const unsigned long long* row = &_bits[y * _words_per_row];
+        const unsigned long long* other_row = &other._bits[(y - offset_y) * other._words_per_row];
+        long word = first_word;
+        while(word <= last_word) {
+            long bit = word * WORD_BITS - offset_x;
+#ifdef A2DE_MASK_AVX2
+            long other_word = FloorDivide(bit, WORD_BITS);
+            if(word + 3 <= last_word && other_word >= 0 && other_word + 4 < other_words) {
+                __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other_row + other_word));
+                __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other_row + other_word + 1));
+                __m256i shifted = _mm256_or_si256(_mm256_srl_epi64(low, right_shift), _mm256_sll_epi64(high, left_shift));
+                __m256i mine = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + word));
+                if(_mm256_testz_si256(mine, shifted) == 0) return true;
+                word += 4;
+                continue;
+            }
+#endif
+            if((row[word] & GetBitsAt(other_row, other_words, bit)) != 0) return true;
+            ++word;
+        }
+    }
+    return false;
+}
+
+bool CollisionMask::Overlaps(int x, int y, int width, int height) const {
+    int left = std::max(0, x);
+    int top = std::max(0, y);
+    int right = std::min(_width, x + width);
+    int bottom = std::min(_height, y + height);
+    if(left >= right || top >= bottom) return false;
+
+    long first_word = left / WORD_BITS;
+    long last_word = (right - 1) / WORD_BITS;
+    unsigned long long first_bits = ~0ULL << (left % WORD_BITS);
+    unsigned long long last_bits = (right % WORD_BITS) == 0 ? ~0ULL : (1ULL << (right % WORD_BITS)) - 1;
+    for(int row = top; row < bottom; ++row) {
+        const unsigned long long* words = &_bits[row * _words_per_row];
+        for(long word = first_word; word <= last_word; ++word) {
+            unsigned long long bits = words[word];
+            if(word == first_word) bits &= first_bits;
+            if(word == last_word) bits &= last_bits;
+            if(bits != 0) return true;
+        }
+    }
+    return false;
+}
+
+A2DE_END
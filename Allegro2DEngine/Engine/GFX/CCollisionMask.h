@@ -0,0 +1,182 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CCollisionMask.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the collision mask class.
+ **************************************************************************************************/
+#ifndef A2DE_CCOLLISIONMASK_H
+#define A2DE_CCOLLISIONMASK_H
+
+#include "../a2de_vals.h"
+
+#include <cstddef>
+#include <vector>
+
+struct ALLEGRO_BITMAP;
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>The solid pixels of a bitmap, one bit per pixel, for pixel-perfect collision tests.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Each row is packed into 64-bit words, leftmost pixel in the lowest bit, and padded
+ *          with clear bits to a whole word. Two masks are tested by shifting one row onto the
+ *          other's words and ANDing them, so a row costs one or two word operations per 64
+ *          pixels. Built with AVX2 enabled, the middle of wide rows is tested 256 bits at a time.
+ *          Build masks once at load time; BitmapCache keeps them with their bitmaps.</remarks>
+ **************************************************************************************************/
+class CollisionMask {
+public:
+
+    /**************************************************************************************************
+     * <summary>Default constructor. The mask is empty and overlaps nothing.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    CollisionMask();
+
+    /**************************************************************************************************
+     * <summary>Builds the mask of a whole bitmap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Reads the bitmap back from video memory if it has to; do it while loading.</remarks>
+     * <param name="bitmap">   [in,out] If non-null, the bitmap.</param>
+     * <param name="threshold">Pixels with at least this alpha are solid.</param>
+     **************************************************************************************************/
+    CollisionMask(ALLEGRO_BITMAP* bitmap, unsigned char threshold);
+
+    /**************************************************************************************************
+     * <summary>Builds the mask of a region of a bitmap, such as one frame of a sheet.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The region is clipped to the bitmap.</remarks>
+     * <param name="bitmap">   [in,out] If non-null, the bitmap.</param>
+     * <param name="x">        The left edge of the region.</param>
+     * <param name="y">        The top edge of the region.</param>
+     * <param name="width">    The width of the region.</param>
+     * <param name="height">   The height of the region.</param>
+     * <param name="threshold">Pixels with at least this alpha are solid.</param>
+     **************************************************************************************************/
+    CollisionMask(ALLEGRO_BITMAP* bitmap, int x, int y, int width, int height, unsigned char threshold);
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    CollisionMask(const CollisionMask& other);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~CollisionMask();
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A deep copy of this object.</returns>
+     **************************************************************************************************/
+    CollisionMask& operator=(const CollisionMask& rhs);
+
+    /**************************************************************************************************
+     * <summary>Gets the width.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The width in pixels.</returns>
+     **************************************************************************************************/
+    int GetWidth() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the height.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The height in pixels.</returns>
+     **************************************************************************************************/
+    int GetHeight() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the number of 64-bit words in a row.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The words per row.</returns>
+     **************************************************************************************************/
+    std::size_t GetWordsPerRow() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the words of a row.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="y">The row.</param>
+     * <returns>The first of GetWordsPerRow words.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when y is not a row of the mask.</exception>
+     **************************************************************************************************/
+    const unsigned long long* GetRow(int y) const;
+
+    /**************************************************************************************************
+     * <summary>Query if a pixel is solid.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="x">The x coordinate.</param>
+     * <param name="y">The y coordinate.</param>
+     * <returns>true if solid, false if clear or outside the mask.</returns>
+     **************************************************************************************************/
+    bool IsSolid(int x, int y) const;
+
+    /**************************************************************************************************
+     * <summary>Counts the solid pixels.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The solid pixel count.</returns>
+     **************************************************************************************************/
+    std::size_t GetSolidCount() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the memory used by the bits.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The size in bytes.</returns>
+     **************************************************************************************************/
+    std::size_t GetBytes() const;
+
+    /**************************************************************************************************
+     * <summary>Query if any solid pixel of this mask covers a solid pixel of another.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="other">   The other mask.</param>
+     * <param name="offset_x">The x coordinate of other's left edge relative to this one's, in pixels.</param>
+     * <param name="offset_y">The y coordinate of other's top edge relative to this one's, in pixels.</param>
+     * <returns>true if they overlap, false if not.</returns>
+     **************************************************************************************************/
+    bool Overlaps(const CollisionMask& other, int offset_x, int offset_y) const;
+
+    /**************************************************************************************************
+     * <summary>Query if any solid pixel lies inside a rectangle, for testing against a body without a mask.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="x">     The left edge relative to the mask's, in pixels.</param>
+     * <param name="y">     The top edge relative to the mask's, in pixels.</param>
+     * <param name="width"> The width in pixels.</param>
+     * <param name="height">The height in pixels.</param>
+     * <returns>true if they overlap, false if not.</returns>
+     **************************************************************************************************/
+    bool Overlaps(int x, int y, int width, int height) const;
+
+private:
+
+    /**************************************************************************************************
+     * <summary>Packs the alpha of a region of a bitmap into the bits.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="bitmap">   [in,out] If non-null, the bitmap.</param>
+     * <param name="x">        The left edge of the region.</param>
+     * <param name="y">        The top edge of the region.</param>
+     * <param name="width">    The width of the region.</param>
+     * <param name="height">   The height of the region.</param>
+     * <param name="threshold">Pixels with at least this alpha are solid.</param>
+     **************************************************************************************************/
+    void Build(ALLEGRO_BITMAP* bitmap, int x, int y, int width, int height, unsigned char threshold);
+
+    /// <summary> The width in pixels.</summary>
+    int _width;
+    /// <summary> The height in pixels.</summary>
+    int _height;
+    /// <summary> The number of words in a row.</summary>
+    std::size_t _words_per_row;
+    /// <summary> The rows, one after another.</summary>
+    std::vector<unsigned long long> _bits;
+
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,221 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CDirtyRegions.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the dirty regions class.
+ **************************************************************************************************/
+#include "CDirtyRegions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <allegro5/allegro.h>
+
+#include "../a2de_exceptions.h"
+
+A2DE_BEGIN
+
+/************************************************************************/
+/* DO NOT DEFINE CONSTRUCTORS, DESTRUCTOR, ASSIGNMENT OPERATOR!         */
+/************************************************************************/
+
+namespace {
+
+    /// <summary> A region in whole pixels; right and bottom are exclusive.</summary>
+    struct Region {
+        int left, top, right, bottom;
+    };
+
+    /// <summary> The display, or null when not enabled.</summary>
+    ALLEGRO_DISPLAY* dirty_display = nullptr;
+    /// <summary> The copy of the last frame.</summary>
+    ALLEGRO_BITMAP* composite = nullptr;
+    /// <summary> The areas marked since the last frame.</summary>
+    std::vector<Region> pending;
+    /// <summary> The bounds of the areas marked, drawn this frame in one clipped pass.</summary>
+    std::vector<Region> regions;
+    /// <summary> true to redraw the whole screen next frame.</summary>
+    bool pending_all = false;
+    /// <summary> true between BeginFrame and EndFrame.</summary>
+    bool drawing_region = false;
+
+    long Area(const Region& region) {
+        return static_cast<long>(region.right - region.left) * static_cast<long>(region.bottom - region.top);
+    }
+
+    Region Union(const Region& a, const Region& b) {
+        Region result;
+        result.left = std::min(a.left, b.left);
+        result.top = std::min(a.top, b.top);
+        result.right = std::max(a.right, b.right);
+        result.bottom = std::max(a.bottom, b.bottom);
+        return result;
+    }
+
+    void CopyRegion(ALLEGRO_BITMAP* source, const Region& region) {
+        al_draw_bitmap_region(source, static_cast<float>(region.left), static_cast<float>(region.top), static_cast<float>(region.right - region.left), static_cast<float>(region.bottom - region.top), static_cast<float>(region.left), static_cast<float>(region.top), 0);
+    }
+
+    /// <summary> Makes dest the target and copies onto it exactly, whatever its blender and transform. Undo with al_restore_state.</summary>
+    void BeginCopy(ALLEGRO_BITMAP* dest, ALLEGRO_STATE& state) {
+        //Stored first, so al_restore_state goes back to the caller's target rather than dest.
+        al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER | ALLEGRO_STATE_TRANSFORM);
+        al_set_target_bitmap(dest);
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+        ALLEGRO_TRANSFORM identity;
+        al_identity_transform(&identity);
+        al_use_transform(&identity);
+    }
+
+    bool CreateComposite() {
+        ALLEGRO_BITMAP* backbuffer = al_get_backbuffer(dirty_display);
+        al_destroy_bitmap(composite);
+        composite = al_create_bitmap(al_get_bitmap_width(backbuffer), al_get_bitmap_height(backbuffer));
+        pending_all = true;
+        return composite != nullptr;
+    }
+
+}
+
+bool DirtyRegions::Enable(ALLEGRO_DISPLAY* display) {
+    if(display == nullptr) return false;
+    dirty_display = display;
+    pending.clear();
+    regions.clear();
+    drawing_region = false;
+    if(CreateComposite() == false) {
+        dirty_display = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void DirtyRegions::Disable() {
+    if(drawing_region) EndFrame();
+    al_destroy_bitmap(composite);
+    composite = nullptr;
+    dirty_display = nullptr;
+    pending.clear();
+    regions.clear();
+    pending_all = false;
+}
+
+bool DirtyRegions::IsEnabled() {
+    return dirty_display != nullptr;
+}
+
+void DirtyRegions::Invalidate(double x, double y, double width, double height) {
+    if(dirty_display == nullptr || pending_all) return;
+    if(width <= 0.0 || height <= 0.0) return;
+    Region region;
+    region.left = static_cast<int>(std::floor(x));
+    region.top = static_cast<int>(std::floor(y));
+    region.right = static_cast<int>(std::ceil(x + width));
+    region.bottom = static_cast<int>(std::ceil(y + height));
+    pending.push_back(region);
+}
+
+void DirtyRegions::Invalidate(const a2de::Rectangle& area) {
+    Invalidate(area.GetX() - area.GetHalfWidth(), area.GetY() - area.GetHalfHeight(), area.GetHalfWidth() * 2.0, area.GetHalfHeight() * 2.0);
+}
+
+void DirtyRegions::Invalidate(const a2de::Rectangle& old_area, const a2de::Rectangle& new_area) {
+    Invalidate(old_area);
+    Invalidate(new_area);
+}
+
+void DirtyRegions::InvalidateAll() {
+    if(dirty_display == nullptr) return;
+    pending_all = true;
+    pending.clear();
+}
+
+bool DirtyRegions::BeginFrame() {
+    if(dirty_display == nullptr) return false;
+    regions.clear();
+
+    ALLEGRO_BITMAP* backbuffer = al_get_backbuffer(dirty_display);
+    int width = al_get_bitmap_width(backbuffer);
+    int height = al_get_bitmap_height(backbuffer);
+    if(composite == nullptr || al_get_bitmap_width(composite) != width || al_get_bitmap_height(composite) != height) {
+        if(CreateComposite() == false) return false;
+    }
+
+    //One pass clipped to the bounds of every change; a pass per area would submit the whole frame each time.
+    Region screen = { 0, 0, width, height };
+    if(pending_all) {
+        regions.push_back(screen);
+    } else {
+        std::size_t pending_count = pending.size();
+        for(std::size_t i = 0; i < pending_count; ++i) {
+            Region region = pending[i];
+            region.left = std::max(region.left, 0);
+            region.top = std::max(region.top, 0);
+            region.right = std::min(region.right, width);
+            region.bottom = std::min(region.bottom, height);
+            if(region.left >= region.right || region.top >= region.bottom) continue;
+            if(regions.empty()) {
+                regions.push_back(region);
+            } else {
+                regions.front() = Union(regions.front(), region);
+            }
+        }
+    }
+    pending.clear();
+    pending_all = false;
+    if(regions.empty()) return false;
+
+    //The back buffer's contents after a flip are undefined; start from the last frame.
+    const Region& region = regions.front();
+    if(Area(region) != Area(screen)) {
+        ALLEGRO_STATE state;
+        BeginCopy(backbuffer, state);
+        al_reset_clipping_rectangle();
+        al_draw_bitmap(composite, 0.0f, 0.0f, 0);
+        al_restore_state(&state);
+    }
+    al_set_target_bitmap(backbuffer);
+    al_set_clipping_rectangle(region.left, region.top, region.right - region.left, region.bottom - region.top);
+    drawing_region = true;
+    return true;
+}
+
+bool DirtyRegions::IsDrawingRegion() {
+    return drawing_region;
+}
+
+void DirtyRegions::EndFrame() {
+    if(dirty_display == nullptr) return;
+    drawing_region = false;
+
+    ALLEGRO_BITMAP* backbuffer = al_get_backbuffer(dirty_display);
+    al_set_target_bitmap(backbuffer);
+    al_reset_clipping_rectangle();
+
+    ALLEGRO_STATE state;
+    BeginCopy(composite, state);
+    std::size_t region_count = regions.size();
+    for(std::size_t i = 0; i < region_count; ++i) {
+        CopyRegion(backbuffer, regions[i]);
+    }
+    al_restore_state(&state);
+
+    al_set_target_backbuffer(dirty_display);
+    al_flip_display();
+}
+
+std::size_t DirtyRegions::GetRegionCount() {
+    return regions.size();
+}
+
+a2de::Rectangle DirtyRegions::GetRegion(std::size_t index) {
+    if(index >= regions.size()) throw a2de::IndexOutOfBoundsException("index", "0", "regions.size() - 1");
+    const Region& region = regions[index];
+    double half_width = (region.right - region.left) * 0.5;
+    double half_height = (region.bottom - region.top) * 0.5;
+    return a2de::Rectangle(region.left + half_width, region.top + half_height, half_width, half_height);
+}
+
+A2DE_END
@@ -0,0 +1,148 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CDirtyRegions.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the dirty regions class.
+ **************************************************************************************************/
+#ifndef A2DE_CDIRTYREGIONS_H
+#define A2DE_CDIRTYREGIONS_H
+
+#include "../a2de_vals.h"
+
+#include <cstddef>
+
+#include <allegro5/display.h>
+
+#include "../Math/CRectangle.h"
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Redraws only the parts of the screen that changed.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Meant for screens that are mostly still, such as menus, inventories and maps. While
+ *          enabled, a copy of the last frame is kept in a composite bitmap. Anything that changes
+ *          reports the screen area it covered and now covers through Invalidate; World does this
+ *          for bodies that move, are added or removed, and for every camera move. Sprites do it
+ *          when their frame, tint or alpha changes and TileMap when a tile changes, both where
+ *          they were last drawn. Before a frame
+ *          the areas are merged into the one region that bounds them and the composite is put
+ *          back on the back buffer. Game then calls Render once with the back buffer clipped to
+ *          the region, copies it into the composite and flips. When nothing changed nothing is
+ *          drawn and Game sleeps until the next step is due.
+ *          Render is called with an alpha of 1 because in-between positions are not tracked, and
+ *          dirty regions are not used while the RenderThread runs. Coordinates are back buffer
+ *          pixels.</remarks>
+ **************************************************************************************************/
+class DirtyRegions {
+public:
+
+    /**************************************************************************************************
+     * <summary>Starts tracking dirty regions on a display. The whole screen starts dirty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Call it from the thread the display is current on.</remarks>
+     * <param name="display">[in,out] If non-null, the display.</param>
+     * <returns>true if it succeeds, false if display is null or the composite could not be created.</returns>
+     **************************************************************************************************/
+    static bool Enable(ALLEGRO_DISPLAY* display);
+
+    /**************************************************************************************************
+     * <summary>Stops tracking dirty regions and frees the composite. Game draws whole frames again.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void Disable();
+
+    /**************************************************************************************************
+     * <summary>Query if dirty regions are being tracked.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if enabled, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsEnabled();
+
+    /**************************************************************************************************
+     * <summary>Marks an area to be redrawn next frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Areas off the screen are ignored.</remarks>
+     * <param name="x">     The left edge.</param>
+     * <param name="y">     The top edge.</param>
+     * <param name="width"> The width.</param>
+     * <param name="height">The height.</param>
+     **************************************************************************************************/
+    static void Invalidate(double x, double y, double width, double height);
+
+    /**************************************************************************************************
+     * <summary>Marks an area to be redrawn next frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="area">The area.</param>
+     **************************************************************************************************/
+    static void Invalidate(const a2de::Rectangle& area);
+
+    /**************************************************************************************************
+     * <summary>Marks the area something moved or changed from and the area it now covers.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="old_area">The area it covered.</param>
+     * <param name="new_area">The area it covers.</param>
+     **************************************************************************************************/
+    static void Invalidate(const a2de::Rectangle& old_area, const a2de::Rectangle& new_area);
+
+    /**************************************************************************************************
+     * <summary>Marks the whole screen to be redrawn next frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void InvalidateAll();
+
+    /**************************************************************************************************
+     * <summary>Merges the areas marked since the last frame into the region to draw this frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          If there is one, the composite is drawn onto the back buffer, which is left as the
+     *          target clipped to the region. GameWindow::StartRender clears only inside the clip
+     *          and GameWindow::EndRender does not flip until EndFrame.</remarks>
+     * <returns>true if there is anything to draw, false if nothing changed or not enabled.</returns>
+     **************************************************************************************************/
+    static bool BeginFrame();
+
+    /**************************************************************************************************
+     * <summary>Query if a region is being drawn.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if between BeginFrame and EndFrame, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsDrawingRegion();
+
+    /**************************************************************************************************
+     * <summary>Copies this frame's region into the composite, removes the clip and flips.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void EndFrame();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of regions drawn this frame, 0 or 1.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The region count.</returns>
+     **************************************************************************************************/
+    static std::size_t GetRegionCount();
+
+    /**************************************************************************************************
+     * <summary>Gets a region drawn this frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="index">Zero-based index of the region.</param>
+     * <returns>The region.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the index is past the last region.</exception>
+     **************************************************************************************************/
+    static a2de::Rectangle GetRegion(std::size_t index);
+
+private:
+    //Creation of object of type DirtyRegions is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    DirtyRegions();
+    DirtyRegions(const DirtyRegions&);
+    //NO COPYING ALLOWED!
+    DirtyRegions& operator=(const DirtyRegions&);
+    ~DirtyRegions();
+
+};
+
+A2DE_END
+
+#endif
@@ -12,6 +12,8 @@
 #include <allegro5/allegro_color.h>
 
 #include "../a2de_exceptions.h"
+#include "CRenderCommandList.h"
+#include "CDirtyRegions.h"
 
 #include <sstream>
 
@@ -84,11 +86,21 @@ void GameWindow::ShowWindow() {
 }
 
 void GameWindow::StartRender() {
+    //The render thread owns the display while a frame is recorded.
+    RenderCommandList* list = RenderCommandList::GetRecording();
+    if(list != nullptr) {
+        list->AddClear(al_get_backbuffer(_display), al_map_rgb(0, 0, 0));
+        return;
+    }
     al_set_target_backbuffer(_display);
     al_clear_to_color(al_map_rgb(0, 0, 0));
 }
 
 void GameWindow::EndRender() {
+    //The render thread flips recorded frames itself.
+    if(RenderCommandList::GetRecording() != nullptr) return;
+    //DirtyRegions::EndFrame flips once the region is copied into its composite.
+    if(DirtyRegions::IsDrawingRegion()) return;
     al_flip_display();
 }
 
@@ -0,0 +1,99 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CMappedFile.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the mapped file class.
+ **************************************************************************************************/
+#include "CMappedFile.h"
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+A2DE_BEGIN
+
+MappedFile::MappedFile() : _data(nullptr), _size(0), _mapping(nullptr) { /* DO NOTHING */ }
+
+MappedFile::MappedFile(const std::string& filename) : _data(nullptr), _size(0), _mapping(nullptr) {
+    Open(filename);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& filename) {
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER file_size;
+    HANDLE mapping = nullptr;
+    if(GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    //The mapping keeps the file open.
+    CloseHandle(file);
+    if(mapping == nullptr) return false;
+    _data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if(_data == nullptr) {
+        CloseHandle(mapping);
+        return false;
+    }
+    _mapping = mapping;
+    _size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+    int file = open(filename.c_str(), O_RDONLY);
+    if(file < 0) return false;
+    struct stat info;
+    if(fstat(file, &info) == 0 && info.st_size > 0) {
+        void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if(view != MAP_FAILED) {
+            _data = static_cast<const unsigned char*>(view);
+            _size = static_cast<std::size_t>(info.st_size);
+        }
+    }
+    //The mapping keeps the file open.
+    close(file);
+#endif
+    return _data != nullptr;
+}
+
+void MappedFile::Close() {
+    if(_data == nullptr) return;
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+    CloseHandle(static_cast<HANDLE>(_mapping));
+#else
+    munmap(const_cast<unsigned char*>(_data), _size);
+#endif
+    _data = nullptr;
+    _size = 0;
+    _mapping = nullptr;
+}
+
+bool MappedFile::IsOpen() const {
+    return _data != nullptr;
+}
+
+const unsigned char* MappedFile::GetData() const {
+    return _data;
+}
+
+std::size_t MappedFile::GetSize() const {
+    return _size;
+}
+
+A2DE_END
@@ -0,0 +1,93 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CMappedFile.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the mapped file class.
+ **************************************************************************************************/
+#ifndef A2DE_CMAPPEDFILE_H
+#define A2DE_CMAPPEDFILE_H
+
+#include "../a2de_vals.h"
+
+#include <string>
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>A read-only memory map of a whole file.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.</remarks>
+ **************************************************************************************************/
+class MappedFile {
+public:
+
+    /**************************************************************************************************
+     * <summary>Default constructor. Nothing is mapped.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    MappedFile();
+
+    /**************************************************************************************************
+     * <summary>Maps a file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the file.</param>
+     **************************************************************************************************/
+    MappedFile(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Destructor. Unmaps the file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~MappedFile();
+
+    /**************************************************************************************************
+     * <summary>Maps a file, unmapping any previous one.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the file.</param>
+     * <returns>true if it succeeds, false if the file is missing, empty or cannot be mapped.</returns>
+     **************************************************************************************************/
+    bool Open(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Unmaps the file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Close();
+
+    /**************************************************************************************************
+     * <summary>Query if a file is mapped.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if open, false if not.</returns>
+     **************************************************************************************************/
+    bool IsOpen() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the mapped bytes.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>null if nothing is mapped, else the first byte of the file.</returns>
+     **************************************************************************************************/
+    const unsigned char* GetData() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the size of the mapped file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The size in bytes.</returns>
+     **************************************************************************************************/
+    std::size_t GetSize() const;
+
+protected:
+private:
+    /// <summary> The mapped bytes.</summary>
+    const unsigned char* _data;
+    /// <summary> The size of the mapping.</summary>
+    std::size_t _size;
+    /// <summary> The platform's mapping handle, if it has one.</summary>
+    void* _mapping;
+
+    MappedFile(const MappedFile& other);
+    MappedFile& operator=(const MappedFile& rhs);
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,300 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CParticleEmitter.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the particle emitter class.
+ **************************************************************************************************/
+#include "CParticleEmitter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <allegro5/allegro.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define A2DE_PARTICLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include "CRenderCommandList.h"
+
+A2DE_BEGIN
+
+namespace {
+
+    /// <summary> Particles are integrated this many at a time.</summary>
+    const std::size_t LANES = 4;
+
+    /// <summary> The most particles in one draw, so its 65,532 vertices keep indices within 16 bits.</summary>
+    const std::size_t MAX_DRAW_PARTICLES = 16383;
+
+    std::size_t RoundUpToLanes(std::size_t count) {
+        return (count + LANES - 1) / LANES * LANES;
+    }
+
+}
+
+ParticleEmitter::ParticleEmitter(const ParticleEmitterDef& definition)
+    : IUpdatable(),
+    IDrawable(),
+    _definition(definition),
+    _count(0),
+    _stride(RoundUpToLanes(definition.max_particles)),
+    _attributes(_stride * ATTRIBUTE_COUNT, 0.0f),
+    _emission_debt(0.0),
+    _random_state(1),
+    _vertices(),
+    _indices() {
+    _vertices.reserve(_definition.max_particles * 4);
+    //Every draw starts its vertices at zero, so one draw's worth of indices serves them all.
+    std::size_t indexed_particles = std::min(_definition.max_particles, MAX_DRAW_PARTICLES);
+    _indices.reserve(indexed_particles * 6);
+    for(std::size_t i = 0; i < indexed_particles; ++i) {
+        int corner = static_cast<int>(i * 4);
+        _indices.push_back(corner);
+        _indices.push_back(corner + 1);
+        _indices.push_back(corner + 2);
+        _indices.push_back(corner);
+        _indices.push_back(corner + 2);
+        _indices.push_back(corner + 3);
+    }
+}
+
+ParticleEmitter::ParticleEmitter(const ParticleEmitter& other)
+    : IUpdatable(other),
+    IDrawable(other),
+    _definition(other._definition),
+    _count(other._count),
+    _stride(other._stride),
+    _attributes(other._attributes),
+    _emission_debt(other._emission_debt),
+    _random_state(other._random_state),
+    _vertices(),
+    _indices(other._indices) {
+    /* DO NOTHING */
+}
+
+ParticleEmitter::~ParticleEmitter() {
+    /* DO NOTHING */
+}
+
+ParticleEmitter& ParticleEmitter::operator=(const ParticleEmitter& rhs) {
+    if(this == &rhs) return *this;
+    IDrawable::operator=(rhs);
+    this->_definition = rhs._definition;
+    this->_count = rhs._count;
+    this->_stride = rhs._stride;
+    this->_attributes = rhs._attributes;
+    this->_emission_debt = rhs._emission_debt;
+    this->_random_state = rhs._random_state;
+    this->_vertices.clear();
+    this->_indices = rhs._indices;
+    return *this;
+}
+
+float* ParticleEmitter::GetAttribute(ATTRIBUTE attribute) {
+    return &_attributes[attribute * _stride];
+}
+
+void ParticleEmitter::Update(double deltaTime) {
+    if(deltaTime <= 0.0) return;
+    if(_count != 0) {
+        Integrate(static_cast<float>(deltaTime));
+        Compact();
+    }
+
+    //New particles start where the emitter is and move from the next frame on.
+    if(_definition.emission_rate <= 0.0) return;
+    _emission_debt += _definition.emission_rate * deltaTime;
+    double whole = std::floor(_emission_debt);
+    _emission_debt -= whole;
+    Emit(static_cast<std::size_t>(whole));
+}
+
+void ParticleEmitter::Integrate(float deltaTime) {
+    float* x = GetAttribute(ATTRIBUTE_X);
+    float* y = GetAttribute(ATTRIBUTE_Y);
+    float* velocity_x = GetAttribute(ATTRIBUTE_VELOCITY_X);
+    float* velocity_y = GetAttribute(ATTRIBUTE_VELOCITY_Y);
+    float* color[4] = { GetAttribute(ATTRIBUTE_RED), GetAttribute(ATTRIBUTE_GREEN), GetAttribute(ATTRIBUTE_BLUE), GetAttribute(ATTRIBUTE_ALPHA) };
+    float* delta_color[4] = { GetAttribute(ATTRIBUTE_DELTA_RED), GetAttribute(ATTRIBUTE_DELTA_GREEN), GetAttribute(ATTRIBUTE_DELTA_BLUE), GetAttribute(ATTRIBUTE_DELTA_ALPHA) };
+    float* life = GetAttribute(ATTRIBUTE_LIFE);
+    float delta_velocity_x = static_cast<float>(_definition.acceleration_x) * deltaTime;
+    float delta_velocity_y = static_cast<float>(_definition.acceleration_y) * deltaTime;
+
+    //The arrays are padded to whole groups, so the last group may run past the live particles.
+    std::size_t end = RoundUpToLanes(_count);
+#ifdef A2DE_PARTICLE_SSE2
+    const __m128 step = _mm_set1_ps(deltaTime);
+    const __m128 step_x = _mm_set1_ps(delta_velocity_x);
+    const __m128 step_y = _mm_set1_ps(delta_velocity_y);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for(std::size_t i = 0; i < end; i += LANES) {
+        __m128 vx = _mm_add_ps(_mm_loadu_ps(velocity_x + i), step_x);
+        __m128 vy = _mm_add_ps(_mm_loadu_ps(velocity_y + i), step_y);
+        _mm_storeu_ps(velocity_x + i, vx);
+        _mm_storeu_ps(velocity_y + i, vy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(vx, step)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(vy, step)));
+        for(int channel = 0; channel < 4; ++channel) {
+            __m128 value = _mm_add_ps(_mm_loadu_ps(color[channel] + i), _mm_mul_ps(_mm_loadu_ps(delta_color[channel] + i), step));
+            _mm_storeu_ps(color[channel] + i, _mm_min_ps(_mm_max_ps(value, zero), one));
+        }
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), step));
+    }
+#else
+    for(std::size_t i = 0; i < end; ++i) {
+        velocity_x[i] += delta_velocity_x;
+        velocity_y[i] += delta_velocity_y;
+        x[i] += velocity_x[i] * deltaTime;
+        y[i] += velocity_y[i] * deltaTime;
+        for(int channel = 0; channel < 4; ++channel) {
+            float value = color[channel][i] + delta_color[channel][i] * deltaTime;
+            color[channel][i] = std::min(std::max(value, 0.0f), 1.0f);
+        }
+        life[i] -= deltaTime;
+    }
+#endif
+}
+
+void ParticleEmitter::Compact() {
+    const float* life = GetAttribute(ATTRIBUTE_LIFE);
+    std::size_t i = 0;
+    while(i < _count) {
+        if(life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        //The moved particle lands on i and is checked next.
+        --_count;
+        if(i == _count) break;
+        for(std::size_t attribute = 0; attribute < ATTRIBUTE_COUNT; ++attribute) {
+            _attributes[attribute * _stride + i] = _attributes[attribute * _stride + _count];
+        }
+    }
+}
+
+std::size_t ParticleEmitter::Emit(std::size_t count) {
+    count = std::min(count, _definition.max_particles - _count);
+    const ALLEGRO_COLOR& start = _definition.start_color;
+    const ALLEGRO_COLOR& end = _definition.end_color;
+    for(std::size_t k = 0; k < count; ++k) {
+        std::size_t i = _count++;
+        double angle = _definition.angle + GetRandom(-_definition.angle_spread, _definition.angle_spread);
+        double speed = GetRandom(_definition.speed_min, _definition.speed_max);
+        //A particle with no life is still drawn once, then removed by the next Update.
+        float life = static_cast<float>(GetRandom(_definition.life_min, _definition.life_max));
+        float inverse_life = life > 0.0f ? 1.0f / life : 0.0f;
+        GetAttribute(ATTRIBUTE_X)[i] = static_cast<float>(_definition.position_x + GetRandom(-_definition.spread_x, _definition.spread_x));
+        GetAttribute(ATTRIBUTE_Y)[i] = static_cast<float>(_definition.position_y + GetRandom(-_definition.spread_y, _definition.spread_y));
+        GetAttribute(ATTRIBUTE_VELOCITY_X)[i] = static_cast<float>(std::cos(angle) * speed);
+        GetAttribute(ATTRIBUTE_VELOCITY_Y)[i] = static_cast<float>(std::sin(angle) * speed);
+        GetAttribute(ATTRIBUTE_RED)[i] = start.r;
+        GetAttribute(ATTRIBUTE_GREEN)[i] = start.g;
+        GetAttribute(ATTRIBUTE_BLUE)[i] = start.b;
+        GetAttribute(ATTRIBUTE_ALPHA)[i] = start.a;
+        GetAttribute(ATTRIBUTE_DELTA_RED)[i] = (end.r - start.r) * inverse_life;
+        GetAttribute(ATTRIBUTE_DELTA_GREEN)[i] = (end.g - start.g) * inverse_life;
+        GetAttribute(ATTRIBUTE_DELTA_BLUE)[i] = (end.b - start.b) * inverse_life;
+        GetAttribute(ATTRIBUTE_DELTA_ALPHA)[i] = (end.a - start.a) * inverse_life;
+        GetAttribute(ATTRIBUTE_LIFE)[i] = life;
+    }
+    return count;
+}
+
+void ParticleEmitter::Draw(ALLEGRO_BITMAP* dest) {
+    if(dest == nullptr || _count == 0) return;
+
+    const float* x = GetAttribute(ATTRIBUTE_X);
+    const float* y = GetAttribute(ATTRIBUTE_Y);
+    const float* red = GetAttribute(ATTRIBUTE_RED);
+    const float* green = GetAttribute(ATTRIBUTE_GREEN);
+    const float* blue = GetAttribute(ATTRIBUTE_BLUE);
+    const float* alpha = GetAttribute(ATTRIBUTE_ALPHA);
+    float half_size = static_cast<float>(_definition.size) * 0.5f;
+    _vertices.resize(_count * 4);
+    for(std::size_t i = 0; i < _count; ++i) {
+        ALLEGRO_COLOR color;
+        color.r = red[i];
+        color.g = green[i];
+        color.b = blue[i];
+        color.a = alpha[i];
+        float left = x[i] - half_size;
+        float top = y[i] - half_size;
+        float right = x[i] + half_size;
+        float bottom = y[i] + half_size;
+        ALLEGRO_VERTEX* corners = &_vertices[i * 4];
+        corners[0].x = left;
+        corners[0].y = top;
+        corners[1].x = right;
+        corners[1].y = top;
+        corners[2].x = right;
+        corners[2].y = bottom;
+        corners[3].x = left;
+        corners[3].y = bottom;
+        for(int corner = 0; corner < 4; ++corner) {
+            corners[corner].z = 0.0f;
+            corners[corner].u = 0.0f;
+            corners[corner].v = 0.0f;
+            corners[corner].color = color;
+        }
+    }
+
+    RenderCommandList* list = RenderCommandList::GetRecording();
+    if(list != nullptr) {
+        for(std::size_t first = 0; first < _count; first += MAX_DRAW_PARTICLES) {
+            std::size_t particles = std::min(_count - first, MAX_DRAW_PARTICLES);
+            list->AddPrimitives(dest, &_vertices[first * 4], particles * 4, &_indices[0], particles * 6, ALLEGRO_PRIM_TRIANGLE_LIST);
+        }
+        return;
+    }
+
+    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
+    if(old_target != dest) al_set_target_bitmap(dest);
+    for(std::size_t first = 0; first < _count; first += MAX_DRAW_PARTICLES) {
+        std::size_t particles = std::min(_count - first, MAX_DRAW_PARTICLES);
+        al_draw_indexed_prim(&_vertices[first * 4], nullptr, nullptr, &_indices[0], static_cast<int>(particles * 6), ALLEGRO_PRIM_TRIANGLE_LIST);
+    }
+    if(old_target != dest) al_set_target_bitmap(old_target);
+}
+
+void ParticleEmitter::Clear() {
+    _count = 0;
+    _emission_debt = 0.0;
+}
+
+void ParticleEmitter::SetPosition(double x, double y) {
+    _definition.position_x = x;
+    _definition.position_y = y;
+}
+
+void ParticleEmitter::SetEmissionRate(double rate) {
+    _definition.emission_rate = rate;
+}
+
+const ParticleEmitterDef& ParticleEmitter::GetDefinition() const {
+    return _definition;
+}
+
+void ParticleEmitter::SetSeed(unsigned long seed) {
+    _random_state = seed;
+}
+
+std::size_t ParticleEmitter::GetCount() const {
+    return _count;
+}
+
+std::size_t ParticleEmitter::GetCapacity() const {
+    return _definition.max_particles;
+}
+
+double ParticleEmitter::GetRandom(double low, double high) {
+    //The same generator as rand() on most C libraries, kept per emitter so runs repeat.
+    _random_state = (_random_state * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+    double unit = static_cast<double>((_random_state >> 8) & 0xFFFFFFUL) / 16777216.0;
+    return low + (high - low) * unit;
+}
+
+A2DE_END
@@ -0,0 +1,249 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CParticleEmitter.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the particle emitter class.
+ **************************************************************************************************/
+#ifndef A2DE_CPARTICLEEMITTER_H
+#define A2DE_CPARTICLEEMITTER_H
+
+#include "../a2de_vals.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <allegro5/allegro_primitives.h>
+
+#include "IDrawable.h"
+#include "../Physics/IUpdatable.h"
+
+A2DE_BEGIN
+
+struct ParticleEmitterDef {
+    ParticleEmitterDef() : max_particles(1024),
+                           emission_rate(0.0),
+                           position_x(0.0),
+                           position_y(0.0),
+                           spread_x(0.0),
+                           spread_y(0.0),
+                           angle(0.0),
+                           angle_spread(0.0),
+                           speed_min(0.0),
+                           speed_max(0.0),
+                           acceleration_x(0.0),
+                           acceleration_y(0.0),
+                           life_min(1.0),
+                           life_max(1.0),
+                           size(1.0),
+                           start_color(al_map_rgba_f(1.0f, 1.0f, 1.0f, 1.0f)),
+                           end_color(al_map_rgba_f(0.0f, 0.0f, 0.0f, 0.0f)) {
+        /* DO NOTHING */
+    }
+    std::size_t max_particles;
+    double emission_rate;
+    double position_x;
+    double position_y;
+    double spread_x;
+    double spread_y;
+    double angle;
+    double angle_spread;
+    double speed_min;
+    double speed_max;
+    double acceleration_x;
+    double acceleration_y;
+    double life_min;
+    double life_max;
+    double size;
+    ALLEGRO_COLOR start_color;
+    ALLEGRO_COLOR end_color;
+};
+
+/**************************************************************************************************
+ * <summary>Spawns, moves and draws many short-lived colored squares without Objects or RigidBodies.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Each value of a particle is kept in its own array, so Update integrates position,
+ *          velocity, color and life four particles at a time with SSE2. Dead particles are
+ *          replaced by the last live one, so the live ones stay packed at the front and their
+ *          order is not kept. Draw submits the particles in indexed draws of up to 16,383, the most
+ *          whose vertices 16-bit indices can reach. Coordinates are in
+ *          pixels, speeds in pixels per second and angles in radians. Colors fade linearly from
+ *          the start color to the end color over each particle's life and are blended with the
+ *          target's blender, so give them premultiplied for the default one.</remarks>
+ **************************************************************************************************/
+class ParticleEmitter : public IUpdatable, public IDrawable {
+public:
+
+    /**************************************************************************************************
+     * <summary>Constructor. Allocates room for the definition's max_particles.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="definition">The definition.</param>
+     **************************************************************************************************/
+    ParticleEmitter(const ParticleEmitterDef& definition);
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    ParticleEmitter(const ParticleEmitter& other);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    virtual ~ParticleEmitter();
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A deep copy of this object.</returns>
+     **************************************************************************************************/
+    ParticleEmitter& operator=(const ParticleEmitter& rhs);
+
+    /**************************************************************************************************
+     * <summary>Spawns particles at the current emission rate, moves the live ones and removes the dead.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    virtual void Update(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Draws every live particle, 16,383 to a call.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Recorded instead when a RenderCommandList is recording.</remarks>
+     * <param name="dest">[in,out] If non-null, the destination bitmap.</param>
+     **************************************************************************************************/
+    virtual void Draw(ALLEGRO_BITMAP* dest);
+
+    /**************************************************************************************************
+     * <summary>Spawns particles at once, as for a burst.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="count">The number to spawn.</param>
+     * <returns>The number spawned, fewer than count when the emitter is full.</returns>
+     **************************************************************************************************/
+    std::size_t Emit(std::size_t count);
+
+    /**************************************************************************************************
+     * <summary>Removes every particle.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Moves where new particles spawn. Live particles stay where they are.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="x">The x coordinate.</param>
+     * <param name="y">The y coordinate.</param>
+     **************************************************************************************************/
+    void SetPosition(double x, double y);
+
+    /**************************************************************************************************
+     * <summary>Sets the number of particles spawned per second by Update.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rate">The rate. Zero or less stops emitting.</param>
+     **************************************************************************************************/
+    void SetEmissionRate(double rate);
+
+    /**************************************************************************************************
+     * <summary>Gets the definition new particles are spawned from.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The definition.</returns>
+     **************************************************************************************************/
+    const ParticleEmitterDef& GetDefinition() const;
+
+    /**************************************************************************************************
+     * <summary>Seeds the generator that spreads new particles, so a run can be repeated.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="seed">The seed.</param>
+     **************************************************************************************************/
+    void SetSeed(unsigned long seed);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of live particles.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The count.</returns>
+     **************************************************************************************************/
+    std::size_t GetCount() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the most particles that can be alive at once.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The capacity.</returns>
+     **************************************************************************************************/
+    std::size_t GetCapacity() const;
+
+protected:
+private:
+
+    /// <summary> The values kept for each particle, one array each.</summary>
+    enum ATTRIBUTE {
+        ATTRIBUTE_X,
+        ATTRIBUTE_Y,
+        ATTRIBUTE_VELOCITY_X,
+        ATTRIBUTE_VELOCITY_Y,
+        ATTRIBUTE_RED,
+        ATTRIBUTE_GREEN,
+        ATTRIBUTE_BLUE,
+        ATTRIBUTE_ALPHA,
+        ATTRIBUTE_DELTA_RED,
+        ATTRIBUTE_DELTA_GREEN,
+        ATTRIBUTE_DELTA_BLUE,
+        ATTRIBUTE_DELTA_ALPHA,
+        ATTRIBUTE_LIFE,
+        ATTRIBUTE_COUNT
+    };
+
+    /**************************************************************************************************
+     * <summary>Gets the array of one value.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="attribute">The value.</param>
+     * <returns>The first element of the array.</returns>
+     **************************************************************************************************/
+    float* GetAttribute(ATTRIBUTE attribute);
+
+    /**************************************************************************************************
+     * <summary>Advances position, velocity, color and life of every live particle.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void Integrate(float deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Removes particles whose life has run out by moving the last live one into their place.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Compact();
+
+    /**************************************************************************************************
+     * <summary>Gets a pseudo-random value in a range.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="low"> The lowest value.</param>
+     * <param name="high">The highest value.</param>
+     * <returns>A value from low up to, but not including, high.</returns>
+     **************************************************************************************************/
+    double GetRandom(double low, double high);
+
+    /// <summary> The definition new particles are spawned from.</summary>
+    ParticleEmitterDef _definition;
+    /// <summary> The number of live particles.</summary>
+    std::size_t _count;
+    /// <summary> The length of each array, the capacity rounded up to a multiple of four.</summary>
+    std::size_t _stride;
+    /// <summary> The arrays, one after another.</summary>
+    std::vector<float> _attributes;
+    /// <summary> The particles Update owes for fractions of a particle at the emission rate.</summary>
+    double _emission_debt;
+    /// <summary> The generator's state.</summary>
+    unsigned long _random_state;
+    /// <summary> The corners of every live particle, rebuilt by each Draw.</summary>
+    std::vector<ALLEGRO_VERTEX> _vertices;
+    /// <summary> Two triangles for every particle one draw can hold.</summary>
+    std::vector<int> _indices;
+
+};
+
+A2DE_END
+
+#endif
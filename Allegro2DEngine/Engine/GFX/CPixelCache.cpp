@@ -0,0 +1,218 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CPixelCache.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the pixel cache class.
+ **************************************************************************************************/
+#include "CPixelCache.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_image.h>
+
+#include "CMappedFile.h"
+
+A2DE_BEGIN
+
+namespace {
+
+    /// <summary> Identifies a cache file.</summary>
+    const char MAGIC[4] = { 'A', '2', 'P', 'X' };
+    /// <summary> Bumped whenever the layout changes so old files are rewritten.</summary>
+    const unsigned int VERSION = 1;
+    /// <summary> The source path and the pixels start on multiples of this.</summary>
+    const unsigned int ALIGNMENT = 64;
+
+    /**************************************************************************************************
+     * <summary>The start of a cache file. The source path follows it, then the pixel rows, top first and tightly packed.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct FileHeader {
+        char magic[4];
+        unsigned int version;
+        unsigned int width;
+        unsigned int height;
+        unsigned long long source_mtime;
+        unsigned long long source_size;
+        unsigned int path_length;
+        unsigned int pixel_offset;
+        char reserved[24];
+    };
+
+    unsigned int AlignUp(unsigned int value) {
+        return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    unsigned long long HashPath(const std::string& path) {
+        //FNV-1a.
+        unsigned long long hash = 14695981039346656037ULL;
+        for(std::string::const_iterator _iter = path.begin(); _iter != path.end(); ++_iter) {
+            hash ^= static_cast<unsigned char>(*_iter);
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    bool GetSourceInfo(const std::string& filename, unsigned long long& mtime, unsigned long long& size) {
+        ALLEGRO_FS_ENTRY* entry = al_create_fs_entry(filename.c_str());
+        if(entry == nullptr) return false;
+        bool exists = al_fs_entry_exists(entry);
+        if(exists) {
+            mtime = static_cast<unsigned long long>(al_get_fs_entry_mtime(entry));
+            size = static_cast<unsigned long long>(al_get_fs_entry_size(entry));
+        }
+        al_destroy_fs_entry(entry);
+        return exists;
+    }
+
+}
+
+std::string PixelCache::_directory;
+
+bool PixelCache::SetDirectory(const std::string& path) {
+    _directory = path;
+    while(_directory.empty() == false && (*_directory.rbegin() == '/' || *_directory.rbegin() == '\\')) {
+        _directory.erase(_directory.size() - 1);
+    }
+    if(_directory.empty()) return false;
+    if(al_filename_exists(_directory.c_str()) == false && al_make_directory(_directory.c_str()) == false) {
+        _directory.clear();
+        return false;
+    }
+    return true;
+}
+
+const std::string& PixelCache::GetDirectory() {
+    return _directory;
+}
+
+bool PixelCache::IsEnabled() {
+    return _directory.empty() == false;
+}
+
+std::string PixelCache::GetCachePath(const std::string& filename) {
+    if(IsEnabled() == false) return std::string();
+    char name[32];
+    std::sprintf(name, "/%016llx.a2px", HashPath(filename));
+    return _directory + name;
+}
+
+ALLEGRO_BITMAP* PixelCache::Load(const std::string& filename) {
+    if(IsEnabled() == false) return al_load_bitmap(filename.c_str());
+
+    unsigned long long mtime = 0;
+    unsigned long long size = 0;
+    if(GetSourceInfo(filename, mtime, size) == false) return nullptr;
+
+    {
+        MappedFile file(GetCachePath(filename));
+        const unsigned char* data = file.GetData();
+        const FileHeader* header = reinterpret_cast<const FileHeader*>(data);
+        bool valid = data != nullptr && file.GetSize() >= sizeof(FileHeader);
+        valid = valid && std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION;
+        valid = valid && header->source_mtime == mtime && header->source_size == size;
+        valid = valid && header->width > 0 && header->height > 0;
+        valid = valid && header->path_length == filename.size() && sizeof(FileHeader) + header->path_length <= file.GetSize();
+        //Two paths can share a hash; the stored path settles it.
+        valid = valid && std::memcmp(data + sizeof(FileHeader), filename.data(), filename.size()) == 0;
+        std::size_t row_bytes = valid ? static_cast<std::size_t>(header->width) * 4 : 0;
+        valid = valid && header->pixel_offset + row_bytes * header->height <= file.GetSize();
+
+        if(valid) {
+            ALLEGRO_BITMAP* bmp = al_create_bitmap(header->width, header->height);
+            if(bmp == nullptr) return nullptr;
+            ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bmp, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_WRITEONLY);
+            if(region != nullptr) {
+                const unsigned char* source = data + header->pixel_offset;
+                unsigned char* dest = static_cast<unsigned char*>(region->data);
+                if(region->pitch == static_cast<int>(row_bytes)) {
+                    std::memcpy(dest, source, row_bytes * header->height);
+                } else {
+                    for(unsigned int y = 0; y < header->height; ++y) {
+                        std::memcpy(dest + y * region->pitch, source + y * row_bytes, row_bytes);
+                    }
+                }
+                al_unlock_bitmap(bmp);
+                return bmp;
+            }
+            al_destroy_bitmap(bmp);
+        }
+    }
+
+    //Stale or missing: decode and refresh the cache file for next time.
+    ALLEGRO_BITMAP* bmp = al_load_bitmap(filename.c_str());
+    if(bmp != nullptr) Store(filename, bmp);
+    return bmp;
+}
+
+bool PixelCache::Store(const std::string& filename, ALLEGRO_BITMAP* bmp) {
+    if(IsEnabled() == false || bmp == nullptr) return false;
+
+    unsigned long long mtime = 0;
+    unsigned long long size = 0;
+    if(GetSourceInfo(filename, mtime, size) == false) return false;
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.width = al_get_bitmap_width(bmp);
+    header.height = al_get_bitmap_height(bmp);
+    header.source_mtime = mtime;
+    header.source_size = size;
+    header.path_length = static_cast<unsigned int>(filename.size());
+    header.pixel_offset = AlignUp(static_cast<unsigned int>(sizeof(FileHeader)) + header.path_length);
+
+    //Locking in a fixed format converts from whatever the bitmap uses. Pixels are already premultiplied by the loader.
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bmp, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+    if(region == nullptr) return false;
+
+    //Write beside the real file and swap it in, so a reader never maps a half-written file.
+    std::string path = GetCachePath(filename);
+    std::string temp_path = path + ".tmp";
+    ALLEGRO_FILE* file = al_fopen(temp_path.c_str(), "wb");
+    bool written = file != nullptr;
+    if(written) {
+        std::size_t row_bytes = static_cast<std::size_t>(header.width) * 4;
+        char padding[ALIGNMENT] = { 0 };
+        std::size_t padding_size = header.pixel_offset - sizeof(FileHeader) - header.path_length;
+        written = al_fwrite(file, &header, sizeof(header)) == sizeof(header);
+        written = written && al_fwrite(file, filename.data(), filename.size()) == filename.size();
+        written = written && al_fwrite(file, padding, padding_size) == padding_size;
+        const unsigned char* source = static_cast<const unsigned char*>(region->data);
+        for(unsigned int y = 0; written && y < header.height; ++y) {
+            written = al_fwrite(file, source + y * region->pitch, row_bytes) == row_bytes;
+        }
+        written = written && al_ferror(file) == false;
+        al_fclose(file);
+    }
+    al_unlock_bitmap(bmp);
+
+    if(written) {
+        std::remove(path.c_str());
+        written = std::rename(temp_path.c_str(), path.c_str()) == 0;
+    }
+    if(written == false) std::remove(temp_path.c_str());
+    return written;
+}
+
+bool PixelCache::Contains(const std::string& filename) {
+    if(IsEnabled() == false) return false;
+
+    unsigned long long mtime = 0;
+    unsigned long long size = 0;
+    if(GetSourceInfo(filename, mtime, size) == false) return false;
+
+    MappedFile file(GetCachePath(filename));
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(file.GetData());
+    if(header == nullptr || file.GetSize() < sizeof(FileHeader) + filename.size()) return false;
+    return std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 && header->version == VERSION
+        && header->source_mtime == mtime && header->source_size == size
+        && header->path_length == filename.size()
+        && std::memcmp(file.GetData() + sizeof(FileHeader), filename.data(), filename.size()) == 0;
+}
+
+A2DE_END
@@ -0,0 +1,108 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CPixelCache.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the pixel cache class.
+ **************************************************************************************************/
+#ifndef A2DE_CPIXELCACHE_H
+#define A2DE_CPIXELCACHE_H
+
+#include "../a2de_vals.h"
+
+#include <string>
+
+struct ALLEGRO_BITMAP;
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Keeps decoded images on disk so later runs skip the image decoders.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Each image is stored as one file of raw, premultiplied 32-bit RGBA rows named after a
+ *          hash of its path. The file records the source's path, modification time and size; if
+ *          any of them differ the file is ignored and rewritten from a fresh decode. Cache files
+ *          are memory-mapped and copied straight into the new bitmap. BitmapCache loads through
+ *          here, including on its loader threads, once a directory is set.</remarks>
+ **************************************************************************************************/
+class PixelCache {
+public:
+
+    /**************************************************************************************************
+     * <summary>Sets the directory the cache files live in, creating it if needed.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Call before loading starts; the directory is not guarded against loader
+     *          threads.</remarks>
+     * <param name="path">The directory, or empty to disable the cache.</param>
+     * <returns>true if the cache is enabled, false if it is disabled or the directory could not be created.</returns>
+     **************************************************************************************************/
+    static bool SetDirectory(const std::string& path);
+
+    /**************************************************************************************************
+     * <summary>Gets the directory.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The directory, or empty if the cache is disabled.</returns>
+     **************************************************************************************************/
+    static const std::string& GetDirectory();
+
+    /**************************************************************************************************
+     * <summary>Query if the cache is enabled.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if enabled, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsEnabled();
+
+    /**************************************************************************************************
+     * <summary>Loads an image from its cache file, or decodes it and writes the cache file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The bitmap is created with the calling thread's new bitmap flags. When the cache is
+     *          disabled this is al_load_bitmap.</remarks>
+     * <param name="filename">Path and Filename of the image.</param>
+     * <returns>null if it fails, else the bitmap. The caller owns it.</returns>
+     **************************************************************************************************/
+    static ALLEGRO_BITMAP* Load(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Writes a bitmap's pixels as the cache file for an image.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the source image.</param>
+     * <param name="bmp">     The decoded image.</param>
+     * <returns>true if it succeeds, false if the cache is disabled or the file could not be written.</returns>
+     **************************************************************************************************/
+    static bool Store(const std::string& filename, ALLEGRO_BITMAP* bmp);
+
+    /**************************************************************************************************
+     * <summary>Query if an image has an up-to-date cache file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the source image.</param>
+     * <returns>true if it does, false if not.</returns>
+     **************************************************************************************************/
+    static bool Contains(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Gets the path of the cache file for an image.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the source image.</param>
+     * <returns>The path, or empty if the cache is disabled.</returns>
+     **************************************************************************************************/
+    static std::string GetCachePath(const std::string& filename);
+
+protected:
+private:
+
+    /// <summary> The directory, or empty when disabled.</summary>
+    static std::string _directory;
+
+    //Creation of object of type PixelCache is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    PixelCache();
+    PixelCache(const PixelCache&);
+    //NO COPYING ALLOWED!
+    PixelCache& operator=(const PixelCache&);
+    ~PixelCache();
+};
+
+A2DE_END
+
+#endif
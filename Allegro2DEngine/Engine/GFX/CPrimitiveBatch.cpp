@@ -0,0 +1,295 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CPrimitiveBatch.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the primitive batch class.
+ **************************************************************************************************/
+#include "CPrimitiveBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_primitives.h>
+
+#include "../Math/MathConstants.h"
+
+#include "CRenderCommandList.h"
+
+A2DE_BEGIN
+
+/************************************************************************/
+/* DO NOT DEFINE CONSTRUCTORS, DESTRUCTOR, ASSIGNMENT OPERATOR!         */
+/************************************************************************/
+
+namespace {
+
+    /// <summary> The farthest, in pixels, a segment may stray from the curve it stands in for.</summary>
+    const double TOLERANCE = 0.25;
+    /// <summary> The fewest segments in a full circle, however small.</summary>
+    const int MIN_SEGMENTS = 8;
+    /// <summary> The most segments in one curve, however large.</summary>
+    const int MAX_SEGMENTS = 512;
+    /// <summary> A batch is submitted before it grows past this many vertices, so indices stay within 16 bits.</summary>
+    const std::size_t MAX_VERTICES = 65535;
+
+    /// <summary> Tessellated shapes waiting to be submitted in one draw.</summary>
+    struct Buffer {
+        ALLEGRO_BITMAP* dest;
+        ALLEGRO_PRIM_TYPE type;
+        std::vector<ALLEGRO_VERTEX> vertices;
+        std::vector<int> indices;
+    };
+
+    /// <summary> The shapes collected between BeginBatch and EndBatch.</summary>
+    Buffer batch;
+    /// <summary> The shape being drawn at once.</summary>
+    Buffer immediate;
+    /// <summary> true between BeginBatch and EndBatch.</summary>
+    bool batching = false;
+    /// <summary> The draws the current batch has submitted.</summary>
+    std::size_t batch_draws = 0;
+
+    std::size_t Submit(Buffer& buffer) {
+        if(buffer.indices.empty()) return 0;
+
+        a2de::RenderCommandList* list = a2de::RenderCommandList::GetRecording();
+        if(list != nullptr) {
+            list->AddPrimitives(buffer.dest, &buffer.vertices[0], buffer.vertices.size(), &buffer.indices[0], buffer.indices.size(), buffer.type);
+            buffer.vertices.clear();
+            buffer.indices.clear();
+            return 1;
+        }
+
+        ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
+        if(old_target != buffer.dest) al_set_target_bitmap(buffer.dest);
+        al_draw_indexed_prim(&buffer.vertices[0], nullptr, nullptr, &buffer.indices[0], static_cast<int>(buffer.indices.size()), buffer.type);
+        if(old_target != buffer.dest) al_set_target_bitmap(old_target);
+
+        buffer.vertices.clear();
+        buffer.indices.clear();
+        return 1;
+    }
+
+    Buffer& Open(ALLEGRO_BITMAP* dest, ALLEGRO_PRIM_TYPE type, std::size_t vertex_count) {
+        if(batching && dest == batch.dest) {
+            if(batch.type != type || batch.vertices.size() + vertex_count > MAX_VERTICES) batch_draws += Submit(batch);
+            batch.type = type;
+            return batch;
+        }
+        immediate.dest = dest;
+        immediate.type = type;
+        return immediate;
+    }
+
+    void Close(Buffer& buffer) {
+        if(&buffer == &immediate) Submit(immediate);
+    }
+
+    int AddVertex(Buffer& buffer, double x, double y, const ALLEGRO_COLOR& color) {
+        ALLEGRO_VERTEX vertex;
+        vertex.x = static_cast<float>(x);
+        vertex.y = static_cast<float>(y);
+        vertex.z = 0.0f;
+        vertex.u = 0.0f;
+        vertex.v = 0.0f;
+        vertex.color = color;
+        buffer.vertices.push_back(vertex);
+        return static_cast<int>(buffer.vertices.size() - 1);
+    }
+
+    int AddVertices(Buffer& buffer, const float* xy, std::size_t count, const ALLEGRO_COLOR& color) {
+        int first = static_cast<int>(buffer.vertices.size());
+        for(std::size_t i = 0; i < count; ++i) {
+            AddVertex(buffer, xy[i * 2], xy[i * 2 + 1], color);
+        }
+        return first;
+    }
+
+    int AddEllipsePoints(Buffer& buffer, double cx, double cy, double rx, double ry, double start_theta, double delta_theta, int segments, int point_count, const ALLEGRO_COLOR& color) {
+        int first = static_cast<int>(buffer.vertices.size());
+        double step = delta_theta / segments;
+        for(int i = 0; i < point_count; ++i) {
+            double theta = start_theta + step * i;
+            AddVertex(buffer, cx + rx * std::cos(theta), cy + ry * std::sin(theta), color);
+        }
+        return first;
+    }
+
+    void AddLineStrip(Buffer& buffer, int first, int count) {
+        for(int i = 0; i + 1 < count; ++i) {
+            buffer.indices.push_back(first + i);
+            buffer.indices.push_back(first + i + 1);
+        }
+    }
+
+    void AddLineLoop(Buffer& buffer, int first, int count) {
+        AddLineStrip(buffer, first, count);
+        if(count < 3) return;
+        buffer.indices.push_back(first + count - 1);
+        buffer.indices.push_back(first);
+    }
+
+    void AddTriangleFan(Buffer& buffer, int hub, int first, int count, bool closed) {
+        for(int i = 0; i + 1 < count; ++i) {
+            buffer.indices.push_back(hub);
+            buffer.indices.push_back(first + i);
+            buffer.indices.push_back(first + i + 1);
+        }
+        if(closed == false || count < 3) return;
+        buffer.indices.push_back(hub);
+        buffer.indices.push_back(first + count - 1);
+        buffer.indices.push_back(first);
+    }
+
+    int GetSegments(double radius, double delta_theta) {
+        radius = std::fabs(radius);
+        double sweep = std::fabs(delta_theta);
+        double fraction = std::min(sweep / (2.0 * Math::A2DE_PI), 1.0);
+        int least = std::max(1, static_cast<int>(std::ceil(MIN_SEGMENTS * fraction)));
+        if(radius <= TOLERANCE) return least;
+        //Each segment may turn through the angle whose chord sags TOLERANCE below the curve.
+        double step = 2.0 * std::acos(1.0 - TOLERANCE / radius);
+        double segments = std::ceil(sweep / step);
+        if(segments > MAX_SEGMENTS) return MAX_SEGMENTS;
+        return std::max(least, static_cast<int>(segments));
+    }
+
+}
+
+bool PrimitiveBatch::BeginBatch(ALLEGRO_BITMAP* dest) {
+    if(dest == nullptr || batching) return false;
+    batching = true;
+    batch.dest = dest;
+    batch.vertices.clear();
+    batch.indices.clear();
+    batch_draws = 0;
+    return true;
+}
+
+std::size_t PrimitiveBatch::EndBatch() {
+    if(batching == false) return 0;
+    batch_draws += Submit(batch);
+    batching = false;
+    batch.dest = nullptr;
+    return batch_draws;
+}
+
+bool PrimitiveBatch::IsBatching() {
+    return batching;
+}
+
+void PrimitiveBatch::DrawPixel(ALLEGRO_BITMAP* dest, float x, float y, const ALLEGRO_COLOR& color) {
+    if(dest == nullptr) return;
+    Buffer& buffer = Open(dest, ALLEGRO_PRIM_POINT_LIST, 1);
+    buffer.indices.push_back(AddVertex(buffer, x, y, color));
+    Close(buffer);
+}
+
+void PrimitiveBatch::DrawLine(ALLEGRO_BITMAP* dest, float x1, float y1, float x2, float y2, const ALLEGRO_COLOR& color) {
+    if(dest == nullptr) return;
+    Buffer& buffer = Open(dest, ALLEGRO_PRIM_LINE_LIST, 2);
+    buffer.indices.push_back(AddVertex(buffer, x1, y1, color));
+    buffer.indices.push_back(AddVertex(buffer, x2, y2, color));
+    Close(buffer);
+}
+
+void PrimitiveBatch::DrawTriangle(ALLEGRO_BITMAP* dest, float x1, float y1, float x2, float y2, float x3, float y3, const ALLEGRO_COLOR& color, bool filled) {
+    float vertices[6] = { x1, y1, x2, y2, x3, y3 };
+    DrawPolygon(dest, vertices, 3, color, filled);
+}
+
+void PrimitiveBatch::DrawRectangle(ALLEGRO_BITMAP* dest, float x1, float y1, float x2, float y2, const ALLEGRO_COLOR& color, bool filled) {
+    float vertices[8] = { x1, y1, x2, y1, x2, y2, x1, y2 };
+    DrawPolygon(dest, vertices, 4, color, filled);
+}
+
+void PrimitiveBatch::DrawCircle(ALLEGRO_BITMAP* dest, float cx, float cy, float radius, const ALLEGRO_COLOR& color, bool filled) {
+    DrawEllipse(dest, cx, cy, radius, radius, color, filled);
+}
+
+void PrimitiveBatch::DrawEllipse(ALLEGRO_BITMAP* dest, float cx, float cy, float rx, float ry, const ALLEGRO_COLOR& color, bool filled) {
+    if(dest == nullptr) return;
+    int segments = GetSegments(std::max(std::fabs(rx), std::fabs(ry)), 2.0 * Math::A2DE_PI);
+    if(filled) {
+        Buffer& buffer = Open(dest, ALLEGRO_PRIM_TRIANGLE_LIST, segments + 1);
+        int hub = AddVertex(buffer, cx, cy, color);
+        int first = AddEllipsePoints(buffer, cx, cy, rx, ry, 0.0, 2.0 * Math::A2DE_PI, segments, segments, color);
+        AddTriangleFan(buffer, hub, first, segments, true);
+        Close(buffer);
+    } else {
+        Buffer& buffer = Open(dest, ALLEGRO_PRIM_LINE_LIST, segments);
+        int first = AddEllipsePoints(buffer, cx, cy, rx, ry, 0.0, 2.0 * Math::A2DE_PI, segments, segments, color);
+        AddLineLoop(buffer, first, segments);
+        Close(buffer);
+    }
+}
+
+void PrimitiveBatch::DrawArc(ALLEGRO_BITMAP* dest, float cx, float cy, float radius, float start_theta, float delta_theta, const ALLEGRO_COLOR& color) {
+    if(dest == nullptr) return;
+    int segments = GetSegments(radius, delta_theta);
+    Buffer& buffer = Open(dest, ALLEGRO_PRIM_LINE_LIST, segments + 1);
+    int first = AddEllipsePoints(buffer, cx, cy, radius, radius, start_theta, delta_theta, segments, segments + 1, color);
+    AddLineStrip(buffer, first, segments + 1);
+    Close(buffer);
+}
+
+void PrimitiveBatch::DrawPieslice(ALLEGRO_BITMAP* dest, float cx, float cy, float radius, float start_theta, float delta_theta, const ALLEGRO_COLOR& color, bool filled) {
+    if(dest == nullptr) return;
+    int segments = GetSegments(radius, delta_theta);
+    Buffer& buffer = Open(dest, filled ? ALLEGRO_PRIM_TRIANGLE_LIST : ALLEGRO_PRIM_LINE_LIST, segments + 2);
+    int hub = AddVertex(buffer, cx, cy, color);
+    int first = AddEllipsePoints(buffer, cx, cy, radius, radius, start_theta, delta_theta, segments, segments + 1, color);
+    if(filled) {
+        AddTriangleFan(buffer, hub, first, segments + 1, false);
+    } else {
+        //The hub comes right before the arc, so one loop covers both radii.
+        AddLineLoop(buffer, hub, segments + 2);
+    }
+    Close(buffer);
+}
+
+void PrimitiveBatch::DrawPolygon(ALLEGRO_BITMAP* dest, const float* vertices, std::size_t vertex_count, const ALLEGRO_COLOR& color, bool filled) {
+    if(dest == nullptr || vertices == nullptr) return;
+    if(vertex_count < (filled ? 3u : 2u)) return;
+    int count = static_cast<int>(vertex_count);
+    Buffer& buffer = Open(dest, filled ? ALLEGRO_PRIM_TRIANGLE_LIST : ALLEGRO_PRIM_LINE_LIST, vertex_count);
+    int first = AddVertices(buffer, vertices, vertex_count, color);
+    if(filled) {
+        AddTriangleFan(buffer, first, first + 1, count - 1, false);
+    } else {
+        AddLineLoop(buffer, first, count);
+    }
+    Close(buffer);
+}
+
+void PrimitiveBatch::DrawSpline(ALLEGRO_BITMAP* dest, const float points[8], const ALLEGRO_COLOR& color) {
+    if(dest == nullptr || points == nullptr) return;
+
+    //Wang's formula: the fewest segments that keep the flattened curve within TOLERANCE.
+    double ddx1 = points[0] - 2.0 * points[2] + points[4];
+    double ddy1 = points[1] - 2.0 * points[3] + points[5];
+    double ddx2 = points[2] - 2.0 * points[4] + points[6];
+    double ddy2 = points[3] - 2.0 * points[5] + points[7];
+    double bend = std::max(std::sqrt(ddx1 * ddx1 + ddy1 * ddy1), std::sqrt(ddx2 * ddx2 + ddy2 * ddy2));
+    int segments = static_cast<int>(std::ceil(std::sqrt(0.75 * bend / TOLERANCE)));
+    segments = std::min(std::max(segments, 1), MAX_SEGMENTS);
+
+    Buffer& buffer = Open(dest, ALLEGRO_PRIM_LINE_LIST, segments + 1);
+    int first = static_cast<int>(buffer.vertices.size());
+    for(int i = 0; i <= segments; ++i) {
+        double t = static_cast<double>(i) / segments;
+        double s = 1.0 - t;
+        double a = s * s * s;
+        double b = 3.0 * s * s * t;
+        double c = 3.0 * s * t * t;
+        double d = t * t * t;
+        AddVertex(buffer, a * points[0] + b * points[2] + c * points[4] + d * points[6], a * points[1] + b * points[3] + c * points[5] + d * points[7], color);
+    }
+    AddLineStrip(buffer, first, segments + 1);
+    Close(buffer);
+}
+
+A2DE_END
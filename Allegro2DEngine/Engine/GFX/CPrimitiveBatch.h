@@ -0,0 +1,195 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CPrimitiveBatch.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the primitive batch class.
+ **************************************************************************************************/
+#ifndef A2DE_CPRIMITIVEBATCH_H
+#define A2DE_CPRIMITIVEBATCH_H
+
+#include "../a2de_vals.h"
+
+#include <cstddef>
+
+#include <allegro5/color.h>
+
+struct ALLEGRO_BITMAP;
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Tessellates shapes into vertex buffers and draws them with as few calls as possible.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Every Shape draws through here. Outside of a batch each shape is drawn as soon as it is
+ *          given. Between BeginBatch and EndBatch shapes drawn to the batch's bitmap are collected
+ *          into one buffer and submitted in a single indexed draw, split only where the kind of
+ *          primitive changes between points, outlines and filled shapes, so draw outlines and
+ *          fills in runs. Shapes drawn to other bitmaps during a batch are drawn at once.
+ *          Curves get more segments the larger they are on screen. Coordinates are in pixels
+ *          before the target's transform.</remarks>
+ **************************************************************************************************/
+class PrimitiveBatch {
+public:
+
+    /**************************************************************************************************
+     * <summary>Starts collecting shapes to draw onto a bitmap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">[in,out] If non-null, the destination bitmap.</param>
+     * <returns>true if it succeeds, false if dest is null or a batch is already in progress.</returns>
+     **************************************************************************************************/
+    static bool BeginBatch(ALLEGRO_BITMAP* dest);
+
+    /**************************************************************************************************
+     * <summary>Draws every shape collected since BeginBatch and ends the batch.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The number of draw calls the batch took.</returns>
+     **************************************************************************************************/
+    static std::size_t EndBatch();
+
+    /**************************************************************************************************
+     * <summary>Query if a batch is in progress.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if batching, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsBatching();
+
+    /**************************************************************************************************
+     * <summary>Draws a single pixel.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest"> [in,out] If non-null, the destination bitmap.</param>
+     * <param name="x">    The x coordinate.</param>
+     * <param name="y">    The y coordinate.</param>
+     * <param name="color">The color.</param>
+     **************************************************************************************************/
+    static void DrawPixel(ALLEGRO_BITMAP* dest, float x, float y, const ALLEGRO_COLOR& color);
+
+    /**************************************************************************************************
+     * <summary>Draws a one pixel wide line.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest"> [in,out] If non-null, the destination bitmap.</param>
+     * <param name="x1">   The x coordinate of the first point.</param>
+     * <param name="y1">   The y coordinate of the first point.</param>
+     * <param name="x2">   The x coordinate of the second point.</param>
+     * <param name="y2">   The y coordinate of the second point.</param>
+     * <param name="color">The color.</param>
+     **************************************************************************************************/
+    static void DrawLine(ALLEGRO_BITMAP* dest, float x1, float y1, float x2, float y2, const ALLEGRO_COLOR& color);
+
+    /**************************************************************************************************
+     * <summary>Draws a triangle.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">  [in,out] If non-null, the destination bitmap.</param>
+     * <param name="x1">    The x coordinate of the first point.</param>
+     * <param name="y1">    The y coordinate of the first point.</param>
+     * <param name="x2">    The x coordinate of the second point.</param>
+     * <param name="y2">    The y coordinate of the second point.</param>
+     * <param name="x3">    The x coordinate of the third point.</param>
+     * <param name="y3">    The y coordinate of the third point.</param>
+     * <param name="color"> The color.</param>
+     * <param name="filled">true to fill, false to draw the outline.</param>
+     **************************************************************************************************/
+    static void DrawTriangle(ALLEGRO_BITMAP* dest, float x1, float y1, float x2, float y2, float x3, float y3, const ALLEGRO_COLOR& color, bool filled);
+
+    /**************************************************************************************************
+     * <summary>Draws an axis-aligned rectangle.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">  [in,out] If non-null, the destination bitmap.</param>
+     * <param name="x1">    The left edge.</param>
+     * <param name="y1">    The top edge.</param>
+     * <param name="x2">    The right edge.</param>
+     * <param name="y2">    The bottom edge.</param>
+     * <param name="color"> The color.</param>
+     * <param name="filled">true to fill, false to draw the outline.</param>
+     **************************************************************************************************/
+    static void DrawRectangle(ALLEGRO_BITMAP* dest, float x1, float y1, float x2, float y2, const ALLEGRO_COLOR& color, bool filled);
+
+    /**************************************************************************************************
+     * <summary>Draws a circle.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">  [in,out] If non-null, the destination bitmap.</param>
+     * <param name="cx">    The x coordinate of the center.</param>
+     * <param name="cy">    The y coordinate of the center.</param>
+     * <param name="radius">The radius.</param>
+     * <param name="color"> The color.</param>
+     * <param name="filled">true to fill, false to draw the outline.</param>
+     **************************************************************************************************/
+    static void DrawCircle(ALLEGRO_BITMAP* dest, float cx, float cy, float radius, const ALLEGRO_COLOR& color, bool filled);
+
+    /**************************************************************************************************
+     * <summary>Draws an axis-aligned ellipse.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">  [in,out] If non-null, the destination bitmap.</param>
+     * <param name="cx">    The x coordinate of the center.</param>
+     * <param name="cy">    The y coordinate of the center.</param>
+     * <param name="rx">    The horizontal radius.</param>
+     * <param name="ry">    The vertical radius.</param>
+     * <param name="color"> The color.</param>
+     * <param name="filled">true to fill, false to draw the outline.</param>
+     **************************************************************************************************/
+    static void DrawEllipse(ALLEGRO_BITMAP* dest, float cx, float cy, float rx, float ry, const ALLEGRO_COLOR& color, bool filled);
+
+    /**************************************************************************************************
+     * <summary>Draws part of a circle's outline.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">       [in,out] If non-null, the destination bitmap.</param>
+     * <param name="cx">         The x coordinate of the center.</param>
+     * <param name="cy">         The y coordinate of the center.</param>
+     * <param name="radius">     The radius.</param>
+     * <param name="start_theta">The starting angle in radians.</param>
+     * <param name="delta_theta">The angle swept in radians. Negative sweeps the other way.</param>
+     * <param name="color">      The color.</param>
+     **************************************************************************************************/
+    static void DrawArc(ALLEGRO_BITMAP* dest, float cx, float cy, float radius, float start_theta, float delta_theta, const ALLEGRO_COLOR& color);
+
+    /**************************************************************************************************
+     * <summary>Draws a slice of a circle: an arc closed by two radii.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">       [in,out] If non-null, the destination bitmap.</param>
+     * <param name="cx">         The x coordinate of the center.</param>
+     * <param name="cy">         The y coordinate of the center.</param>
+     * <param name="radius">     The radius.</param>
+     * <param name="start_theta">The starting angle in radians.</param>
+     * <param name="delta_theta">The angle swept in radians. Negative sweeps the other way.</param>
+     * <param name="color">      The color.</param>
+     * <param name="filled">     true to fill, false to draw the outline.</param>
+     **************************************************************************************************/
+    static void DrawPieslice(ALLEGRO_BITMAP* dest, float cx, float cy, float radius, float start_theta, float delta_theta, const ALLEGRO_COLOR& color, bool filled);
+
+    /**************************************************************************************************
+     * <summary>Draws a closed polygon.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Filled polygons are drawn as a fan from the first vertex, which is only correct for
+     *          convex polygons.</remarks>
+     * <param name="dest">        [in,out] If non-null, the destination bitmap.</param>
+     * <param name="vertices">    The vertices as x, y pairs.</param>
+     * <param name="vertex_count">The number of vertices.</param>
+     * <param name="color">       The color.</param>
+     * <param name="filled">      true to fill, false to draw the outline.</param>
+     **************************************************************************************************/
+    static void DrawPolygon(ALLEGRO_BITMAP* dest, const float* vertices, std::size_t vertex_count, const ALLEGRO_COLOR& color, bool filled);
+
+    /**************************************************************************************************
+     * <summary>Draws a cubic Bezier spline.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">  [in,out] If non-null, the destination bitmap.</param>
+     * <param name="points">The four control points as x, y pairs.</param>
+     * <param name="color"> The color.</param>
+     **************************************************************************************************/
+    static void DrawSpline(ALLEGRO_BITMAP* dest, const float points[8], const ALLEGRO_COLOR& color);
+
+private:
+    //Creation of object of type PrimitiveBatch is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    PrimitiveBatch();
+    PrimitiveBatch(const PrimitiveBatch&);
+    //NO COPYING ALLOWED!
+    PrimitiveBatch& operator=(const PrimitiveBatch&);
+    ~PrimitiveBatch();
+
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,233 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CRenderCommandList.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the render command list class.
+ **************************************************************************************************/
+#include "CRenderCommandList.h"
+
+#include <algorithm>
+
+#include <allegro5/allegro.h>
+
+#include "../a2de_exceptions.h"
+
+A2DE_BEGIN
+
+RenderCommandList* RenderCommandList::_recording = nullptr;
+
+RenderCommandList::RenderCommandList() : _commands(), _vertices(), _indices(), _order(), _run(), _view(), _z(0), _layered(false) {
+    al_identity_transform(&_view);
+}
+
+RenderCommandList::~RenderCommandList() {
+    if(_recording == this) _recording = nullptr;
+}
+
+void RenderCommandList::Clear() {
+    _commands.clear();
+    _vertices.clear();
+    _indices.clear();
+    al_identity_transform(&_view);
+    _z = 0;
+    _layered = false;
+}
+
+bool RenderCommandList::BeginRecording() {
+    if(_recording != nullptr && _recording != this) return false;
+    _recording = this;
+    return true;
+}
+
+void RenderCommandList::EndRecording() {
+    if(_recording == this) _recording = nullptr;
+}
+
+RenderCommandList* RenderCommandList::GetRecording() {
+    return _recording;
+}
+
+void RenderCommandList::SetLayer(long z) {
+    _z = z;
+}
+
+long RenderCommandList::GetLayer() const {
+    return _z;
+}
+
+void RenderCommandList::SetView(const ALLEGRO_TRANSFORM& view) {
+    al_copy_transform(&_view, &view);
+}
+
+const ALLEGRO_TRANSFORM& RenderCommandList::GetView() const {
+    return _view;
+}
+
+bool RenderCommandList::AddClear(ALLEGRO_BITMAP* target, const ALLEGRO_COLOR& color) {
+    if(target == nullptr) return false;
+    Command command;
+    command.kind = COMMAND_CLEAR;
+    command.target = target;
+    command.bitmap = nullptr;
+    command.color = color;
+    command.flags = 0;
+    Push(command);
+    return true;
+}
+
+bool RenderCommandList::AddBitmap(ALLEGRO_BITMAP* target, ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, const ALLEGRO_COLOR& tint, const ALLEGRO_TRANSFORM& transform, int flags) {
+    if(target == nullptr || bitmap == nullptr) return false;
+
+    ALLEGRO_TRANSFORM combined;
+    al_copy_transform(&combined, &transform);
+    al_compose_transform(&combined, &_view);
+
+    Command command;
+    command.kind = COMMAND_BITMAP;
+    command.target = target;
+    command.bitmap = bitmap;
+    command.source[0] = sx;
+    command.source[1] = sy;
+    command.source[2] = sw;
+    command.source[3] = sh;
+    command.transform[0] = combined.m[0][0];
+    command.transform[1] = combined.m[1][0];
+    command.transform[2] = combined.m[3][0];
+    command.transform[3] = combined.m[0][1];
+    command.transform[4] = combined.m[1][1];
+    command.transform[5] = combined.m[3][1];
+    command.color = tint;
+    command.flags = flags;
+    Push(command);
+    return true;
+}
+
+bool RenderCommandList::AddPrimitives(ALLEGRO_BITMAP* target, const ALLEGRO_VERTEX* vertices, std::size_t vertex_count, const int* indices, std::size_t index_count, ALLEGRO_PRIM_TYPE type) {
+    if(target == nullptr || vertices == nullptr || indices == nullptr || vertex_count == 0 || index_count == 0) return false;
+
+    Command command;
+    command.kind = COMMAND_PRIMITIVES;
+    command.target = target;
+    command.bitmap = nullptr;
+    command.flags = type;
+    command.first_vertex = static_cast<unsigned int>(_vertices.size());
+    command.first_index = static_cast<unsigned int>(_indices.size());
+    command.index_count = static_cast<unsigned int>(index_count);
+
+    //Baked in now so playback needs no transform changes.
+    for(std::size_t i = 0; i < vertex_count; ++i) {
+        ALLEGRO_VERTEX vertex = vertices[i];
+        al_transform_coordinates(&_view, &vertex.x, &vertex.y);
+        _vertices.push_back(vertex);
+    }
+    _indices.insert(_indices.end(), indices, indices + index_count);
+    Push(command);
+    return true;
+}
+
+void RenderCommandList::Push(Command& command) {
+    command.z = _z;
+    if(_commands.empty() == false && _commands.front().z != _z) _layered = true;
+    _commands.push_back(command);
+}
+
+std::size_t RenderCommandList::Execute() {
+    std::size_t command_count = _commands.size();
+    if(command_count == 0) return 0;
+
+    _order.resize(command_count);
+    for(std::size_t i = 0; i < command_count; ++i) {
+        _order[i] = i;
+    }
+    if(_layered) {
+        const std::vector<Command>& commands = _commands;
+        std::stable_sort(_order.begin(), _order.end(), [&commands](std::size_t a, std::size_t b)->bool { return commands[a].z < commands[b].z; });
+    }
+
+    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
+    ALLEGRO_BITMAP* target = nullptr;
+    ALLEGRO_BITMAP* texture = nullptr;
+    std::size_t draws = 0;
+    for(std::size_t i = 0; i < command_count; ++i) {
+        const Command& command = _commands[_order[i]];
+        if(command.target != target) {
+            draws += FlushRun(texture);
+            target = command.target;
+            al_set_target_bitmap(target);
+        }
+        switch(command.kind) {
+            case COMMAND_CLEAR:
+                draws += FlushRun(texture);
+                al_clear_to_color(command.color);
+                break;
+            case COMMAND_BITMAP: {
+                if(command.bitmap != texture) {
+                    draws += FlushRun(texture);
+                    texture = command.bitmap;
+                }
+                float u0 = command.source[0];
+                float v0 = command.source[1];
+                float u1 = u0 + command.source[2];
+                float v1 = v0 + command.source[3];
+                if(command.flags & ALLEGRO_FLIP_HORIZONTAL) std::swap(u0, u1);
+                if(command.flags & ALLEGRO_FLIP_VERTICAL) std::swap(v0, v1);
+
+                //Two triangles: top-left, top-right, bottom-right and top-left, bottom-right, bottom-left.
+                const float corners[6][4] = {
+                    { 0.0f, 0.0f, u0, v0 },
+                    { command.source[2], 0.0f, u1, v0 },
+                    { command.source[2], command.source[3], u1, v1 },
+                    { 0.0f, 0.0f, u0, v0 },
+                    { command.source[2], command.source[3], u1, v1 },
+                    { 0.0f, command.source[3], u0, v1 },
+                };
+                const float* t = command.transform;
+                for(std::size_t corner = 0; corner < 6; ++corner) {
+                    ALLEGRO_VERTEX vertex;
+                    vertex.x = t[0] * corners[corner][0] + t[1] * corners[corner][1] + t[2];
+                    vertex.y = t[3] * corners[corner][0] + t[4] * corners[corner][1] + t[5];
+                    vertex.z = 0.0f;
+                    vertex.u = corners[corner][2];
+                    vertex.v = corners[corner][3];
+                    vertex.color = command.color;
+                    _run.push_back(vertex);
+                }
+                break;
+            }
+            case COMMAND_PRIMITIVES:
+                draws += FlushRun(texture);
+                al_draw_indexed_prim(&_vertices[command.first_vertex], nullptr, nullptr, &_indices[command.first_index], static_cast<int>(command.index_count), command.flags);
+                ++draws;
+                break;
+            default:
+                /* DO NOTHING */;
+        }
+    }
+    draws += FlushRun(texture);
+
+    al_set_target_bitmap(old_target);
+    return draws;
+}
+
+std::size_t RenderCommandList::FlushRun(ALLEGRO_BITMAP* texture) {
+    if(_run.empty()) return 0;
+    al_draw_prim(&_run[0], nullptr, texture, 0, static_cast<int>(_run.size()), ALLEGRO_PRIM_TRIANGLE_LIST);
+    _run.clear();
+    return 1;
+}
+
+std::size_t RenderCommandList::GetSize() const {
+    return _commands.size();
+}
+
+bool RenderCommandList::IsEmpty() const {
+    return _commands.empty();
+}
+
+const RenderCommandList::Command& RenderCommandList::GetCommand(std::size_t index) const {
+    if(index >= _commands.size()) throw a2de::IndexOutOfBoundsException("index", "0", "_commands.size() - 1");
+    return _commands[index];
+}
+
+A2DE_END
@@ -0,0 +1,262 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CRenderCommandList.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the render command list class.
+ **************************************************************************************************/
+#ifndef A2DE_CRENDERCOMMANDLIST_H
+#define A2DE_CRENDERCOMMANDLIST_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+
+#include <allegro5/color.h>
+#include <allegro5/transformations.h>
+#include <allegro5/allegro_primitives.h>
+
+struct ALLEGRO_BITMAP;
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>A recorded frame of drawing that can be played back later, on another thread.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          While a list is recording, SpriteHandler, PrimitiveBatch, RenderManager and
+ *          GameWindow::StartRender add commands to it instead of drawing, so the recording
+ *          thread never touches the display. Each command keeps its target, its layer and the
+ *          transform from its own coordinates to the target's, which includes the view set with
+ *          SetView. Execute draws the commands in layer order, keeping recording order within a
+ *          layer, and draws runs of the same bitmap onto the same target in one call. Bitmaps
+ *          and targets are not owned and must outlive the playback.</remarks>
+ **************************************************************************************************/
+class RenderCommandList {
+public:
+
+    /**************************************************************************************************
+     * <summary>Values that represent the kinds of command.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    enum COMMAND {
+        /// <summary> Clears the target to a color.</summary>
+        COMMAND_CLEAR,
+        /// <summary> Draws a tinted region of a bitmap.</summary>
+        COMMAND_BITMAP,
+        /// <summary> Draws indexed, untextured primitives.</summary>
+        COMMAND_PRIMITIVES,
+    };
+
+    /**************************************************************************************************
+     * <summary>One recorded draw.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct Command {
+        /// <summary> The kind of command.</summary>
+        COMMAND kind;
+        /// <summary> The layer. Lower layers are drawn first.</summary>
+        long z;
+        /// <summary> The bitmap drawn to.</summary>
+        ALLEGRO_BITMAP* target;
+        /// <summary> The bitmap drawn from, or null.</summary>
+        ALLEGRO_BITMAP* bitmap;
+        /// <summary> The source region: x, y, width, height.</summary>
+        float source[4];
+        /// <summary> The affine transform to the target as the rows of a 2x3 matrix: m00, m10, m30, m01, m11, m31.</summary>
+        float transform[6];
+        /// <summary> The tint of a bitmap or the clear color.</summary>
+        ALLEGRO_COLOR color;
+        /// <summary> The ALLEGRO_FLIP flags of a bitmap or the ALLEGRO_PRIM_TYPE of primitives.</summary>
+        int flags;
+        /// <summary> Index of the first vertex of primitives.</summary>
+        unsigned int first_vertex;
+        /// <summary> Index of the first index of primitives.</summary>
+        unsigned int first_index;
+        /// <summary> The number of indices of primitives.</summary>
+        unsigned int index_count;
+    };
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    RenderCommandList();
+
+    /**************************************************************************************************
+     * <summary>Destructor. Stops recording if this list is recording.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~RenderCommandList();
+
+    /**************************************************************************************************
+     * <summary>Removes every command and resets the layer and view. Storage is kept for the next frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Makes this the list that draw calls are recorded to.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Only one list records at a time and only one thread should draw while it does.</remarks>
+     * <returns>true if it succeeds, false if another list is recording.</returns>
+     **************************************************************************************************/
+    bool BeginRecording();
+
+    /**************************************************************************************************
+     * <summary>Stops recording. Draw calls draw immediately again.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void EndRecording();
+
+    /**************************************************************************************************
+     * <summary>Gets the list that draw calls are recorded to.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>null if no list is recording, else the list.</returns>
+     **************************************************************************************************/
+    static RenderCommandList* GetRecording();
+
+    /**************************************************************************************************
+     * <summary>Sets the layer of the commands added after this.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="z">The layer. Lower layers are drawn first.</param>
+     **************************************************************************************************/
+    void SetLayer(long z);
+
+    /**************************************************************************************************
+     * <summary>Gets the layer of the commands being added.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The layer.</returns>
+     **************************************************************************************************/
+    long GetLayer() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the transform applied after each command's own, standing in for the target's current transform.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="view">The view transform.</param>
+     **************************************************************************************************/
+    void SetView(const ALLEGRO_TRANSFORM& view);
+
+    /**************************************************************************************************
+     * <summary>Gets the view transform.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The view transform.</returns>
+     **************************************************************************************************/
+    const ALLEGRO_TRANSFORM& GetView() const;
+
+    /**************************************************************************************************
+     * <summary>Adds a command that clears a target.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="target">[in,out] If non-null, the bitmap to clear.</param>
+     * <param name="color"> The color.</param>
+     * <returns>true if it was added, false if target is null.</returns>
+     **************************************************************************************************/
+    bool AddClear(ALLEGRO_BITMAP* target, const ALLEGRO_COLOR& color);
+
+    /**************************************************************************************************
+     * <summary>Adds a command that draws a region of a bitmap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The region is placed with its top-left corner at the origin before the transform
+     *          and the view are applied.</remarks>
+     * <param name="target">   [in,out] If non-null, the bitmap to draw to.</param>
+     * <param name="bitmap">   [in,out] If non-null, the bitmap to draw.</param>
+     * <param name="sx">       The left edge of the region.</param>
+     * <param name="sy">       The top edge of the region.</param>
+     * <param name="sw">       The width of the region.</param>
+     * <param name="sh">       The height of the region.</param>
+     * <param name="tint">     The tint.</param>
+     * <param name="transform">The transform from the region to the view.</param>
+     * <param name="flags">    The ALLEGRO_FLIP flags.</param>
+     * <returns>true if it was added, false if target or bitmap is null.</returns>
+     **************************************************************************************************/
+    bool AddBitmap(ALLEGRO_BITMAP* target, ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, const ALLEGRO_COLOR& tint, const ALLEGRO_TRANSFORM& transform, int flags);
+
+    /**************************************************************************************************
+     * <summary>Adds a command that draws indexed primitives.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The vertices are copied and moved through the view.</remarks>
+     * <param name="target">      [in,out] If non-null, the bitmap to draw to.</param>
+     * <param name="vertices">    The vertices.</param>
+     * <param name="vertex_count">The number of vertices.</param>
+     * <param name="indices">     The indices into vertices.</param>
+     * <param name="index_count"> The number of indices.</param>
+     * <param name="type">        The kind of primitive.</param>
+     * <returns>true if it was added, false if target is null or there is nothing to draw.</returns>
+     **************************************************************************************************/
+    bool AddPrimitives(ALLEGRO_BITMAP* target, const ALLEGRO_VERTEX* vertices, std::size_t vertex_count, const int* indices, std::size_t index_count, ALLEGRO_PRIM_TYPE type);
+
+    /**************************************************************************************************
+     * <summary>Draws every command.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Call it on the thread that owns the targets. Each target's own transform still
+     *          applies on top of the recorded ones. The target is restored afterwards.</remarks>
+     * <returns>The number of draw calls made.</returns>
+     **************************************************************************************************/
+    std::size_t Execute();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of commands.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The size.</returns>
+     **************************************************************************************************/
+    std::size_t GetSize() const;
+
+    /**************************************************************************************************
+     * <summary>Query if the list is empty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if empty, false if not.</returns>
+     **************************************************************************************************/
+    bool IsEmpty() const;
+
+    /**************************************************************************************************
+     * <summary>Gets a command.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="index">Zero-based index of the command in recording order.</param>
+     * <returns>The command.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the index is past the end of the list.</exception>
+     **************************************************************************************************/
+    const Command& GetCommand(std::size_t index) const;
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Appends a command on the current layer.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="command">[in,out] The command. Its layer is set here.</param>
+     **************************************************************************************************/
+    void Push(Command& command);
+
+    /**************************************************************************************************
+     * <summary>Draws the bitmap quads gathered for one run and empties the run.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="texture">The bitmap of the run.</param>
+     * <returns>1 if anything was drawn, else 0.</returns>
+     **************************************************************************************************/
+    std::size_t FlushRun(ALLEGRO_BITMAP* texture);
+
+    /// <summary> The commands in recording order.</summary>
+    std::vector<Command> _commands;
+    /// <summary> The vertices of every primitives command, already through the view.</summary>
+    std::vector<ALLEGRO_VERTEX> _vertices;
+    /// <summary> The indices of every primitives command, relative to its first vertex.</summary>
+    std::vector<int> _indices;
+    /// <summary> The commands in drawing order, built by Execute.</summary>
+    std::vector<std::size_t> _order;
+    /// <summary> The quads of the bitmap run being gathered by Execute.</summary>
+    std::vector<ALLEGRO_VERTEX> _run;
+    /// <summary> The view transform.</summary>
+    ALLEGRO_TRANSFORM _view;
+    /// <summary> The layer of new commands.</summary>
+    long _z;
+    /// <summary> true if the commands are not all on one layer.</summary>
+    bool _layered;
+    /// <summary> The recording list, or null.</summary>
+    static RenderCommandList* _recording;
+
+    RenderCommandList(const RenderCommandList& other);
+    RenderCommandList& operator=(const RenderCommandList& rhs);
+};
+
+A2DE_END
+
+#endif
@@ -5,12 +5,15 @@
 #include <allegro5/bitmap_draw.h>
 #include <allegro5/bitmap_io.h>
 #include <allegro5/bitmap_lock.h>
+#include <allegro5/transformations.h>
 
 #include "../Math/CShape.h"
 #include "../Physics/IBoundingBox.h"
 #include "IDrawable.h"
 #include "CSprite.h"
+#include "CRenderCommandList.h"
 #include "../Objects/ADTObject.h"
+#include "../Math/CMiscMath.h"
 
 
 A2DE_BEGIN
@@ -57,36 +60,109 @@ void RenderManager::RenderObject(IDrawable* drawable) {
     drawable->Draw(al_get_backbuffer(_display_context));
 }
 
-void RenderManager::RenderObjectAt(Object* object, const a2de::Vector2D& screen_position) {
+void RenderManager::RenderObject(Object* object, const ALLEGRO_TRANSFORM& view) {
     if(object == nullptr) return;
-    a2de::Vector2D old_pos(object->GetBody()->GetPosition());
-    object->GetBody()->SetPosition(screen_position);
+    ALLEGRO_TRANSFORM old_transform;
+    ALLEGRO_BITMAP* old_target = nullptr;
+    BeginView(view, old_transform, old_target);
     object->Draw(al_get_backbuffer(_display_context));
-    object->GetBody()->SetPosition(old_pos);
+    EndView(old_transform, old_target);
 }
 
-void RenderManager::RenderObjectAt(Sprite* sprite, const a2de::Vector2D& screen_position) {
+void RenderManager::RenderObject(Sprite* sprite, const ALLEGRO_TRANSFORM& view) {
     if(sprite == nullptr) return;
-    a2de::Vector2D old_pos(sprite->GetPosition());
-    sprite->SetPosition(screen_position);
+    ALLEGRO_TRANSFORM old_transform;
+    ALLEGRO_BITMAP* old_target = nullptr;
+    BeginView(view, old_transform, old_target);
     sprite->Draw(al_get_backbuffer(_display_context));
-    sprite->SetPosition(old_pos);
+    EndView(old_transform, old_target);
 }
 
-void RenderManager::RenderObjectAt(Shape* shape, const a2de::Vector2D& screen_position) {
+void RenderManager::RenderObject(Shape* shape, const ALLEGRO_TRANSFORM& view) {
     if(shape == nullptr) return;
-    a2de::Vector2D old_pos(shape->GetPosition());
-    shape->SetPosition(screen_position);
+    ALLEGRO_TRANSFORM old_transform;
+    ALLEGRO_BITMAP* old_target = nullptr;
+    BeginView(view, old_transform, old_target);
     shape->Draw(al_get_backbuffer(_display_context));
-    shape->SetPosition(old_pos);
+    EndView(old_transform, old_target);
 }
 
-void RenderManager::RenderObjectAt(IBoundingBox* bounding_box, const a2de::Vector2D& screen_position) {
+void RenderManager::RenderObject(IBoundingBox* bounding_box, const ALLEGRO_TRANSFORM& view) {
     if(bounding_box == nullptr) return;
-    a2de::Vector2D old_pos(bounding_box->GetTransform().GetPosition());
-    bounding_box->GetTransform().SetPosition(screen_position);
+    ALLEGRO_TRANSFORM old_transform;
+    ALLEGRO_BITMAP* old_target = nullptr;
+    BeginView(view, old_transform, old_target);
     bounding_box->Draw(al_get_backbuffer(_display_context));
-    bounding_box->GetTransform().SetPosition(old_pos);
+    EndView(old_transform, old_target);
+}
+
+void RenderManager::RenderObjectAt(Object* object, const a2de::Vector2D& screen_position) {
+    if(object == nullptr) return;
+    if(object->GetBody() == nullptr) return;
+    ALLEGRO_TRANSFORM view;
+    CalculateOffsetTransform(view, object->GetBody()->GetPosition(), screen_position);
+    RenderObject(object, view);
+}
+
+void RenderManager::RenderObjectAt(Sprite* sprite, const a2de::Vector2D& screen_position) {
+    if(sprite == nullptr) return;
+    ALLEGRO_TRANSFORM view;
+    CalculateOffsetTransform(view, sprite->GetPosition(), screen_position);
+    RenderObject(sprite, view);
+}
+
+void RenderManager::RenderObjectAt(Shape* shape, const a2de::Vector2D& screen_position) {
+    if(shape == nullptr) return;
+    ALLEGRO_TRANSFORM view;
+    CalculateOffsetTransform(view, shape->GetPosition(), screen_position);
+    RenderObject(shape, view);
+}
+
+void RenderManager::RenderObjectAt(IBoundingBox* bounding_box, const a2de::Vector2D& screen_position) {
+    if(bounding_box == nullptr) return;
+    ALLEGRO_TRANSFORM view;
+    CalculateOffsetTransform(view, bounding_box->GetTransform().GetPosition(), screen_position);
+    RenderObject(bounding_box, view);
+}
+
+void RenderManager::CalculateOffsetTransform(ALLEGRO_TRANSFORM& transform, const a2de::Vector2D& position, const a2de::Vector2D& screen_position) {
+    a2de::Vector2D offset(a2de::Math::ToScreenScale(screen_position - position));
+    al_identity_transform(&transform);
+    al_translate_transform(&transform, static_cast<float>(offset.GetX()), static_cast<float>(offset.GetY()));
+}
+
+void RenderManager::BeginView(const ALLEGRO_TRANSFORM& view, ALLEGRO_TRANSFORM& old_transform, ALLEGRO_BITMAP*& old_target) {
+    //A recording thread has no display; the view goes on the list instead.
+    RenderCommandList* list = RenderCommandList::GetRecording();
+    if(list != nullptr) {
+        old_target = nullptr;
+        al_copy_transform(&old_transform, &list->GetView());
+        ALLEGRO_TRANSFORM combined;
+        al_copy_transform(&combined, &view);
+        al_compose_transform(&combined, &old_transform);
+        list->SetView(combined);
+        return;
+    }
+
+    //Transforms are stored per target bitmap, so the back buffer has to be the target here.
+    old_target = al_get_target_bitmap();
+    al_set_target_bitmap(al_get_backbuffer(_display_context));
+    al_copy_transform(&old_transform, al_get_current_transform());
+
+    ALLEGRO_TRANSFORM combined;
+    al_copy_transform(&combined, &view);
+    al_compose_transform(&combined, &old_transform);
+    al_use_transform(&combined);
+}
+
+void RenderManager::EndView(const ALLEGRO_TRANSFORM& old_transform, ALLEGRO_BITMAP* old_target) {
+    RenderCommandList* list = RenderCommandList::GetRecording();
+    if(list != nullptr) {
+        list->SetView(old_transform);
+        return;
+    }
+    al_use_transform(&old_transform);
+    al_set_target_bitmap(old_target);
 }
 
 
@@ -13,6 +13,7 @@
 #include "../Math/CVector2D.h"
 
 #include <allegro5/display.h>
+#include <allegro5/transformations.h>
 
 A2DE_BEGIN
 
@@ -68,9 +69,44 @@ public:
      **************************************************************************************************/
     void RenderObject(IDrawable* drawable);
 
+    /**************************************************************************************************
+     * <summary>Renders the object through a view transform.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The transform is composed onto the back buffer's current transform for the duration
+     *          of the draw. The object is not modified.</remarks>
+     * <param name="object">[in,out] If non-null, the object.</param>
+     * <param name="view">  The view transform.</param>
+     **************************************************************************************************/
+    void RenderObject(Object* object, const ALLEGRO_TRANSFORM& view);
+
+    /**************************************************************************************************
+     * <summary>Renders the sprite through a view transform.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="sprite">[in,out] If non-null, the sprite.</param>
+     * <param name="view">  The view transform.</param>
+     **************************************************************************************************/
+    void RenderObject(Sprite* sprite, const ALLEGRO_TRANSFORM& view);
+
+    /**************************************************************************************************
+     * <summary>Renders the shape through a view transform.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="shape">[in,out] If non-null, the shape.</param>
+     * <param name="view"> The view transform.</param>
+     **************************************************************************************************/
+    void RenderObject(Shape* shape, const ALLEGRO_TRANSFORM& view);
+
+    /**************************************************************************************************
+     * <summary>Renders the bounding box through a view transform.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="bounding_box">[in,out] If non-null, the bounding box.</param>
+     * <param name="view">        The view transform.</param>
+     **************************************************************************************************/
+    void RenderObject(IBoundingBox* bounding_box, const ALLEGRO_TRANSFORM& view);
+
     /**************************************************************************************************
      * <summary>Renders the object at the specified location.</summary>
-     * <remarks>Casey Ugone, 10/25/2014.</remarks>
+     * <remarks>Casey Ugone, 10/25/2014.
+     *          Drawn through an offset transform; the body's position is only read.</remarks>
      * <param name="object">         [in,out] If non-null, the object.</param>
      * <param name="screen_position">The screen position.</param>
      **************************************************************************************************/
@@ -110,6 +146,34 @@ protected:
     RenderManager(ALLEGRO_DISPLAY& display);
 private:
 
+    /**************************************************************************************************
+     * <summary>Builds the transform that moves a drawable from its own position to another.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Drawables convert their position to pixels when drawing, so the offset is converted
+     *          the same way.</remarks>
+     * <param name="transform">      [out] The transform.</param>
+     * <param name="position">       The drawable's position.</param>
+     * <param name="screen_position">The position to draw it at.</param>
+     **************************************************************************************************/
+    static void CalculateOffsetTransform(ALLEGRO_TRANSFORM& transform, const a2de::Vector2D& position, const a2de::Vector2D& screen_position);
+
+    /**************************************************************************************************
+     * <summary>Targets the back buffer and composes a view transform onto it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="view">          The view transform.</param>
+     * <param name="old_transform"> [out] The back buffer's previous transform.</param>
+     * <param name="old_target">    [out] The previous target bitmap.</param>
+     **************************************************************************************************/
+    void BeginView(const ALLEGRO_TRANSFORM& view, ALLEGRO_TRANSFORM& old_transform, ALLEGRO_BITMAP*& old_target);
+
+    /**************************************************************************************************
+     * <summary>Restores the state saved by BeginView.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="old_transform">The back buffer's previous transform.</param>
+     * <param name="old_target">   The previous target bitmap.</param>
+     **************************************************************************************************/
+    void EndView(const ALLEGRO_TRANSFORM& old_transform, ALLEGRO_BITMAP* old_target);
+
     /**************************************************************************************************
      * <summary>The singleton instance.</summary>
      **************************************************************************************************/
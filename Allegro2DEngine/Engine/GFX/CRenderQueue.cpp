@@ -0,0 +1,92 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CRenderQueue.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the render queue class.
+ **************************************************************************************************/
+#include "CRenderQueue.h"
+
+#include "../a2de_exceptions.h"
+#include "../Objects/ADTObject.h"
+
+A2DE_BEGIN
+
+RenderQueue::RenderQueue() : _items(), _scratch() { /* DO NOTHING */ }
+
+RenderQueue::~RenderQueue() { /* DO NOTHING */ }
+
+void RenderQueue::Clear() {
+    _items.clear();
+}
+
+bool RenderQueue::Submit(a2de::Object* object, unsigned long sequence) {
+    if(object == nullptr) return false;
+    Item item;
+    item.key = MakeKey(object->GetZOrder(), object->GetTexture());
+    item.sequence = sequence;
+    item.object = object;
+    _items.push_back(item);
+    return true;
+}
+
+void RenderQueue::Sort() {
+    if(_items.size() < 2) return;
+    _scratch.resize(_items.size());
+
+    //Least significant digit first: sequence, then texture, then z-order.
+    for(unsigned int shift = 0; shift < 32; shift += 8) {
+        RadixPass(false, shift);
+    }
+    for(unsigned int shift = 0; shift < 64; shift += 8) {
+        RadixPass(true, shift);
+    }
+}
+
+void RenderQueue::RadixPass(bool use_key, unsigned int shift) {
+    std::size_t counts[256] = { 0 };
+    std::size_t item_count = _items.size();
+    for(std::size_t i = 0; i < item_count; ++i) {
+        unsigned long long value = use_key ? _items[i].key : _items[i].sequence;
+        ++counts[(value >> shift) & 0xFF];
+    }
+
+    //Z-orders are usually small and most digits are the same for every item.
+    for(std::size_t digit = 0; digit < 256; ++digit) {
+        if(counts[digit] == item_count) return;
+        if(counts[digit] != 0) break;
+    }
+
+    std::size_t offset = 0;
+    for(std::size_t digit = 0; digit < 256; ++digit) {
+        std::size_t count = counts[digit];
+        counts[digit] = offset;
+        offset += count;
+    }
+    for(std::size_t i = 0; i < item_count; ++i) {
+        unsigned long long value = use_key ? _items[i].key : _items[i].sequence;
+        _scratch[counts[(value >> shift) & 0xFF]++] = _items[i];
+    }
+    _items.swap(_scratch);
+}
+
+std::size_t RenderQueue::GetSize() const {
+    return _items.size();
+}
+
+bool RenderQueue::IsEmpty() const {
+    return _items.empty();
+}
+
+const RenderQueue::Item& RenderQueue::GetItem(std::size_t index) const {
+    if(index >= _items.size()) throw a2de::IndexOutOfBoundsException("index", "0", "_items.size() - 1");
+    return _items[index];
+}
+
+unsigned long long RenderQueue::MakeKey(unsigned long z_order, const ALLEGRO_BITMAP* texture) {
+    //Bitmaps are at least 16-byte aligned; dropping the low bits keeps more of the address.
+    unsigned long long texture_bits = (static_cast<unsigned long long>(reinterpret_cast<std::size_t>(texture)) >> 4) & 0xFFFFFFFFULL;
+    return (static_cast<unsigned long long>(z_order & 0xFFFFFFFFUL) << 32) | texture_bits;
+}
+
+A2DE_END
@@ -0,0 +1,134 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CRenderQueue.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the render queue class.
+ **************************************************************************************************/
+#ifndef A2DE_CRENDERQUEUE_H
+#define A2DE_CRENDERQUEUE_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+
+#include <allegro5/bitmap.h>
+
+A2DE_BEGIN
+
+class Object;
+
+/**************************************************************************************************
+ * <summary>A list of objects to draw, sorted by z-order and then by texture.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Items with the same z-order and texture keep the order of their sequence numbers, so
+ *          the draw order does not change from frame to frame. Sorting is a radix sort over the
+ *          submitted items only and reuses its storage between frames.</remarks>
+ **************************************************************************************************/
+class RenderQueue {
+public:
+
+    /**************************************************************************************************
+     * <summary>A queued object and its sort key.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct Item {
+        /// <summary> The z-order in the high half, the texture in the low half.</summary>
+        unsigned long long key;
+        /// <summary> The tie breaker for items with equal keys.</summary>
+        unsigned long sequence;
+        /// <summary> The object.</summary>
+        a2de::Object* object;
+    };
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    RenderQueue();
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~RenderQueue();
+
+    /**************************************************************************************************
+     * <summary>Removes every item. Storage is kept for the next frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Adds an object to the queue.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="object">  [in,out] If non-null, the object.</param>
+     * <param name="sequence">The tie breaker, usually the object's position in the world's object list.</param>
+     * <returns>true if it succeeds, false if the object is null.</returns>
+     **************************************************************************************************/
+    bool Submit(a2de::Object* object, unsigned long sequence);
+
+    /**************************************************************************************************
+     * <summary>Sorts the queue by z-order, texture and sequence.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Sort();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of queued items.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The size.</returns>
+     **************************************************************************************************/
+    std::size_t GetSize() const;
+
+    /**************************************************************************************************
+     * <summary>Query if the queue is empty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if empty, false if not.</returns>
+     **************************************************************************************************/
+    bool IsEmpty() const;
+
+    /**************************************************************************************************
+     * <summary>Gets an item.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="index">Zero-based index of the item.</param>
+     * <returns>The item.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the index is past the end of the queue.</exception>
+     **************************************************************************************************/
+    const Item& GetItem(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Builds the sort key for a z-order and texture.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Textures are ordered by address, which groups equal textures but is not meaningful
+     *          otherwise.</remarks>
+     * <param name="z_order">The z-order.</param>
+     * <param name="texture">The texture, or null.</param>
+     * <returns>The key.</returns>
+     **************************************************************************************************/
+    static unsigned long long MakeKey(unsigned long z_order, const ALLEGRO_BITMAP* texture);
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Runs one stable counting sort pass on eight bits of a value.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Passes where every item has the same digit are skipped.</remarks>
+     * <param name="use_key">true to sort on the key, false to sort on the sequence.</param>
+     * <param name="shift">  The bit offset of the digit.</param>
+     **************************************************************************************************/
+    void RadixPass(bool use_key, unsigned int shift);
+
+    /// <summary> The items.</summary>
+    std::vector<Item> _items;
+    /// <summary> Scratch storage for the sort.</summary>
+    std::vector<Item> _scratch;
+
+    RenderQueue(const RenderQueue& other);
+    RenderQueue& operator=(const RenderQueue& rhs);
+};
+
+A2DE_END
+
+#endif
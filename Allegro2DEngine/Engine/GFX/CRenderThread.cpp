@@ -0,0 +1,220 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CRenderThread.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the render thread class.
+ **************************************************************************************************/
+#include "CRenderThread.h"
+
+#include <deque>
+#include <utility>
+
+#include <allegro5/allegro.h>
+#include <allegro5/threads.h>
+
+#include "CRenderCommandList.h"
+
+A2DE_BEGIN
+
+/************************************************************************/
+/* DO NOT DEFINE CONSTRUCTORS, DESTRUCTOR, ASSIGNMENT OPERATOR!         */
+/************************************************************************/
+
+namespace {
+
+    /// <summary> Values that represent who has a frame list.</summary>
+    enum LISTSTATE {
+        /// <summary> Free to record into.</summary>
+        LISTSTATE_FREE,
+        /// <summary> Recorded and waiting for the render thread.</summary>
+        LISTSTATE_PENDING,
+        /// <summary> Being drawn by the render thread.</summary>
+        LISTSTATE_DRAWING,
+    };
+
+    /// <summary> The display the render thread draws to.</summary>
+    ALLEGRO_DISPLAY* render_display = nullptr;
+    /// <summary> The render thread, or null when not running.</summary>
+    ALLEGRO_THREAD* render_thread = nullptr;
+    /// <summary> Guards everything below but the lists' contents.</summary>
+    ALLEGRO_MUTEX* frame_mutex = nullptr;
+    /// <summary> Signaled when a list is handed over or freed, and on stopping.</summary>
+    ALLEGRO_COND* frame_changed = nullptr;
+    /// <summary> The two frames: one recording while the other draws.</summary>
+    RenderCommandList frame_lists[2];
+    /// <summary> Who has each list.</summary>
+    LISTSTATE list_states[2] = { LISTSTATE_FREE, LISTSTATE_FREE };
+    /// <summary> The order each list was handed over in, so frames are drawn oldest first.</summary>
+    unsigned long list_frames[2] = { 0, 0 };
+    /// <summary> The number of frames handed over.</summary>
+    unsigned long frames_recorded = 0;
+    /// <summary> The number of frames drawn.</summary>
+    unsigned long frames_drawn = 0;
+    /// <summary> true to have the render thread exit once no frames are pending.</summary>
+    bool stopping = false;
+    /// <summary> The list being recorded, or -1. Only touched by the recording thread.</summary>
+    int recording_list = -1;
+    /// <summary> The list the next frame is recorded into. Only touched by the recording thread.</summary>
+    int next_list = 0;
+    /// <summary> Bitmaps waiting to be destroyed, each with the frame that must be drawn first.</summary>
+    std::deque<std::pair<unsigned long, ALLEGRO_BITMAP*> > doomed_bitmaps;
+
+    void DestroyDrawnLocked() {
+        //Frames are handed over in order, so the waits never decrease.
+        while(doomed_bitmaps.empty() == false && doomed_bitmaps.front().first <= frames_drawn) {
+            al_destroy_bitmap(doomed_bitmaps.front().second);
+            doomed_bitmaps.pop_front();
+        }
+    }
+
+    int FindPendingLocked() {
+        int oldest = -1;
+        for(int i = 0; i < 2; ++i) {
+            if(list_states[i] != LISTSTATE_PENDING) continue;
+            if(oldest < 0 || list_frames[i] < list_frames[oldest]) oldest = i;
+        }
+        return oldest;
+    }
+
+    void* RenderProc(ALLEGRO_THREAD* /*thread*/, void* /*arg*/) {
+        al_set_target_backbuffer(render_display);
+
+        al_lock_mutex(frame_mutex);
+        for(;;) {
+            DestroyDrawnLocked();
+            int list = FindPendingLocked();
+            while(list < 0 && stopping == false) {
+                al_wait_cond(frame_changed, frame_mutex);
+                DestroyDrawnLocked();
+                list = FindPendingLocked();
+            }
+            if(list < 0) break;
+            list_states[list] = LISTSTATE_DRAWING;
+            al_unlock_mutex(frame_mutex);
+
+            frame_lists[list].Execute();
+            al_flip_display();
+
+            al_lock_mutex(frame_mutex);
+            list_states[list] = LISTSTATE_FREE;
+            ++frames_drawn;
+            al_broadcast_cond(frame_changed);
+        }
+        al_unlock_mutex(frame_mutex);
+
+        //Let go of the display so Stop can take it back.
+        al_set_target_bitmap(nullptr);
+        return nullptr;
+    }
+
+}
+
+bool RenderThread::Start(ALLEGRO_DISPLAY* display) {
+    if(display == nullptr || render_thread != nullptr) return false;
+
+    if(frame_mutex == nullptr) frame_mutex = al_create_mutex();
+    if(frame_changed == nullptr) frame_changed = al_create_cond();
+    if(frame_mutex == nullptr || frame_changed == nullptr) return false;
+
+    render_display = display;
+    list_states[0] = LISTSTATE_FREE;
+    list_states[1] = LISTSTATE_FREE;
+    frames_recorded = 0;
+    frames_drawn = 0;
+    stopping = false;
+    recording_list = -1;
+    next_list = 0;
+
+    //A display can only be current on one thread at a time.
+    al_set_target_bitmap(nullptr);
+    render_thread = al_create_thread(RenderProc, nullptr);
+    if(render_thread == nullptr) {
+        al_set_target_backbuffer(display);
+        render_display = nullptr;
+        return false;
+    }
+    al_start_thread(render_thread);
+    return true;
+}
+
+void RenderThread::Stop() {
+    if(render_thread == nullptr) return;
+    EndFrame();
+
+    al_lock_mutex(frame_mutex);
+    stopping = true;
+    al_broadcast_cond(frame_changed);
+    al_unlock_mutex(frame_mutex);
+
+    al_join_thread(render_thread, nullptr);
+    al_destroy_thread(render_thread);
+    render_thread = nullptr;
+
+    al_set_target_backbuffer(render_display);
+    render_display = nullptr;
+
+    //Every frame has been drawn, so nothing can use them any more.
+    while(doomed_bitmaps.empty() == false) {
+        al_destroy_bitmap(doomed_bitmaps.front().second);
+        doomed_bitmaps.pop_front();
+    }
+}
+
+bool RenderThread::IsRunning() {
+    return render_thread != nullptr;
+}
+
+void RenderThread::BeginFrame() {
+    if(render_thread == nullptr || recording_list >= 0) return;
+
+    al_lock_mutex(frame_mutex);
+    while(list_states[next_list] != LISTSTATE_FREE) {
+        al_wait_cond(frame_changed, frame_mutex);
+    }
+    al_unlock_mutex(frame_mutex);
+
+    RenderCommandList& list = frame_lists[next_list];
+    list.Clear();
+    if(list.BeginRecording() == false) return;
+    recording_list = next_list;
+}
+
+void RenderThread::EndFrame() {
+    if(recording_list < 0) return;
+    frame_lists[recording_list].EndRecording();
+
+    al_lock_mutex(frame_mutex);
+    list_states[recording_list] = LISTSTATE_PENDING;
+    list_frames[recording_list] = ++frames_recorded;
+    al_broadcast_cond(frame_changed);
+    al_unlock_mutex(frame_mutex);
+
+    next_list = 1 - recording_list;
+    recording_list = -1;
+}
+
+unsigned long RenderThread::GetFramesDrawn() {
+    if(frame_mutex == nullptr) return 0;
+    al_lock_mutex(frame_mutex);
+    unsigned long frames = frames_drawn;
+    al_unlock_mutex(frame_mutex);
+    return frames;
+}
+
+void RenderThread::DestroyBitmap(ALLEGRO_BITMAP* bitmap) {
+    if(bitmap == nullptr) return;
+    if(render_thread == nullptr) {
+        al_destroy_bitmap(bitmap);
+        return;
+    }
+
+    al_lock_mutex(frame_mutex);
+    //The frame being recorded is handed over as frames_recorded + 1.
+    unsigned long frame = recording_list >= 0 ? frames_recorded + 1 : frames_recorded;
+    doomed_bitmaps.push_back(std::make_pair(frame, bitmap));
+    al_broadcast_cond(frame_changed);
+    al_unlock_mutex(frame_mutex);
+}
+
+A2DE_END
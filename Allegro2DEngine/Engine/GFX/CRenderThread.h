@@ -0,0 +1,101 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CRenderThread.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the render thread class.
+ **************************************************************************************************/
+#ifndef A2DE_CRENDERTHREAD_H
+#define A2DE_CRENDERTHREAD_H
+
+#include "../a2de_vals.h"
+
+#include <allegro5/display.h>
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Draws recorded frames on a thread of its own.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Start hands the display to the render thread. From then on each frame drawn between
+ *          BeginFrame and EndFrame is recorded into one of two RenderCommandLists; the render
+ *          thread plays the previous frame and flips while the game simulates and records the
+ *          next, so the game is never more than one frame ahead. Game calls BeginFrame and
+ *          EndFrame around Render, which do nothing when the thread is not running.
+ *          While it runs the calling thread has no display: bitmaps it creates are memory
+ *          bitmaps, so load assets before Start or after Stop, and free bitmaps that may have been
+ *          drawn with DestroyBitmap so they outlive the frames that draw them.</remarks>
+ **************************************************************************************************/
+class RenderThread {
+public:
+
+    /**************************************************************************************************
+     * <summary>Starts the render thread and gives it the display.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Call it from the thread the display is current on.</remarks>
+     * <param name="display">[in,out] If non-null, the display.</param>
+     * <returns>true if it succeeds, false if display is null, the thread is already running or could not be created.</returns>
+     **************************************************************************************************/
+    static bool Start(ALLEGRO_DISPLAY* display);
+
+    /**************************************************************************************************
+     * <summary>Draws the last handed over frame, stops the render thread and takes the display back.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void Stop();
+
+    /**************************************************************************************************
+     * <summary>Query if the render thread is running.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if running, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsRunning();
+
+    /**************************************************************************************************
+     * <summary>Starts recording a frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Waits until the render thread is done with the list the frame is recorded into,
+     *          which is the list from two frames ago.</remarks>
+     **************************************************************************************************/
+    static void BeginFrame();
+
+    /**************************************************************************************************
+     * <summary>Stops recording the frame and hands it to the render thread.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void EndFrame();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of frames the render thread has drawn since it started.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The frame count.</returns>
+     **************************************************************************************************/
+    static unsigned long GetFramesDrawn();
+
+    /**************************************************************************************************
+     * <summary>Destroys a bitmap once no recorded frame can still draw it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          When the thread is not running the bitmap is destroyed at once. While it runs, the
+     *          bitmap waits until the frame being recorded, or the last one handed over, has been
+     *          drawn, and is then destroyed by the render thread, which has the display. Bitmaps
+     *          are destroyed in the order they were given, so give sub-bitmaps before their parents.
+     *          Use it for every bitmap that may have been drawn in a frame.</remarks>
+     * <param name="bitmap">[in,out] If non-null, the bitmap.</param>
+     **************************************************************************************************/
+    static void DestroyBitmap(ALLEGRO_BITMAP* bitmap);
+
+private:
+    //Creation of object of type RenderThread is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    RenderThread();
+    RenderThread(const RenderThread&);
+    //NO COPYING ALLOWED!
+    RenderThread& operator=(const RenderThread&);
+    ~RenderThread();
+
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,494 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CSoftwareBlitter.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the software blitter class.
+ **************************************************************************************************/
+#include "CSoftwareBlitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <allegro5/allegro.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define A2DE_BLIT_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+//MSVC compiles AVX2 intrinsics anywhere; GCC and Clang need the functions marked.
+#if defined(A2DE_BLIT_X86) && defined(__GNUC__)
+#define A2DE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define A2DE_TARGET_AVX2
+#endif
+
+A2DE_BEGIN
+
+/************************************************************************/
+/* DO NOT DEFINE CONSTRUCTORS, DESTRUCTOR, ASSIGNMENT OPERATOR!         */
+/************************************************************************/
+
+namespace {
+
+    /// <summary> How a row of source pixels is combined with the destination.</summary>
+    struct RowOp {
+        /// <summary> The tint, in the order of the bytes of a pixel in memory.</summary>
+        unsigned char tint[4];
+        /// <summary> false if the tint is white.</summary>
+        bool tinted;
+        /// <summary> true to blend premultiplied over the destination, false to replace it.</summary>
+        bool blend;
+    };
+
+    /// <summary> Combines count source pixels into the destination.</summary>
+    typedef void (*RowKernel)(unsigned int* dst, const unsigned int* src, int count, const RowOp& op);
+    /// <summary> Copies count pixels in reverse order.</summary>
+    typedef void (*ReverseKernel)(unsigned int* dst, const unsigned int* src, int count);
+
+    //Pixels are handled as little-endian 32-bit words with alpha in the top byte.
+
+    inline unsigned int Div255(unsigned int x) {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    void RowScalar(unsigned int* dst, const unsigned int* src, int count, const RowOp& op) {
+        for(int i = 0; i < count; ++i) {
+            unsigned int s = src[i];
+            if(op.tinted == false && op.blend) {
+                if(s >= 0xFF000000u) {
+                    dst[i] = s;
+                    continue;
+                }
+                if(s == 0) continue;
+            }
+            unsigned int c[4];
+            for(int k = 0; k < 4; ++k) {
+                c[k] = (s >> (k * 8)) & 0xFF;
+                if(op.tinted) c[k] = Div255(c[k] * op.tint[k]);
+            }
+            if(op.blend) {
+                unsigned int inverse = 255 - c[3];
+                unsigned int d = dst[i];
+                for(int k = 0; k < 4; ++k) {
+                    c[k] = std::min(c[k] + Div255(((d >> (k * 8)) & 0xFF) * inverse), 255u);
+                }
+            }
+            dst[i] = c[0] | (c[1] << 8) | (c[2] << 16) | (c[3] << 24);
+        }
+    }
+
+    void ReverseScalar(unsigned int* dst, const unsigned int* src, int count) {
+        for(int i = 0; i < count; ++i) {
+            dst[i] = src[count - 1 - i];
+        }
+    }
+
+#ifdef A2DE_BLIT_X86
+
+    inline __m128i Div255Sse2(__m128i x) {
+        x = _mm_add_epi16(x, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+    }
+
+    /// <summary> Two pixels widened to 16 bits per channel.</summary>
+    inline __m128i CombineSse2(__m128i s, __m128i d, __m128i tint, const RowOp& op) {
+        if(op.tinted) s = Div255Sse2(_mm_mullo_epi16(s, tint));
+        if(op.blend == false) return s;
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xFF), 0xFF);
+        __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(255), alpha);
+        return _mm_add_epi16(s, Div255Sse2(_mm_mullo_epi16(d, inverse)));
+    }
+
+    void RowSse2(unsigned int* dst, const unsigned int* src, int count, const RowOp& op) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m128i tint = _mm_setr_epi16(op.tint[0], op.tint[1], op.tint[2], op.tint[3], op.tint[0], op.tint[1], op.tint[2], op.tint[3]);
+        int i = 0;
+        for(; i + 4 <= count; i += 4) {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if(op.tinted == false && op.blend) {
+                //Sprites are mostly fully opaque or fully clear.
+                if(_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alpha_mask), alpha_mask)) == 0xFFFF) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+                    continue;
+                }
+                if(_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF) continue;
+            }
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            __m128i lo = CombineSse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero), tint, op);
+            __m128i hi = CombineSse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero), tint, op);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+        }
+        RowScalar(dst + i, src + i, count - i, op);
+    }
+
+    void ReverseSse2(unsigned int* dst, const unsigned int* src, int count) {
+        int i = 0;
+        for(; i + 4 <= count; i += 4) {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + count - 4 - i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi32(s, _MM_SHUFFLE(0, 1, 2, 3)));
+        }
+        ReverseScalar(dst + i, src, count - i);
+    }
+
+    A2DE_TARGET_AVX2 inline __m256i Div255Avx2(__m256i x) {
+        x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+        return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+    }
+
+    /// <summary> Four pixels widened to 16 bits per channel.</summary>
+    A2DE_TARGET_AVX2 inline __m256i CombineAvx2(__m256i s, __m256i d, __m256i tint, const RowOp& op) {
+        if(op.tinted) s = Div255Avx2(_mm256_mullo_epi16(s, tint));
+        if(op.blend == false) return s;
+        __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xFF), 0xFF);
+        __m256i inverse = _mm256_sub_epi16(_mm256_set1_epi16(255), alpha);
+        return _mm256_add_epi16(s, Div255Avx2(_mm256_mullo_epi16(d, inverse)));
+    }
+
+    A2DE_TARGET_AVX2 void RowAvx2(unsigned int* dst, const unsigned int* src, int count, const RowOp& op) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+        const __m256i tint = _mm256_setr_epi16(op.tint[0], op.tint[1], op.tint[2], op.tint[3], op.tint[0], op.tint[1], op.tint[2], op.tint[3], op.tint[0], op.tint[1], op.tint[2], op.tint[3], op.tint[0], op.tint[1], op.tint[2], op.tint[3]);
+        int i = 0;
+        for(; i + 8 <= count; i += 8) {
+            __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            if(op.tinted == false && op.blend) {
+                if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alpha_mask), alpha_mask)) == -1) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), s);
+                    continue;
+                }
+                if(_mm256_movemask_epi8(_mm256_cmpeq_epi32(s, zero)) == -1) continue;
+            }
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            //Unpacking and packing both work within 128-bit lanes, so the pixels come back in order.
+            __m256i lo = CombineAvx2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero), tint, op);
+            __m256i hi = CombineAvx2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero), tint, op);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+        }
+        RowScalar(dst + i, src + i, count - i, op);
+    }
+
+    A2DE_TARGET_AVX2 void ReverseAvx2(unsigned int* dst, const unsigned int* src, int count) {
+        const __m256i order = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        int i = 0;
+        for(; i + 8 <= count; i += 8) {
+            __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + count - 8 - i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permutevar8x32_epi32(s, order));
+        }
+        ReverseScalar(dst + i, src, count - i);
+    }
+
+    bool CpuHasSse2() {
+#if defined(_M_X64) || defined(__x86_64__)
+        return true;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        return (info[3] & (1 << 26)) != 0;
+#else
+        return __builtin_cpu_supports("sse2") != 0;
+#endif
+    }
+
+    bool CpuHasAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if(info[0] < 7) return false;
+        __cpuid(info, 1);
+        bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+        if(os_saves_ymm == false) return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+
+#endif
+
+    /// <summary> true if the software path is on.</summary>
+    bool enabled = false;
+    /// <summary> The kernel in use.</summary>
+    SoftwareBlitter::KERNEL kernel = SoftwareBlitter::KERNEL_SCALAR;
+    /// <summary> false until the kernel has been chosen.</summary>
+    bool kernel_chosen = false;
+    /// <summary> The row kernel in use.</summary>
+    RowKernel row_kernel = RowScalar;
+    /// <summary> The reverse kernel in use.</summary>
+    ReverseKernel reverse_kernel = ReverseScalar;
+
+    /// <summary> The locked destination, or null outside a session.</summary>
+    ALLEGRO_BITMAP* session_dest = nullptr;
+    /// <summary> The destination's pixels.</summary>
+    ALLEGRO_LOCKED_REGION* dest_region = nullptr;
+    /// <summary> The destination's clipping rectangle within its bounds; right and bottom are exclusive.</summary>
+    int clip_left = 0;
+    int clip_top = 0;
+    int clip_right = 0;
+    int clip_bottom = 0;
+    /// <summary> The translation of the destination's transform.</summary>
+    int offset_x = 0;
+    int offset_y = 0;
+    /// <summary> true if the blender blends, false if it copies.</summary>
+    bool session_blend = true;
+    /// <summary> The locked source, or null.</summary>
+    ALLEGRO_BITMAP* locked_source = nullptr;
+    /// <summary> The source's pixels.</summary>
+    ALLEGRO_LOCKED_REGION* source_region = nullptr;
+    /// <summary> A flipped source row.</summary>
+    std::vector<unsigned int> scratch;
+
+    void ChooseKernel(SoftwareBlitter::KERNEL choice) {
+        kernel = choice;
+        kernel_chosen = true;
+        row_kernel = RowScalar;
+        reverse_kernel = ReverseScalar;
+#ifdef A2DE_BLIT_X86
+        if(choice == SoftwareBlitter::KERNEL_SSE2) {
+            row_kernel = RowSse2;
+            reverse_kernel = ReverseSse2;
+        } else if(choice == SoftwareBlitter::KERNEL_AVX2) {
+            row_kernel = RowAvx2;
+            reverse_kernel = ReverseAvx2;
+        }
+#endif
+    }
+
+    /// <summary> Gets the byte of each channel in memory, or false if the format is not a 32-bit one with alpha on top.</summary>
+    bool GetChannelOrder(int format, int& red, int& green, int& blue) {
+        switch(format) {
+            case ALLEGRO_PIXEL_FORMAT_ARGB_8888:
+                red = 2;
+                green = 1;
+                blue = 0;
+                return true;
+            case ALLEGRO_PIXEL_FORMAT_ABGR_8888:
+            case ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE:
+                red = 0;
+                green = 1;
+                blue = 2;
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool IsMemoryBitmap(ALLEGRO_BITMAP* bitmap) {
+        return (al_get_bitmap_flags(bitmap) & ALLEGRO_MEMORY_BITMAP) != 0;
+    }
+
+    unsigned char ToByte(float channel) {
+        if(channel <= 0.0f) return 0;
+        if(channel >= 1.0f) return 255;
+        return static_cast<unsigned char>(channel * 255.0f + 0.5f);
+    }
+
+    int Round(float value) {
+        return static_cast<int>(std::floor(value + 0.5f));
+    }
+
+    ALLEGRO_LOCKED_REGION* LockSource(ALLEGRO_BITMAP* source) {
+        if(source == locked_source) return source_region;
+        if(locked_source != nullptr) al_unlock_bitmap(locked_source);
+        locked_source = nullptr;
+        //Memory bitmaps lock in their own format without copying.
+        source_region = al_lock_bitmap(source, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_READONLY);
+        if(source_region != nullptr) locked_source = source;
+        return source_region;
+    }
+
+    bool DrawRegion(ALLEGRO_BITMAP* source, float sx, float sy, float sw, float sh, const ALLEGRO_COLOR& tint, float dx, float dy, int flags) {
+        if(flags & ~(ALLEGRO_FLIP_HORIZONTAL | ALLEGRO_FLIP_VERTICAL)) return false;
+        if(source == session_dest || IsMemoryBitmap(source) == false) return false;
+
+        int left = Round(sx);
+        int top = Round(sy);
+        int width = Round(sw);
+        int height = Round(sh);
+        if(width <= 0 || height <= 0) return true;
+        if(left < 0 || top < 0 || left + width > al_get_bitmap_width(source) || top + height > al_get_bitmap_height(source)) return false;
+
+        ALLEGRO_LOCKED_REGION* region = LockSource(source);
+        if(region == nullptr || region->format != dest_region->format) return false;
+
+        int red = 0;
+        int green = 0;
+        int blue = 0;
+        GetChannelOrder(region->format, red, green, blue);
+        RowOp op;
+        op.tint[red] = ToByte(tint.r);
+        op.tint[green] = ToByte(tint.g);
+        op.tint[blue] = ToByte(tint.b);
+        op.tint[3] = ToByte(tint.a);
+        op.tinted = op.tint[0] != 255 || op.tint[1] != 255 || op.tint[2] != 255 || op.tint[3] != 255;
+        op.blend = session_blend;
+
+        int x0 = Round(dx) + offset_x;
+        int y0 = Round(dy) + offset_y;
+        int visible_left = std::max(x0, clip_left);
+        int visible_top = std::max(y0, clip_top);
+        int visible_right = std::min(x0 + width, clip_right);
+        int visible_bottom = std::min(y0 + height, clip_bottom);
+        if(visible_left >= visible_right || visible_top >= visible_bottom) return true;
+
+        bool flip_x = (flags & ALLEGRO_FLIP_HORIZONTAL) != 0;
+        bool flip_y = (flags & ALLEGRO_FLIP_VERTICAL) != 0;
+        int count = visible_right - visible_left;
+        if(flip_x && scratch.size() < static_cast<std::size_t>(count)) scratch.resize(count);
+        //Flipped, the visible columns come from the mirrored span of the source.
+        int first_column = flip_x ? left + width - (visible_right - x0) : left + (visible_left - x0);
+
+        for(int y = visible_top; y < visible_bottom; ++y) {
+            int row = y - y0;
+            int source_row = top + (flip_y ? height - 1 - row : row);
+            const unsigned int* s = reinterpret_cast<const unsigned int*>(static_cast<const char*>(region->data) + source_row * region->pitch) + first_column;
+            unsigned int* d = reinterpret_cast<unsigned int*>(static_cast<char*>(dest_region->data) + y * dest_region->pitch) + visible_left;
+            if(flip_x) {
+                reverse_kernel(&scratch[0], s, count);
+                s = &scratch[0];
+            }
+            if(op.tinted == false && op.blend == false) {
+                std::memcpy(d, s, count * sizeof(unsigned int));
+            } else {
+                row_kernel(d, s, count, op);
+            }
+        }
+        return true;
+    }
+
+}
+
+void SoftwareBlitter::SetEnabled(bool enable) {
+    if(enable == false) End();
+    enabled = enable;
+}
+
+bool SoftwareBlitter::IsEnabled() {
+    return enabled;
+}
+
+SoftwareBlitter::KERNEL SoftwareBlitter::GetBestKernel() {
+#ifdef A2DE_BLIT_X86
+    if(CpuHasAvx2()) return KERNEL_AVX2;
+    if(CpuHasSse2()) return KERNEL_SSE2;
+#endif
+    return KERNEL_SCALAR;
+}
+
+bool SoftwareBlitter::SetKernel(KERNEL choice) {
+    if(choice > GetBestKernel()) return false;
+    ChooseKernel(choice);
+    return true;
+}
+
+SoftwareBlitter::KERNEL SoftwareBlitter::GetKernel() {
+    if(kernel_chosen == false) ChooseKernel(GetBestKernel());
+    return kernel;
+}
+
+const char* SoftwareBlitter::GetKernelName(KERNEL choice) {
+    switch(choice) {
+        case KERNEL_SSE2: return "sse2";
+        case KERNEL_AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+bool SoftwareBlitter::Begin(ALLEGRO_BITMAP* dest) {
+    if(enabled == false || session_dest != nullptr || dest == nullptr) return false;
+    if(IsMemoryBitmap(dest) == false) return false;
+    if(kernel_chosen == false) ChooseKernel(GetBestKernel());
+
+    int op = 0;
+    int source_factor = 0;
+    int dest_factor = 0;
+    int alpha_op = 0;
+    int alpha_source_factor = 0;
+    int alpha_dest_factor = 0;
+    al_get_separate_blender(&op, &source_factor, &dest_factor, &alpha_op, &alpha_source_factor, &alpha_dest_factor);
+    if(op != ALLEGRO_ADD || alpha_op != ALLEGRO_ADD || source_factor != ALLEGRO_ONE || alpha_source_factor != ALLEGRO_ONE || dest_factor != alpha_dest_factor) return false;
+    if(dest_factor != ALLEGRO_ZERO && dest_factor != ALLEGRO_INVERSE_ALPHA) return false;
+    session_blend = dest_factor == ALLEGRO_INVERSE_ALPHA;
+
+    //Transforms and clipping belong to the target, so dest has to be it to read them.
+    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
+    al_set_target_bitmap(dest);
+    const ALLEGRO_TRANSFORM* transform = al_get_current_transform();
+    float tx = transform->m[3][0];
+    float ty = transform->m[3][1];
+    bool translation_only = transform->m[0][0] == 1.0f && transform->m[1][1] == 1.0f && transform->m[0][1] == 0.0f && transform->m[1][0] == 0.0f && tx == std::floor(tx) && ty == std::floor(ty);
+    int clip_x = 0;
+    int clip_y = 0;
+    int clip_width = 0;
+    int clip_height = 0;
+    al_get_clipping_rectangle(&clip_x, &clip_y, &clip_width, &clip_height);
+    al_set_target_bitmap(old_target);
+    if(translation_only == false) return false;
+
+    offset_x = static_cast<int>(tx);
+    offset_y = static_cast<int>(ty);
+    clip_left = std::max(clip_x, 0);
+    clip_top = std::max(clip_y, 0);
+    clip_right = std::min(clip_x + clip_width, al_get_bitmap_width(dest));
+    clip_bottom = std::min(clip_y + clip_height, al_get_bitmap_height(dest));
+
+    dest_region = al_lock_bitmap(dest, ALLEGRO_PIXEL_FORMAT_ANY, ALLEGRO_LOCK_READWRITE);
+    if(dest_region == nullptr) return false;
+    int red = 0;
+    int green = 0;
+    int blue = 0;
+    if(GetChannelOrder(dest_region->format, red, green, blue) == false) {
+        al_unlock_bitmap(dest);
+        dest_region = nullptr;
+        return false;
+    }
+    session_dest = dest;
+    return true;
+}
+
+void SoftwareBlitter::End() {
+    if(locked_source != nullptr) al_unlock_bitmap(locked_source);
+    locked_source = nullptr;
+    source_region = nullptr;
+    if(session_dest != nullptr) al_unlock_bitmap(session_dest);
+    session_dest = nullptr;
+    dest_region = nullptr;
+}
+
+bool SoftwareBlitter::IsActive() {
+    return session_dest != nullptr;
+}
+
+bool SoftwareBlitter::Blit(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* source, float sx, float sy, float sw, float sh, const ALLEGRO_COLOR& tint, float dx, float dy, int flags) {
+    if(enabled == false || dest == nullptr || source == nullptr) return false;
+    if(IsMemoryBitmap(source) == false) {
+        End();
+        return false;
+    }
+
+    bool own_session = false;
+    if(session_dest != dest) {
+        End();
+        if(Begin(dest) == false) return false;
+        own_session = true;
+    }
+    if(DrawRegion(source, sx, sy, sw, sh, tint, dx, dy, flags) == false) {
+        End();
+        return false;
+    }
+    if(own_session) End();
+    return true;
+}
+
+A2DE_END
@@ -0,0 +1,149 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CSoftwareBlitter.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the software blitter class.
+ **************************************************************************************************/
+#ifndef A2DE_CSOFTWAREBLITTER_H
+#define A2DE_CSOFTWAREBLITTER_H
+
+#include "../a2de_vals.h"
+
+#include <allegro5/color.h>
+
+struct ALLEGRO_BITMAP;
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Draws memory bitmaps onto memory bitmaps with SIMD row kernels instead of Allegro's generic per-pixel path.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Off until enabled. For machines without a GPU, where every bitmap is a memory bitmap.
+ *          SpriteHandler, TileSet and TileMap try it first and fall back to Allegro for anything
+ *          it does not handle. It handles unscaled, unrotated, optionally flipped and tinted
+ *          regions of 32-bit bitmaps, where source and destination share a pixel format. The
+ *          destination's transform must be a whole-pixel translation and its blender either
+ *          copy (ONE, ZERO) or Allegro's default premultiplied blend (ONE, INVERSE_ALPHA).
+ *          Between Begin and End the destination stays locked so a batch pays for one lock.
+ *          Results can differ from Allegro's by one step per channel from rounding.</remarks>
+ **************************************************************************************************/
+class SoftwareBlitter {
+public:
+
+    /**************************************************************************************************
+     * <summary>Values that represent the row kernels.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    enum KERNEL {
+        /// <summary> Plain C++, one pixel at a time.</summary>
+        KERNEL_SCALAR,
+        /// <summary> SSE2, four pixels at a time.</summary>
+        KERNEL_SSE2,
+        /// <summary> AVX2, eight pixels at a time.</summary>
+        KERNEL_AVX2,
+    };
+
+    /**************************************************************************************************
+     * <summary>Turns the software path on or off.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Turning it off ends a session in progress.</remarks>
+     * <param name="enabled">true to enable, false to disable.</param>
+     **************************************************************************************************/
+    static void SetEnabled(bool enabled);
+
+    /**************************************************************************************************
+     * <summary>Query if the software path is on.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if enabled, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsEnabled();
+
+    /**************************************************************************************************
+     * <summary>Gets the fastest kernel this processor supports.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The kernel.</returns>
+     **************************************************************************************************/
+    static KERNEL GetBestKernel();
+
+    /**************************************************************************************************
+     * <summary>Chooses the kernel. The best one is used by default.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="kernel">The kernel.</param>
+     * <returns>true if it succeeds, false if this processor does not support it.</returns>
+     **************************************************************************************************/
+    static bool SetKernel(KERNEL kernel);
+
+    /**************************************************************************************************
+     * <summary>Gets the kernel in use.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The kernel.</returns>
+     **************************************************************************************************/
+    static KERNEL GetKernel();
+
+    /**************************************************************************************************
+     * <summary>Gets the name of a kernel.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="kernel">The kernel.</param>
+     * <returns>"scalar", "sse2" or "avx2".</returns>
+     **************************************************************************************************/
+    static const char* GetKernelName(KERNEL kernel);
+
+    /**************************************************************************************************
+     * <summary>Locks a destination for a run of Blit calls.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Reads dest's transform, clipping rectangle and the blender first, so set those
+     *          before calling it. dest cannot be drawn to with Allegro until End.</remarks>
+     * <param name="dest">[in,out] If non-null, the destination bitmap.</param>
+     * <returns>true if it succeeds, false if disabled, a session is in progress, or dest is not a bitmap it can draw to.</returns>
+     **************************************************************************************************/
+    static bool Begin(ALLEGRO_BITMAP* dest);
+
+    /**************************************************************************************************
+     * <summary>Unlocks the destination and the last source. Does nothing outside a session.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    static void End();
+
+    /**************************************************************************************************
+     * <summary>Query if a session is in progress.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if between Begin and End, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsActive();
+
+    /**************************************************************************************************
+     * <summary>Draws a region of a bitmap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Takes the arguments of al_draw_tinted_bitmap_region. Outside a session on dest it
+     *          locks and unlocks dest itself. When it returns false nothing was drawn and any
+     *          session has been ended, so the caller can draw the region with Allegro.</remarks>
+     * <param name="dest">  [in,out] If non-null, the destination bitmap.</param>
+     * <param name="source">[in,out] If non-null, the source bitmap.</param>
+     * <param name="sx">    The left edge of the region.</param>
+     * <param name="sy">    The top edge of the region.</param>
+     * <param name="sw">    The width of the region.</param>
+     * <param name="sh">    The height of the region.</param>
+     * <param name="tint">  The tint.</param>
+     * <param name="dx">    The x coordinate to draw the region's left edge at.</param>
+     * <param name="dy">    The y coordinate to draw the region's top edge at.</param>
+     * <param name="flags"> The ALLEGRO_FLIP flags.</param>
+     * <returns>true if it was drawn, false if the software path cannot draw it.</returns>
+     **************************************************************************************************/
+    static bool Blit(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* source, float sx, float sy, float sw, float sh, const ALLEGRO_COLOR& tint, float dx, float dy, int flags);
+
+private:
+    //Creation of object of type SoftwareBlitter is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    SoftwareBlitter();
+    SoftwareBlitter(const SoftwareBlitter&);
+    //NO COPYING ALLOWED!
+    SoftwareBlitter& operator=(const SoftwareBlitter&);
+    ~SoftwareBlitter();
+
+};
+
+A2DE_END
+
+#endif
@@ -12,12 +12,16 @@
 #include "../Math/CRectangle.h"
 #include "../Math/CMiscMath.h"
 #include "../a2de_exceptions.h"
+#include <cmath>
 #include <fstream>
 #include <string>
 #include <allegro5/bitmap.h>
 #include <allegro5/fshook.h>
 
+#include "CAssetPack.h"
 #include "CBitmapCache.h"
+#include "CDirtyRegions.h"
+#include "CRenderCommandList.h"
 
 A2DE_BEGIN
 
@@ -33,7 +37,7 @@ A2DE_BEGIN
 
 Sprite* Sprite::CreateSprite(const std::string& file) {
     if(file.empty() == false) {
-        if(al_filename_exists(file.c_str()) == false) {
+        if(AssetPack::FileExists(file) == false) {
             throw FileNotFoundException(file);
         }
     } else {
@@ -61,7 +65,10 @@ Sprite::Sprite(const std::string& name, ALLEGRO_BITMAP* file) throw(...)
     _angle(0.0),
     _radius(0),
     _tint(al_map_rgba(255, 255, 255, 255)),
-    _axis(a2de::SpriteHandler::AXIS_NONE) {
+    _axis(a2de::SpriteHandler::AXIS_NONE),
+    _useCollisionMask(false),
+    _drawnView(),
+    _drawn(false) {
         BitmapCache::StoreBitmap(const_cast<std::string&>(name), file);
         _image = BitmapCache::RetrieveBitmap(const_cast<std::string&>(name));
         if(_image != nullptr) {
@@ -84,7 +91,10 @@ Sprite::Sprite(const std::string& file)
     _angle(0.0),
     _radius(0),
     _tint(al_map_rgba(255, 255, 255, 255)),
-    _axis(a2de::SpriteHandler::AXIS_NONE) {
+    _axis(a2de::SpriteHandler::AXIS_NONE),
+    _useCollisionMask(false),
+    _drawnView(),
+    _drawn(false) {
         if(_image != nullptr) {
             _dimensions = Vector2D(al_get_bitmap_width(_image), al_get_bitmap_height(_image));
             _frameDimensions = _dimensions;
@@ -104,7 +114,10 @@ Sprite::Sprite(const Sprite& sprite)
     _angle(sprite._angle),
     _radius(sprite._radius),
     _tint(sprite._tint),
-    _axis(sprite._axis) {
+    _axis(sprite._axis),
+    _useCollisionMask(sprite._useCollisionMask),
+    _drawnView(),
+    _drawn(false) {
         if(_image != nullptr) {
             _dimensions = Vector2D(al_get_bitmap_width(_image), al_get_bitmap_height(_image));
             _frameDimensions = _dimensions;
@@ -128,13 +141,31 @@ std::string& Sprite::GetFilename() {
 }
 
 ALLEGRO_BITMAP* Sprite::GetImage() const {
+    //Sprites created while their file loads asynchronously hold the cache's placeholder until it is ready.
+    if(BitmapCache::IsPlaceholder(_image)) {
+        ALLEGRO_BITMAP* loaded = BitmapCache::PeekBitmap(_file);
+        if(loaded != nullptr) return loaded;
+    }
     return _image;
 }
 
 ALLEGRO_BITMAP* Sprite::GetImage() {
+    if(BitmapCache::IsPlaceholder(_image)) ResolvePlaceholder();
     return static_cast<const Sprite&>(*this).GetImage();
 }
 
+void Sprite::ResolvePlaceholder() {
+    ALLEGRO_BITMAP* loaded = BitmapCache::PeekBitmap(_file);
+    if(loaded == nullptr || BitmapCache::IsPlaceholder(loaded)) return;
+
+    Vector2D old_dimensions(_dimensions);
+    _image = loaded;
+    _dimensions = Vector2D(al_get_bitmap_width(_image), al_get_bitmap_height(_image));
+    //Only follow the new size where it was still derived from the placeholder's.
+    if(_frameDimensions == old_dimensions) _frameDimensions = _dimensions;
+    if(_center == Vector2D(old_dimensions.GetX() / 2, old_dimensions.GetY() / 2)) _center = Vector2D(_dimensions.GetX() / 2, _dimensions.GetY() / 2);
+}
+
 double Sprite::GetX() const {
     return _position.GetX();
 }
@@ -171,7 +202,9 @@ int Sprite::GetHeight() {
 }
 
 void Sprite::SetTint(const ALLEGRO_COLOR& tint) {
+    if(_tint.r == tint.r && _tint.g == tint.g && _tint.b == tint.b && _tint.a == tint.a) return;
     _tint = tint;
+    InvalidateDrawnArea();
 }
 const ALLEGRO_COLOR& Sprite::GetTint() const {
     return _tint;
@@ -237,7 +270,9 @@ unsigned char Sprite::GetAlpha() {
 }
 
 void Sprite::SetAlpha(unsigned char alpha) {
+    if(_tint.a == alpha) return;
     _tint.a = alpha;
+    InvalidateDrawnArea();
 }
 
 void Sprite::SetPosition(double x, double y) {
@@ -312,6 +347,7 @@ Sprite& Sprite::operator=(const Sprite& rhs) {
     this->_radius = rhs._radius;
     this->_tint = rhs._tint;
     this->_axis = rhs._axis;
+    this->_useCollisionMask = rhs._useCollisionMask;
     return *this;
 }
 
@@ -328,6 +364,12 @@ SpriteHandler::SPRITEAXIS Sprite::GetFlipAxis() {
 }
 
 void Sprite::Draw(ALLEGRO_BITMAP* dest) {
+    if(DirtyRegions::IsEnabled()) {
+        RenderCommandList* list = RenderCommandList::GetRecording();
+        al_copy_transform(&_drawnView, list != nullptr ? &list->GetView() : al_get_current_transform());
+        _drawn = true;
+    }
+
     bool hasRadius = a2de::Math::IsEqual(this->GetRotationRadius(), 0.0) == false;
     bool hasRotation = a2de::Math::IsEqual(this->GetAngle(), 0.0) == false;
     bool isFlipped = this->GetFlipAxis() != a2de::SpriteHandler::AXIS_NONE;
@@ -362,6 +404,51 @@ void Sprite::Draw(ALLEGRO_BITMAP* dest) {
     }
 }
 
+void Sprite::InvalidateDrawnArea() const {
+    if(_drawn == false || DirtyRegions::IsEnabled() == false) return;
+
+    //The draw calls place the frame at the sprite's position; turned or offset by a radius, it
+    //stays within its diagonal plus the radius of that point.
+    double width = GetWidth() * std::fabs(_scaleDimensions.GetX());
+    double height = GetHeight() * std::fabs(_scaleDimensions.GetY());
+    double left = _position.GetX();
+    double top = _position.GetY();
+    double right = left + width;
+    double bottom = top + height;
+    if(Math::IsEqual(_angle, 0.0) == false || Math::IsEqual(_radius, 0.0) == false) {
+        double reach = std::sqrt(width * width + height * height) + std::fabs(_radius);
+        left = _position.GetX() - reach;
+        top = _position.GetY() - reach;
+        right = _position.GetX() + reach;
+        bottom = _position.GetY() + reach;
+    }
+
+    float corners[4][2] = { { static_cast<float>(left), static_cast<float>(top) }, { static_cast<float>(right), static_cast<float>(top) },
+                            { static_cast<float>(left), static_cast<float>(bottom) }, { static_cast<float>(right), static_cast<float>(bottom) } };
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+    for(int i = 0; i < 4; ++i) {
+        al_transform_coordinates(&_drawnView, &corners[i][0], &corners[i][1]);
+        if(i == 0 || corners[i][0] < min_x) min_x = corners[i][0];
+        if(i == 0 || corners[i][1] < min_y) min_y = corners[i][1];
+        if(i == 0 || corners[i][0] > max_x) max_x = corners[i][0];
+        if(i == 0 || corners[i][1] > max_y) max_y = corners[i][1];
+    }
+    DirtyRegions::Invalidate(min_x - 2.0, min_y - 2.0, max_x - min_x + 4.0, max_y - min_y + 4.0);
+}
+
+bool Sprite::GenerateCollisionMask() {
+    _useCollisionMask = true;
+    return BitmapCache::GetCollisionMask(_file) != nullptr;
+}
+
+const CollisionMask* Sprite::GetCollisionMask() {
+    if(_useCollisionMask == false) return nullptr;
+    return BitmapCache::GetCollisionMask(_file);
+}
+
 /*****************************
 *  ANIMATED SPRITE OVERRIDES *
 *****************************/
@@ -405,5 +492,9 @@ void Sprite::ResizeFrame(unsigned int /*width*/, unsigned int /*height*/) {
     /* DO NOTHING */
 }
 
+void Sprite::SetFrameRegion(int /*x*/, int /*y*/, int /*width*/, int /*height*/) {
+    /* DO NOTHING */
+}
+
 
 A2DE_END
\ No newline at end of file
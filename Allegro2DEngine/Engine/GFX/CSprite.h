@@ -11,6 +11,7 @@
 #include "../a2de_vals.h"
 #include <allegro5/drawing.h>
 #include <allegro5/color.h>
+#include <allegro5/transformations.h>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -24,6 +25,8 @@ struct ALLEGRO_BITMAP;
 
 A2DE_BEGIN
 
+class CollisionMask;
+
 /**************************************************************************************************
  * <summary>Sprite.</summary>
  * <remarks>Casey Ugone, 8/1/2011.</remarks>
@@ -89,7 +92,9 @@ public:
 
     /**************************************************************************************************
      * <summary>Gets the image.</summary>
-     * <remarks>Casey Ugone, 6/30/2012.</remarks>
+     * <remarks>Casey Ugone, 6/30/2012.
+     *          If the file was loading asynchronously when the Sprite was created and has since
+     *          finished, the Sprite switches to the loaded bitmap and its dimensions.</remarks>
      * <returns>null if it fails, else returns a pointer to the underlying ALLEGRO_BITMAP structure of the Sprite object.</returns>
      **************************************************************************************************/
     virtual ALLEGRO_BITMAP* GetImage();
@@ -473,8 +478,32 @@ public:
 
     virtual void Draw(ALLEGRO_BITMAP* dest);
 
+    /**************************************************************************************************
+     * <summary>Builds the sprite's collision mask and turns it on. Call it while loading.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The mask is kept with the bitmap in the BitmapCache, so sprites of the same file
+     *          share it. An animated sprite builds one mask per frame of its animations.</remarks>
+     * <returns>true if it succeeds, false if the bitmap is still loading; the mask is built when first asked for.</returns>
+     **************************************************************************************************/
+    virtual bool GenerateCollisionMask();
+
+    /**************************************************************************************************
+     * <summary>Gets the collision mask of what the sprite shows.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Hand it to RigidBody::SetCollisionMask for pixel-perfect contacts. An animated
+     *          sprite's mask changes with its frame.</remarks>
+     * <returns>null if GenerateCollisionMask was not called or the bitmap is still loading, else the mask.</returns>
+     **************************************************************************************************/
+    virtual const CollisionMask* GetCollisionMask();
+
 protected:
 
+    /**************************************************************************************************
+     * <summary>Replaces the BitmapCache placeholder with the loaded bitmap once it is ready.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void ResolvePlaceholder();
+
     /// <summary> The file path and name</summary>
     std::string _file;
     /// <summary> The sheet dimensions </summary>
@@ -498,6 +527,21 @@ protected:
     ALLEGRO_COLOR _tint;
     /// <summary> The flip axis </summary>
     SpriteHandler::SPRITEAXIS _axis;
+    /// <summary> true once GenerateCollisionMask has been called </summary>
+    bool _useCollisionMask;
+    /// <summary> The target's transform when last drawn while DirtyRegions was enabled </summary>
+    ALLEGRO_TRANSFORM _drawnView;
+    /// <summary> true once _drawnView is set </summary>
+    bool _drawn;
+
+    /**************************************************************************************************
+     * <summary>Invalidates the DirtyRegions the sprite covers where it was last drawn.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Call it before and after changing how the sprite looks. The area is worked out from
+     *          the current position, frame, scale, and rotation and errs on the large side; a
+     *          sprite that has not been drawn since DirtyRegions was enabled invalidates nothing.</remarks>
+     **************************************************************************************************/
+    void InvalidateDrawnArea() const;
 
     /**************************************************************************************************
      * <summary>Calculates the center of the frame.</summary>
@@ -557,6 +601,17 @@ protected:
      **************************************************************************************************/
     virtual void ResizeFrame(unsigned int width, unsigned int height);
 
+    /**************************************************************************************************
+     * <summary>Sets the region of the sheet shown as the current frame.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <remarks>Does nothing if called on a Sprite object.</remarks>
+     * <param name="x">     The left edge of the frame on the sheet.</param>
+     * <param name="y">     The top edge of the frame on the sheet.</param>
+     * <param name="width"> The width.</param>
+     * <param name="height">The height.</param>
+     **************************************************************************************************/
+    virtual void SetFrameRegion(int x, int y, int width, int height);
+
 private:
 
     friend AnimationHandler;
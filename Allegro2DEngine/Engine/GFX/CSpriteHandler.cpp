@@ -15,12 +15,16 @@
 
 #include "CSprite.h"
 #include "../Math/CMiscMath.h"
+#include "../Math/CVector2D.h"
 #include "../Math/CShape.h"
 #include "../Math/CRectangle.h"
 #include "../Math/CTransform2D.h"
 #include "../Math/CMatrix4x4.h"
 #include <algorithm>
+#include <cassert>
 #include "CGameWindow.h"
+#include "CRenderCommandList.h"
+#include "CSoftwareBlitter.h"
 
 
 A2DE_BEGIN
@@ -29,6 +33,55 @@ A2DE_BEGIN
 /* DO NOT DEFINE CONSTRUCTORS, DESTRUCTOR, ASSIGNMENT OPERATOR!         */
 /************************************************************************/
 
+namespace {
+
+    /// <summary> A deferred draw of one bitmap region.</summary>
+    struct BatchItem {
+        ALLEGRO_BITMAP* source;
+        ALLEGRO_BITMAP* sheet;
+        float sx, sy, sw, sh;
+        ALLEGRO_COLOR tint;
+        float cx, cy;
+        float dx, dy;
+        float xscale, yscale;
+        float angle;
+        int flags;
+    };
+
+    /// <summary> The batch's destination, or null when no batch is in progress.</summary>
+    ALLEGRO_BITMAP* batch_target = nullptr;
+    /// <summary> true to group the batch by source bitmap.</summary>
+    bool batch_sort_by_bitmap = true;
+    /// <summary> The pending draws. Storage is kept between batches.</summary>
+    std::vector<BatchItem> batch_items;
+
+    /**************************************************************************************************
+     * <summary>Records a bitmap region draw if a RenderCommandList is recording.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Takes the arguments of al_draw_tinted_scaled_rotated_bitmap_region plus an optional
+     *          transform applied after them, standing in for one composed onto dest's.</remarks>
+     * <returns>true if it was recorded and must not be drawn, false to draw it now.</returns>
+     **************************************************************************************************/
+    bool RecordRegion(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* source, float sx, float sy, float sw, float sh, const ALLEGRO_COLOR& tint, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags, const ALLEGRO_TRANSFORM* world) {
+        a2de::RenderCommandList* list = a2de::RenderCommandList::GetRecording();
+        if(list == nullptr) return false;
+        ALLEGRO_TRANSFORM transform;
+        al_identity_transform(&transform);
+        al_translate_transform(&transform, -cx, -cy);
+        al_scale_transform(&transform, xscale, yscale);
+        al_rotate_transform(&transform, angle);
+        al_translate_transform(&transform, dx, dy);
+        if(world != nullptr) al_compose_transform(&transform, world);
+        list->AddBitmap(dest, source, sx, sy, sw, sh, tint, transform, flags);
+        return true;
+    }
+
+    bool RecordBitmap(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* source, const ALLEGRO_COLOR& tint, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags, const ALLEGRO_TRANSFORM* world) {
+        if(source == nullptr) return false;
+        return RecordRegion(dest, source, 0.0f, 0.0f, static_cast<float>(al_get_bitmap_width(source)), static_cast<float>(al_get_bitmap_height(source)), tint, cx, cy, dx, dy, xscale, yscale, angle, flags, world);
+    }
+}
+
 void SpriteHandler::Draw(ALLEGRO_BITMAP* dest, Shape* object) {
     if(object == nullptr || dest == nullptr) return;
     object->Draw(dest, object->GetColor(), object->IsFilled());
@@ -47,6 +100,9 @@ void SpriteHandler::Draw(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* source, double x,
     unsigned char b = tintColor.b * 255.0;
     if(a2de::Math::IsEqual(tintColor.a, 0.0)) return;
 
+    if(RecordBitmap(dest, source, al_map_rgba(r, g, b, alpha), 0.0f, 0.0f, a2de::Math::ToScreenScale(x), a2de::Math::ToScreenScale(y), 1.0f, 1.0f, 0.0f, 0, nullptr)) return;
+    if(a2de::SoftwareBlitter::Blit(dest, source, 0.0f, 0.0f, static_cast<float>(al_get_bitmap_width(source)), static_cast<float>(al_get_bitmap_height(source)), al_map_rgba(r, g, b, alpha), a2de::Math::ToScreenScale(x), a2de::Math::ToScreenScale(y), 0)) return;
+
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
@@ -70,6 +126,9 @@ void SpriteHandler::DrawFlip(ALLEGRO_BITMAP* dest, Sprite* sprite, SpriteHandler
 
     if(alpha == 0) return;
 
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(r, g, b, alpha), 0.0f, 0.0f, a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), 1.0f, 1.0f, 0.0f, axis, nullptr)) return;
+    if(a2de::SoftwareBlitter::Blit(dest, sprite->GetImage(), 0.0f, 0.0f, static_cast<float>(al_get_bitmap_width(sprite->GetImage())), static_cast<float>(al_get_bitmap_height(sprite->GetImage())), al_map_rgba(r, g, b, alpha), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), axis)) return;
+
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
@@ -89,6 +148,8 @@ void SpriteHandler::DrawRotate(ALLEGRO_BITMAP* dest, Sprite* sprite) {
 
     if(alpha == 0) return;
 
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(r, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), sprite->GetX(), sprite->GetY(), 1.0f, 1.0f, sprite->GetAngle(), 0, nullptr)) return;
+
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
@@ -108,6 +169,8 @@ void SpriteHandler::DrawRotateScale(ALLEGRO_BITMAP* dest, Sprite* sprite) {
 
     if(alpha == 0) return;
 
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(r, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), a2de::Math::ToScreenScale(sprite->GetScaleX()), a2de::Math::ToScreenScale(sprite->GetScaleY()), sprite->GetAngle(), 0, nullptr)) return;
+
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
@@ -126,6 +189,8 @@ void SpriteHandler::DrawRotateFlip(ALLEGRO_BITMAP* dest, Sprite* sprite, SpriteH
 
     if(alpha == 0) return;
 
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(r, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), 1.0f, 1.0f, sprite->GetAngle(), axis, nullptr)) return;
+
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
@@ -144,6 +209,8 @@ void SpriteHandler::DrawRotateScaleFlip(ALLEGRO_BITMAP* dest, Sprite* sprite, Sp
 
     if(alpha == 0) return;
 
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(r, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), a2de::Math::ToScreenScale(sprite->GetScaleX()), a2de::Math::ToScreenScale(sprite->GetScaleY()), sprite->GetAngle(), axis, nullptr)) return;
+
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
@@ -163,6 +230,8 @@ void SpriteHandler::DrawScale(ALLEGRO_BITMAP* dest, Sprite* sprite) {
 
     if(alpha == 0) return;
 
+    if(RecordRegion(dest, sprite->GetImage(), 0.0f, 0.0f, sprite->GetWidth(), sprite->GetHeight(), al_map_rgba(r, g, b, alpha), 0.0f, 0.0f, a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), a2de::Math::ToScreenScale(sprite->GetWidth() * sprite->GetScaleX()) / sprite->GetWidth(), a2de::Math::ToScreenScale(sprite->GetHeight() * sprite->GetY()) / sprite->GetHeight(), 0.0f, 0, nullptr)) return;
+
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
@@ -212,22 +281,26 @@ void SpriteHandler::DrawRotateWorldSpace(ALLEGRO_BITMAP* dest, Sprite* sprite, d
     allegro_t.m[3][2] = m.GetIndex(14);
     allegro_t.m[3][3] = m.GetIndex(15);
 
-    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
-    al_use_transform(&allegro_t);
+    unsigned char red = sprite->GetTint().r * 255.0;
+    unsigned char g = sprite->GetTint().g * 255.0;
+    unsigned char b = sprite->GetTint().b * 255.0;
 
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), 1.0f, 1.0f, sprite->GetAngle(), 0, &allegro_t)) return;
+
+    //Transforms belong to the target bitmap; compose onto dest's so a caller's view transform still applies.
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
-    unsigned char red = sprite->GetTint().r * 255.0;
-    unsigned char g = sprite->GetTint().g * 255.0;
-    unsigned char b = sprite->GetTint().b * 255.0;
+    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
+    al_compose_transform(&allegro_t, &old_transform);
+    al_use_transform(&allegro_t);
 
     al_draw_tinted_rotated_bitmap(sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetAngle(), 0);
 
-    al_set_target_bitmap(old_target_bmp);
-
     al_use_transform(&old_transform);
 
+    al_set_target_bitmap(old_target_bmp);
+
 }
 
 void SpriteHandler::DrawRotateWorldSpaceScale(ALLEGRO_BITMAP* dest, Sprite* sprite, double x, double y, double /*radius*/) {
@@ -273,18 +346,21 @@ void SpriteHandler::DrawRotateWorldSpaceScale(ALLEGRO_BITMAP* dest, Sprite* spri
     allegro_t.m[3][2] = m.GetIndex(14);
     allegro_t.m[3][3] = m.GetIndex(15);
 
-    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
-    al_use_transform(&allegro_t);
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetScaleX(), sprite->GetScaleY(), sprite->GetAngle(), 0, &allegro_t)) return;
 
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
-    al_draw_tinted_scaled_rotated_bitmap(sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetScaleX(), sprite->GetScaleY(), sprite->GetAngle(), 0);
+    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
+    al_compose_transform(&allegro_t, &old_transform);
+    al_use_transform(&allegro_t);
 
-    al_set_target_bitmap(old_target_bmp);
+    al_draw_tinted_scaled_rotated_bitmap(sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetScaleX(), sprite->GetScaleY(), sprite->GetAngle(), 0);
 
     al_use_transform(&old_transform);
 
+    al_set_target_bitmap(old_target_bmp);
+
 }
 void SpriteHandler::DrawRotateWorldSpaceFlip(ALLEGRO_BITMAP* dest, Sprite* sprite, double x, double y, double /*radius*/, SpriteHandler::SPRITEAXIS axis) {
     if(sprite == nullptr || dest == nullptr) return;
@@ -329,18 +405,21 @@ void SpriteHandler::DrawRotateWorldSpaceFlip(ALLEGRO_BITMAP* dest, Sprite* sprit
     allegro_t.m[3][2] = m.GetIndex(14);
     allegro_t.m[3][3] = m.GetIndex(15);
 
-    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
-    al_use_transform(&allegro_t);
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), 1.0f, 1.0f, sprite->GetAngle(), axis, &allegro_t)) return;
 
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
-    al_draw_tinted_rotated_bitmap(sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetAngle(), axis);
+    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
+    al_compose_transform(&allegro_t, &old_transform);
+    al_use_transform(&allegro_t);
 
-    al_set_target_bitmap(old_target_bmp);
+    al_draw_tinted_rotated_bitmap(sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetAngle(), axis);
 
     al_use_transform(&old_transform);
 
+    al_set_target_bitmap(old_target_bmp);
+
 }
 
 void SpriteHandler::DrawRotateWorldSpaceScaleFlip(ALLEGRO_BITMAP* dest, Sprite* sprite, double x, double y, double /*radius*/, SpriteHandler::SPRITEAXIS axis) {
@@ -386,18 +465,160 @@ void SpriteHandler::DrawRotateWorldSpaceScaleFlip(ALLEGRO_BITMAP* dest, Sprite*
     allegro_t.m[3][2] = m.GetIndex(14);
     allegro_t.m[3][3] = m.GetIndex(15);
 
-    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
-    al_use_transform(&allegro_t);
+    if(RecordBitmap(dest, sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetScaleX(), sprite->GetScaleY(), sprite->GetAngle(), axis, &allegro_t)) return;
 
     ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
     al_set_target_bitmap(dest);
 
+    ALLEGRO_TRANSFORM old_transform = *al_get_current_transform();
+    al_compose_transform(&allegro_t, &old_transform);
+    al_use_transform(&allegro_t);
+
     al_draw_tinted_scaled_rotated_bitmap(sprite->GetImage(), al_map_rgba(red, g, b, alpha), sprite->GetCenterX(), sprite->GetCenterY(), a2de::Math::ToScreenScale(sprite->GetX()), a2de::Math::ToScreenScale(sprite->GetY()), sprite->GetScaleX(), sprite->GetScaleY(), sprite->GetAngle(), axis);
 
+    al_use_transform(&old_transform);
+
     al_set_target_bitmap(old_target_bmp);
 
-    al_use_transform(&old_transform);
+}
+
+bool SpriteHandler::BeginBatch(ALLEGRO_BITMAP* dest) {
+    return BeginBatch(dest, true);
+}
+
+bool SpriteHandler::BeginBatch(ALLEGRO_BITMAP* dest, bool sort_by_bitmap) {
+    if(dest == nullptr || batch_target != nullptr) return false;
+    batch_target = dest;
+    batch_sort_by_bitmap = sort_by_bitmap;
+    batch_items.clear();
+    return true;
+}
+
+bool SpriteHandler::AddToBatch(Sprite* sprite) {
+    if(sprite == nullptr) return false;
+
+    ALLEGRO_BITMAP* image = sprite->GetImage();
+    if(image == nullptr) return false;
+
+    const ALLEGRO_COLOR& tint = sprite->GetTint();
+    unsigned char alpha = sprite->GetAlpha() * 255.0;
+    unsigned char r = tint.r * 255.0;
+    unsigned char g = tint.g * 255.0;
+    unsigned char b = tint.b * 255.0;
+
+    //Same rules as Sprite::Draw: unrotated sprites are placed by their top-left corner, rotated ones
+    //by their center, and the scale only applies when neither axis is 1. A rotation radius needs a
+    //transform of its own, which batched items do not have.
+    if(a2de::Math::IsEqual(sprite->GetRotationRadius(), 0.0) == false) return false;
+    bool hasRotation = a2de::Math::IsEqual(sprite->GetAngle(), 0.0) == false;
+    bool isScaled = (a2de::Math::IsEqual(sprite->GetScaleX(), 1.0) || a2de::Math::IsEqual(sprite->GetScaleY(), 1.0)) == false;
+    a2de::Vector2D center(hasRotation ? sprite->GetCenterX() : 0.0, hasRotation ? sprite->GetCenterY() : 0.0);
+    a2de::Vector2D scale(isScaled ? sprite->GetScaleX() : 1.0, isScaled ? sprite->GetScaleY() : 1.0);
+
+    if(AddToBatch(image, a2de::Vector2D(0.0, 0.0), a2de::Vector2D(al_get_bitmap_width(image), al_get_bitmap_height(image)), al_map_rgba(r, g, b, alpha), center, sprite->GetPosition(), scale, sprite->GetAngle(), sprite->GetFlipAxis()) == false) return false;
+
+    //The batched vertex color must be the one the unbatched draws pass to Allegro.
+    const ALLEGRO_COLOR& batched = batch_items.back().tint;
+    ALLEGRO_COLOR unbatched = al_map_rgba(static_cast<unsigned char>(sprite->GetTint().r * 255.0), static_cast<unsigned char>(sprite->GetTint().g * 255.0), static_cast<unsigned char>(sprite->GetTint().b * 255.0), static_cast<unsigned char>(sprite->GetAlpha() * 255.0));
+    assert(batched.r == unbatched.r && batched.g == unbatched.g && batched.b == unbatched.b && batched.a == unbatched.a);
+    (void)batched;
+    (void)unbatched;
+    return true;
+}
+
+bool SpriteHandler::AddToBatch(ALLEGRO_BITMAP* source, double x, double y, ALLEGRO_COLOR tintColor) {
+    if(source == nullptr) return false;
+    return AddToBatch(source, a2de::Vector2D(0.0, 0.0), a2de::Vector2D(al_get_bitmap_width(source), al_get_bitmap_height(source)), tintColor, a2de::Vector2D(0.0, 0.0), a2de::Vector2D(x, y), a2de::Vector2D(1.0, 1.0), 0.0, SpriteHandler::AXIS_NONE);
+}
+
+bool SpriteHandler::AddToBatch(ALLEGRO_BITMAP* source, const a2de::Vector2D& source_position, const a2de::Vector2D& source_dimensions, ALLEGRO_COLOR tintColor, const a2de::Vector2D& center, const a2de::Vector2D& position, const a2de::Vector2D& scale, double angle, SpriteHandler::SPRITEAXIS axis) {
+    if(batch_target == nullptr || source == nullptr) return false;
+    if(a2de::Math::IsEqual(tintColor.a, 0.0)) return false;
+
+    BatchItem item;
+    item.source = source;
+    ALLEGRO_BITMAP* parent = al_get_parent_bitmap(source);
+    item.sheet = parent ? parent : source;
+    item.sx = static_cast<float>(source_position.GetX());
+    item.sy = static_cast<float>(source_position.GetY());
+    item.sw = static_cast<float>(source_dimensions.GetX());
+    item.sh = static_cast<float>(source_dimensions.GetY());
+    item.tint = tintColor;
+    item.cx = static_cast<float>(center.GetX());
+    item.cy = static_cast<float>(center.GetY());
+    item.dx = static_cast<float>(a2de::Math::ToScreenScale(position.GetX()));
+    item.dy = static_cast<float>(a2de::Math::ToScreenScale(position.GetY()));
+    item.xscale = static_cast<float>(scale.GetX());
+    item.yscale = static_cast<float>(scale.GetY());
+    item.angle = static_cast<float>(angle);
+    item.flags = axis; //SpriteHandler::SPRITEAXIS maps directly to ALLEGRO_FLIP values.
+    batch_items.push_back(item);
+    return true;
+}
+
+std::size_t SpriteHandler::EndBatch() {
+    if(batch_target == nullptr) return 0;
+
+    if(batch_sort_by_bitmap) {
+        //Stable so sprites on the same sheet keep their submission order.
+        std::stable_sort(batch_items.begin(), batch_items.end(), [](const BatchItem& a, const BatchItem& b)->bool { return a.sheet < b.sheet; });
+    }
+
+    //A recorded batch still batches: the list draws runs of one bitmap in one call on playback.
+    if(a2de::RenderCommandList::GetRecording() != nullptr) {
+        std::size_t recorded_runs = 0;
+        ALLEGRO_BITMAP* recorded_sheet = nullptr;
+        std::size_t recorded_count = batch_items.size();
+        for(std::size_t i = 0; i < recorded_count; ++i) {
+            const BatchItem& item = batch_items[i];
+            if(item.sheet != recorded_sheet) {
+                ++recorded_runs;
+                recorded_sheet = item.sheet;
+            }
+            RecordRegion(batch_target, item.source, item.sx, item.sy, item.sw, item.sh, item.tint, item.cx, item.cy, item.dx, item.dy, item.xscale, item.yscale, item.angle, item.flags, nullptr);
+        }
+        batch_items.clear();
+        batch_target = nullptr;
+        return recorded_runs;
+    }
+
+    ALLEGRO_BITMAP* old_target_bmp = al_get_target_bitmap();
+    al_set_target_bitmap(batch_target);
+
+    bool was_held = al_is_bitmap_drawing_held();
+    al_hold_bitmap_drawing(true);
+
+    //Unrotated, unscaled items go through the software blitter when it can take them;
+    //the destination stays locked across a run of them.
+    bool software = a2de::SoftwareBlitter::IsEnabled();
+    std::size_t runs = 0;
+    ALLEGRO_BITMAP* last_sheet = nullptr;
+    std::size_t item_count = batch_items.size();
+    for(std::size_t i = 0; i < item_count; ++i) {
+        const BatchItem& item = batch_items[i];
+        if(item.sheet != last_sheet) {
+            ++runs;
+            last_sheet = item.sheet;
+        }
+        if(software && item.angle == 0.0f && item.xscale == 1.0f && item.yscale == 1.0f) {
+            if(a2de::SoftwareBlitter::IsActive() == false) software = a2de::SoftwareBlitter::Begin(batch_target);
+            if(software && a2de::SoftwareBlitter::Blit(batch_target, item.source, item.sx, item.sy, item.sw, item.sh, item.tint, item.dx - item.cx, item.dy - item.cy, item.flags)) continue;
+        }
+        a2de::SoftwareBlitter::End();
+        al_draw_tinted_scaled_rotated_bitmap_region(item.source, item.sx, item.sy, item.sw, item.sh, item.tint, item.cx, item.cy, item.dx, item.dy, item.xscale, item.yscale, item.angle, item.flags);
+    }
+    a2de::SoftwareBlitter::End();
+
+    al_hold_bitmap_drawing(was_held);
+    al_set_target_bitmap(old_target_bmp);
+
+    batch_items.clear();
+    batch_target = nullptr;
+    return runs;
+}
 
+bool SpriteHandler::IsBatching() {
+    return batch_target != nullptr;
 }
 
 A2DE_END
\ No newline at end of file
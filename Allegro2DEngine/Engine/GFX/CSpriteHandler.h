@@ -22,6 +22,7 @@ class Sprite;
 class AnimatedSprite;
 class Shape;
 class GameWindow;
+class Vector2D;
 
 class SpriteHandler {
 
@@ -173,6 +174,78 @@ public:
      **************************************************************************************************/
     static void Draw(ALLEGRO_BITMAP* dest, Shape* object);
 
+    /**************************************************************************************************
+     * <summary>Starts collecting sprites to draw onto a bitmap in one pass.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Nothing is drawn until EndBatch. Sprites are grouped by source bitmap, treating
+     *          sub-bitmaps of the same sheet as one source, and drawn with Allegro's deferred
+     *          drawing held, so the target is set once and each sheet is submitted as one
+     *          run.</remarks>
+     * <param name="dest">[in,out] If non-null, the destination bitmap.</param>
+     * <returns>true if it succeeds, false if dest is null or a batch is already in progress.</returns>
+     **************************************************************************************************/
+    static bool BeginBatch(ALLEGRO_BITMAP* dest);
+
+    /**************************************************************************************************
+     * <summary>Starts collecting sprites to draw onto a bitmap in one pass.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">          [in,out] If non-null, the destination bitmap.</param>
+     * <param name="sort_by_bitmap">true to group sprites by source bitmap, false to draw in submission order where overlap matters.</param>
+     * <returns>true if it succeeds, false if dest is null or a batch is already in progress.</returns>
+     **************************************************************************************************/
+    static bool BeginBatch(ALLEGRO_BITMAP* dest, bool sort_by_bitmap);
+
+    /**************************************************************************************************
+     * <summary>Adds a Sprite object to the batch using its stored position, tint, alpha, scale, rotation and flip values.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The pivot and scale follow Sprite::Draw. Sprites with a rotation radius are not
+     *          batched; draw them with Sprite::Draw.</remarks>
+     * <param name="sprite">[in,out] If non-null, the source sprite.</param>
+     * <returns>true if it was added, false if there is no batch in progress, there is nothing to draw or the sprite has a rotation radius.</returns>
+     **************************************************************************************************/
+    static bool AddToBatch(Sprite* sprite);
+
+    /**************************************************************************************************
+     * <summary>Adds a BITMAP to the batch.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="source">   [in,out] If non-null, the source bitmap.</param>
+     * <param name="x">        The x coordinate in meters.</param>
+     * <param name="y">        The y coordinate in meters.</param>
+     * <param name="tintColor">The tint color.</param>
+     * <returns>true if it was added, false if there is no batch in progress or there is nothing to draw.</returns>
+     **************************************************************************************************/
+    static bool AddToBatch(ALLEGRO_BITMAP* source, double x, double y, ALLEGRO_COLOR tintColor);
+
+    /**************************************************************************************************
+     * <summary>Adds a region of a BITMAP to the batch with a full transform.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="source">           [in,out] If non-null, the source bitmap.</param>
+     * <param name="source_position">  The top-left corner of the region in pixels.</param>
+     * <param name="source_dimensions">The size of the region in pixels.</param>
+     * <param name="tintColor">        The tint color.</param>
+     * <param name="center">           The pivot point within the region in pixels.</param>
+     * <param name="position">         The position of the pivot in meters.</param>
+     * <param name="scale">            The horizontal and vertical scale.</param>
+     * <param name="angle">            The rotation in radians.</param>
+     * <param name="axis">             The axis to flip the region over.</param>
+     * <returns>true if it was added, false if there is no batch in progress or there is nothing to draw.</returns>
+     **************************************************************************************************/
+    static bool AddToBatch(ALLEGRO_BITMAP* source, const a2de::Vector2D& source_position, const a2de::Vector2D& source_dimensions, ALLEGRO_COLOR tintColor, const a2de::Vector2D& center, const a2de::Vector2D& position, const a2de::Vector2D& scale, double angle, SpriteHandler::SPRITEAXIS axis);
+
+    /**************************************************************************************************
+     * <summary>Draws every sprite added since BeginBatch and ends the batch.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The number of runs of consecutive sprites sharing a source bitmap.</returns>
+     **************************************************************************************************/
+    static std::size_t EndBatch();
+
+    /**************************************************************************************************
+     * <summary>Query if a batch is in progress.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if batching, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsBatching();
+
 private:
     //Creation of object of type SpriteHandler is illegal,
     //all methods are static anyway.
@@ -0,0 +1,375 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CTextureAtlas.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the texture atlas class.
+ **************************************************************************************************/
+#include "CTextureAtlas.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_image.h>
+
+#include "../a2de_exceptions.h"
+#include "CAssetPack.h"
+#include "CBitmapCache.h"
+#include "CPixelCache.h"
+
+A2DE_BEGIN
+
+namespace {
+
+    /// <summary> Empty pixels left right of and below every image so filtering does not bleed between neighbours.</summary>
+    const int PADDING = 1;
+
+    /// <summary> An image waiting to be packed.</summary>
+    struct PackSource {
+        std::string filename;
+        ALLEGRO_BITMAP* bitmap;
+        bool owned;
+    };
+
+    std::string ToString(double value) {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(0) << value;
+        return ss.str();
+    }
+
+    int GetConfigInt(const ALLEGRO_CONFIG* config, const char* section, const char* key) {
+        const char* value = al_get_config_value(config, section, key);
+        return value ? std::atoi(value) : -1;
+    }
+
+}
+
+TextureAtlas::TextureAtlas() : _page_width(2048), _page_height(2048), _files(), _entries(), _pages() { /* DO NOTHING */ }
+
+TextureAtlas::TextureAtlas(int page_width, int page_height) : _page_width(page_width), _page_height(page_height), _files(), _entries(), _pages() { /* DO NOTHING */ }
+
+TextureAtlas::~TextureAtlas() {
+    ReleasePages();
+}
+
+bool TextureAtlas::Add(const std::string& filename) {
+    if(filename.empty()) return false;
+    if(AssetPack::FileExists(filename) == false) return false;
+    if(std::find(_files.begin(), _files.end(), filename) != _files.end()) return false;
+    _files.push_back(filename);
+    return true;
+}
+
+std::size_t TextureAtlas::AddCached() {
+    std::vector<std::string> filenames;
+    BitmapCache::GetCachedFilenames(filenames);
+    std::size_t added = 0;
+    for(std::vector<std::string>::iterator _iter = filenames.begin(); _iter != filenames.end(); ++_iter) {
+        if(Add(*_iter)) ++added;
+    }
+    return added;
+}
+
+std::size_t TextureAtlas::Build() {
+    if(_files.empty()) {
+        ReleasePages();
+        return 0;
+    }
+
+    //Decode into memory bitmaps; only the pages need to live on the GPU.
+    std::vector<PackSource> sources;
+    sources.reserve(_files.size());
+    int old_flags = al_get_new_bitmap_flags();
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    for(std::vector<std::string>::iterator _iter = _files.begin(); _iter != _files.end(); ++_iter) {
+        PackSource source;
+        source.filename = *_iter;
+        source.bitmap = BitmapCache::PeekBitmap(*_iter);
+        source.owned = false;
+        if(source.bitmap == nullptr) {
+            source.bitmap = AssetPack::ReadBitmap(*_iter);
+            if(source.bitmap == nullptr) source.bitmap = PixelCache::Load(*_iter);
+            source.owned = true;
+        }
+        if(source.bitmap == nullptr) continue;
+        sources.push_back(source);
+    }
+    al_set_new_bitmap_flags(old_flags);
+
+    //Tallest first keeps the skyline flat.
+    std::stable_sort(sources.begin(), sources.end(), [](const PackSource& a, const PackSource& b)->bool { return al_get_bitmap_height(a.bitmap) > al_get_bitmap_height(b.bitmap); });
+
+    //The old pages stay alive until the new ones are drawn; cached regions may be copied from them.
+    std::vector<Entry> entries;
+    std::vector<ALLEGRO_BITMAP*> pages;
+    std::vector<std::vector<SkylineNode> > skylines;
+    std::vector<int> page_heights;
+    std::vector<ALLEGRO_BITMAP*> placed;
+    for(std::vector<PackSource>::iterator _iter = sources.begin(); _iter != sources.end(); ++_iter) {
+        int width = al_get_bitmap_width(_iter->bitmap);
+        int height = al_get_bitmap_height(_iter->bitmap);
+        int padded_width = width + PADDING;
+        int padded_height = height + PADDING;
+        if(padded_width > _page_width || padded_height > _page_height) continue;
+
+        int x = 0;
+        int y = 0;
+        std::size_t page = 0;
+        for(/* DO NOTHING */; page < skylines.size(); ++page) {
+            if(Pack(skylines[page], padded_width, padded_height, x, y)) break;
+        }
+        if(page == skylines.size()) {
+            SkylineNode ground = { 0, 0, _page_width };
+            skylines.push_back(std::vector<SkylineNode>(1, ground));
+            page_heights.push_back(0);
+            Pack(skylines.back(), padded_width, padded_height, x, y);
+        }
+        page_heights[page] = std::max(page_heights[page], y + height);
+
+        Entry entry;
+        entry.filename = _iter->filename;
+        entry.mtime = GetModificationTime(_iter->filename);
+        entry.page = page;
+        entry.x = x;
+        entry.y = y;
+        entry.width = width;
+        entry.height = height;
+        entries.push_back(entry);
+        placed.push_back(_iter->bitmap);
+    }
+
+    //Copy the pixels as-is rather than blending them onto the cleared page.
+    ALLEGRO_STATE state;
+    al_store_state(&state, ALLEGRO_STATE_TARGET_BITMAP | ALLEGRO_STATE_BLENDER);
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+    for(std::size_t page = 0; page < page_heights.size(); ++page) {
+        ALLEGRO_BITMAP* bitmap = al_create_bitmap(_page_width, page_heights[page]);
+        pages.push_back(bitmap);
+        if(bitmap == nullptr) continue;
+        al_set_target_bitmap(bitmap);
+        al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    }
+    for(std::size_t i = 0; i < entries.size(); ++i) {
+        ALLEGRO_BITMAP* page = pages[entries[i].page];
+        if(page == nullptr) continue;
+        al_set_target_bitmap(page);
+        al_draw_bitmap(placed[i], entries[i].x, entries[i].y, 0);
+    }
+    al_restore_state(&state);
+
+    for(std::vector<PackSource>::iterator _iter = sources.begin(); _iter != sources.end(); ++_iter) {
+        if(_iter->owned) al_destroy_bitmap(_iter->bitmap);
+    }
+
+    //Drop anything that landed on a page that could not be created.
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [&pages](const Entry& e)->bool { return pages[e.page] == nullptr; }), entries.end());
+
+    ReleasePages();
+    _pages.swap(pages);
+    _entries.swap(entries);
+
+    RegisterRegions();
+    return _entries.size();
+}
+
+bool TextureAtlas::Pack(std::vector<SkylineNode>& skyline, int width, int height, int& x, int& y) const {
+    std::size_t best_index = skyline.size();
+    int best_bottom = INT_MAX;
+    int best_width = INT_MAX;
+    int best_top = 0;
+
+    //Bottom-left: the span where the rectangle's bottom edge ends up lowest, narrowest span on ties.
+    for(std::size_t i = 0; i < skyline.size(); ++i) {
+        int left = skyline[i].x;
+        if(left + width > _page_width) break;
+        int top = 0;
+        int remaining = width;
+        for(std::size_t j = i; remaining > 0; ++j) {
+            top = std::max(top, skyline[j].y);
+            remaining -= skyline[j].width;
+        }
+        if(top + height > _page_height) continue;
+        if(top + height < best_bottom || (top + height == best_bottom && skyline[i].width < best_width)) {
+            best_index = i;
+            best_bottom = top + height;
+            best_width = skyline[i].width;
+            best_top = top;
+        }
+    }
+    if(best_index == skyline.size()) return false;
+
+    x = skyline[best_index].x;
+    y = best_top;
+
+    SkylineNode node = { x, best_top + height, width };
+    skyline.insert(skyline.begin() + best_index, node);
+
+    //Trim the spans now covered by the new one.
+    for(std::size_t i = best_index + 1; i < skyline.size(); /* DO NOTHING */) {
+        const SkylineNode& previous = skyline[i - 1];
+        int previous_right = previous.x + previous.width;
+        if(skyline[i].x >= previous_right) break;
+        int shrink = previous_right - skyline[i].x;
+        skyline[i].x += shrink;
+        skyline[i].width -= shrink;
+        if(skyline[i].width > 0) break;
+        skyline.erase(skyline.begin() + i);
+    }
+
+    //Merge neighbours at the same height.
+    for(std::size_t i = 0; i + 1 < skyline.size(); /* DO NOTHING */) {
+        if(skyline[i].y != skyline[i + 1].y) {
+            ++i;
+            continue;
+        }
+        skyline[i].width += skyline[i + 1].width;
+        skyline.erase(skyline.begin() + i + 1);
+    }
+    return true;
+}
+
+bool TextureAtlas::SaveLayout(const std::string& filename) const {
+    if(filename.empty() || _pages.empty()) return false;
+
+    for(std::size_t page = 0; page < _pages.size(); ++page) {
+        if(_pages[page] == nullptr) return false;
+        std::string page_file = filename + "." + ToString(static_cast<double>(page)) + ".png";
+        if(al_save_bitmap(page_file.c_str(), _pages[page]) == false) return false;
+    }
+
+    ALLEGRO_CONFIG* config = al_create_config();
+    if(config == nullptr) return false;
+    al_set_config_value(config, nullptr, "pages", ToString(static_cast<double>(_pages.size())).c_str());
+    for(std::vector<Entry>::const_iterator _iter = _entries.begin(); _iter != _entries.end(); ++_iter) {
+        const char* section = _iter->filename.c_str();
+        al_set_config_value(config, section, "mtime", ToString(_iter->mtime).c_str());
+        al_set_config_value(config, section, "page", ToString(static_cast<double>(_iter->page)).c_str());
+        al_set_config_value(config, section, "x", ToString(_iter->x).c_str());
+        al_set_config_value(config, section, "y", ToString(_iter->y).c_str());
+        al_set_config_value(config, section, "width", ToString(_iter->width).c_str());
+        al_set_config_value(config, section, "height", ToString(_iter->height).c_str());
+    }
+    bool saved = al_save_config_file(filename.c_str(), config);
+    al_destroy_config(config);
+    return saved;
+}
+
+bool TextureAtlas::LoadLayout(const std::string& filename) {
+    if(filename.empty()) return false;
+    if(al_filename_exists(filename.c_str()) == false) return false;
+
+    ALLEGRO_CONFIG* config = al_load_config_file(filename.c_str());
+    if(config == nullptr) return false;
+
+    int page_count = GetConfigInt(config, nullptr, "pages");
+    std::vector<Entry> entries;
+    bool valid = page_count > 0;
+
+    ALLEGRO_CONFIG_SECTION* section_iter = nullptr;
+    for(const char* section = al_get_first_config_section(config, &section_iter); valid && section != nullptr; section = al_get_next_config_section(&section_iter)) {
+        if(*section == '\0') continue;
+        const char* mtime = al_get_config_value(config, section, "mtime");
+        Entry entry;
+        entry.filename = section;
+        entry.mtime = mtime ? std::strtod(mtime, nullptr) : -1.0;
+        int page = GetConfigInt(config, section, "page");
+        entry.x = GetConfigInt(config, section, "x");
+        entry.y = GetConfigInt(config, section, "y");
+        entry.width = GetConfigInt(config, section, "width");
+        entry.height = GetConfigInt(config, section, "height");
+        valid = page >= 0 && page < page_count && entry.x >= 0 && entry.y >= 0 && entry.width > 0 && entry.height > 0;
+        //A changed or missing source means the pages are stale.
+        valid = valid && entry.mtime == GetModificationTime(entry.filename);
+        entry.page = static_cast<std::size_t>(page);
+        entries.push_back(entry);
+    }
+    al_destroy_config(config);
+    if(valid == false) return false;
+
+    std::vector<ALLEGRO_BITMAP*> pages;
+    for(int page = 0; valid && page < page_count; ++page) {
+        std::string page_file = filename + "." + ToString(page) + ".png";
+        ALLEGRO_BITMAP* bitmap = al_load_bitmap(page_file.c_str());
+        valid = bitmap != nullptr;
+        if(valid) pages.push_back(bitmap);
+    }
+    for(std::vector<Entry>::iterator _iter = entries.begin(); valid && _iter != entries.end(); ++_iter) {
+        ALLEGRO_BITMAP* page = pages[_iter->page];
+        valid = _iter->x + _iter->width <= al_get_bitmap_width(page) && _iter->y + _iter->height <= al_get_bitmap_height(page);
+    }
+    if(valid == false) {
+        for(std::vector<ALLEGRO_BITMAP*>::iterator _iter = pages.begin(); _iter != pages.end(); ++_iter) {
+            al_destroy_bitmap(*_iter);
+        }
+        return false;
+    }
+
+    ReleasePages();
+    _pages.swap(pages);
+    _entries.swap(entries);
+    _files.clear();
+    for(std::vector<Entry>::iterator _iter = _entries.begin(); _iter != _entries.end(); ++_iter) {
+        _files.push_back(_iter->filename);
+    }
+    RegisterRegions();
+    return true;
+}
+
+void TextureAtlas::Clear() {
+    ReleasePages();
+    _files.clear();
+}
+
+bool TextureAtlas::Contains(const std::string& filename) const {
+    for(std::vector<Entry>::const_iterator _iter = _entries.begin(); _iter != _entries.end(); ++_iter) {
+        if(_iter->filename == filename) return true;
+    }
+    return false;
+}
+
+std::size_t TextureAtlas::GetPageCount() const {
+    return _pages.size();
+}
+
+ALLEGRO_BITMAP* TextureAtlas::GetPage(std::size_t index) const {
+    if(index >= _pages.size()) throw a2de::IndexOutOfBoundsException("index", "0", "_pages.size() - 1");
+    return _pages[index];
+}
+
+void TextureAtlas::RegisterRegions() {
+    for(std::vector<Entry>::iterator _iter = _entries.begin(); _iter != _entries.end(); ++_iter) {
+        BitmapCache::AtlasRegion region;
+        region.page = _pages[_iter->page];
+        region.x = _iter->x;
+        region.y = _iter->y;
+        region.width = _iter->width;
+        region.height = _iter->height;
+        BitmapCache::RegisterAtlasRegion(_iter->filename, region);
+    }
+}
+
+void TextureAtlas::ReleasePages() {
+    for(std::vector<Entry>::iterator _iter = _entries.begin(); _iter != _entries.end(); ++_iter) {
+        BitmapCache::UnregisterAtlasRegion(_iter->filename);
+    }
+    _entries.clear();
+    //Sprites may still hold regions of a page; the cache destroys it after the last is released.
+    for(std::vector<ALLEGRO_BITMAP*>::iterator _iter = _pages.begin(); _iter != _pages.end(); ++_iter) {
+        BitmapCache::RetireAtlasPage(*_iter);
+    }
+    _pages.clear();
+}
+
+double TextureAtlas::GetModificationTime(const std::string& filename) {
+    ALLEGRO_FS_ENTRY* entry = al_create_fs_entry(filename.c_str());
+    if(entry == nullptr) return 0.0;
+    double mtime = al_fs_entry_exists(entry) ? static_cast<double>(al_get_fs_entry_mtime(entry)) : 0.0;
+    al_destroy_fs_entry(entry);
+    return mtime;
+}
+
+A2DE_END
@@ -0,0 +1,213 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CTextureAtlas.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the texture atlas class.
+ **************************************************************************************************/
+#ifndef A2DE_CTEXTUREATLAS_H
+#define A2DE_CTEXTUREATLAS_H
+
+#include "../a2de_vals.h"
+
+#include <string>
+#include <vector>
+
+struct ALLEGRO_BITMAP;
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Packs image files into a few large pages.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Once built, every packed file is registered with the BitmapCache, so Sprites,
+ *          AnimatedSprites and TileSets created from those files afterwards draw from a
+ *          sub-bitmap of a page instead of their own bitmap. Files already in use keep their
+ *          bitmap until they are released. When the atlas is rebuilt, cleared or destroyed, a page
+ *          whose regions are still in use stays alive until the last of them is released.</remarks>
+ **************************************************************************************************/
+class TextureAtlas {
+public:
+
+    /**************************************************************************************************
+     * <summary>Default constructor. Pages are 2048 by 2048 pixels.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    TextureAtlas();
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="page_width"> The width of each page in pixels.</param>
+     * <param name="page_height">The maximum height of each page in pixels.</param>
+     **************************************************************************************************/
+    TextureAtlas(int page_width, int page_height);
+
+    /**************************************************************************************************
+     * <summary>Destructor. Unregisters the regions and releases the pages.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~TextureAtlas();
+
+    /**************************************************************************************************
+     * <summary>Adds an image file to pack on the next Build.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the image.</param>
+     * <returns>true if it was added, false if it is empty, missing or already added.</returns>
+     **************************************************************************************************/
+    bool Add(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Adds every image file currently in the BitmapCache.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Cached pixels are copied instead of reloading the files.</remarks>
+     * <returns>The number of files added.</returns>
+     **************************************************************************************************/
+    std::size_t AddCached();
+
+    /**************************************************************************************************
+     * <summary>Packs every added file into new pages, replacing any previous pages.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Images are placed tallest first with a skyline bottom-left packer. Images larger than
+     *          a page, or that fail to load, are left out and keep loading on their own.</remarks>
+     * <returns>The number of images packed.</returns>
+     **************************************************************************************************/
+    std::size_t Build();
+
+    /**************************************************************************************************
+     * <summary>Writes the layout and the pages to disk.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The layout is an Allegro config file. Pages are written next to it as
+     *          filename.0.png, filename.1.png and so on.</remarks>
+     * <param name="filename">Path and Filename of the layout.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool SaveLayout(const std::string& filename) const;
+
+    /**************************************************************************************************
+     * <summary>Loads a layout and its pages written by SaveLayout, replacing any previous pages.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Fails if any packed file has changed since the layout was saved, in which case the
+     *          caller should Add the files and Build instead.</remarks>
+     * <param name="filename">Path and Filename of the layout.</param>
+     * <returns>true if it succeeds, false if the layout is missing, unreadable or stale.</returns>
+     **************************************************************************************************/
+    bool LoadLayout(const std::string& filename);
+
+    /**************************************************************************************************
+     * <summary>Unregisters the regions, releases the pages and forgets every added file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Query if a file was packed.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the image.</param>
+     * <returns>true if it is on a page, false if not.</returns>
+     **************************************************************************************************/
+    bool Contains(const std::string& filename) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the number of pages.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The page count.</returns>
+     **************************************************************************************************/
+    std::size_t GetPageCount() const;
+
+    /**************************************************************************************************
+     * <summary>Gets a page.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="index">Zero-based index of the page.</param>
+     * <returns>The page.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the index is past the last page.</exception>
+     **************************************************************************************************/
+    ALLEGRO_BITMAP* GetPage(std::size_t index) const;
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Where a packed image lives.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct Entry {
+        /// <summary> Path and Filename of the image.</summary>
+        std::string filename;
+        /// <summary> The modification time of the file when it was packed.</summary>
+        double mtime;
+        /// <summary> Zero-based index of the page.</summary>
+        std::size_t page;
+        /// <summary> The left edge on the page.</summary>
+        int x;
+        /// <summary> The top edge on the page.</summary>
+        int y;
+        /// <summary> The width.</summary>
+        int width;
+        /// <summary> The height.</summary>
+        int height;
+    };
+
+    /**************************************************************************************************
+     * <summary>A horizontal span of the top edge of the packed area.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct SkylineNode {
+        /// <summary> The left edge of the span.</summary>
+        int x;
+        /// <summary> The height of the packed area under the span.</summary>
+        int y;
+        /// <summary> The width of the span.</summary>
+        int width;
+    };
+
+    /**************************************************************************************************
+     * <summary>Finds the lowest place for a rectangle on a page and raises the skyline over it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="skyline">[in,out] The page's skyline.</param>
+     * <param name="width">  The width of the rectangle.</param>
+     * <param name="height"> The height of the rectangle.</param>
+     * <param name="x">      [out] The left edge of the placed rectangle.</param>
+     * <param name="y">      [out] The top edge of the placed rectangle.</param>
+     * <returns>true if it fit, false if the page is full.</returns>
+     **************************************************************************************************/
+    bool Pack(std::vector<SkylineNode>& skyline, int width, int height, int& x, int& y) const;
+
+    /**************************************************************************************************
+     * <summary>Registers every entry with the BitmapCache.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void RegisterRegions();
+
+    /**************************************************************************************************
+     * <summary>Unregisters the entries and hands the pages to the BitmapCache to destroy once unused, keeping the added files.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void ReleasePages();
+
+    /**************************************************************************************************
+     * <summary>Gets the modification time of a file.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="filename">Path and Filename of the file.</param>
+     * <returns>The modification time, or zero if the file does not exist.</returns>
+     **************************************************************************************************/
+    static double GetModificationTime(const std::string& filename);
+
+    /// <summary> The width of each page.</summary>
+    int _page_width;
+    /// <summary> The maximum height of each page.</summary>
+    int _page_height;
+    /// <summary> The files to pack on the next Build.</summary>
+    std::vector<std::string> _files;
+    /// <summary> The packed images.</summary>
+    std::vector<Entry> _entries;
+    /// <summary> The pages.</summary>
+    std::vector<ALLEGRO_BITMAP*> _pages;
+
+    TextureAtlas(const TextureAtlas& other);
+    TextureAtlas& operator=(const TextureAtlas& rhs);
+};
+
+A2DE_END
+
+#endif
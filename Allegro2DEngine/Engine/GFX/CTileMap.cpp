@@ -0,0 +1,378 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CTileMap.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the tile map class.
+ **************************************************************************************************/
+#include "CTileMap.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <allegro5/allegro.h>
+
+#include "../a2de_exceptions.h"
+#include "../Math/CMiscMath.h"
+#include "../Physics/CCamera.h"
+#include "CDirtyRegions.h"
+#include "CRenderCommandList.h"
+#include "CRenderThread.h"
+#include "CSoftwareBlitter.h"
+#include "CTileSet.h"
+
+A2DE_BEGIN
+
+const unsigned int TileMap::CHUNK_SIZE;
+const int TileMap::EMPTY_TILE;
+
+TileMap::TileMap(TileSet& tile_set, unsigned int columns, unsigned int rows)
+    : _tile_set(&tile_set), _columns(columns), _rows(rows),
+    _chunk_columns((columns + CHUNK_SIZE - 1) / CHUNK_SIZE), _chunk_rows((rows + CHUNK_SIZE - 1) / CHUNK_SIZE), _layers(), _drawn_views() {
+    if(columns == 0 || rows == 0) {
+        throw InvalidArgumentException("Tile maps must have at least one column and one row.");
+    }
+}
+
+TileMap::~TileMap() {
+    ReleaseCache();
+}
+
+std::size_t TileMap::AddLayer() {
+    return AddLayer(true);
+}
+
+std::size_t TileMap::AddLayer(bool cached) {
+    Chunk empty;
+    empty.tiles.assign(CHUNK_SIZE * CHUNK_SIZE, EMPTY_TILE);
+    empty.tile_count = 0;
+    empty.cache = nullptr;
+    empty.dirty = false;
+
+    _layers.push_back(Layer());
+    _layers.back().cached = cached;
+    _layers.back().chunks.assign(_chunk_columns * _chunk_rows, empty);
+    return _layers.size() - 1;
+}
+
+std::size_t TileMap::GetLayerCount() const {
+    return _layers.size();
+}
+
+const TileMap::Chunk& TileMap::FindChunk(std::size_t layer, unsigned int column, unsigned int row, std::size_t& cell) const {
+    if(layer >= _layers.size()) throw IndexOutOfBoundsException("layer", "0", "_layers.size() - 1");
+    if(column >= _columns) throw IndexOutOfBoundsException("column", "0", "_columns - 1");
+    if(row >= _rows) throw IndexOutOfBoundsException("row", "0", "_rows - 1");
+    cell = (row % CHUNK_SIZE) * CHUNK_SIZE + (column % CHUNK_SIZE);
+    return _layers[layer].chunks[(row / CHUNK_SIZE) * _chunk_columns + (column / CHUNK_SIZE)];
+}
+
+void TileMap::SetTile(std::size_t layer, unsigned int column, unsigned int row, int tile) {
+    std::size_t cell = 0;
+    Chunk& chunk = const_cast<Chunk&>(FindChunk(layer, column, row, cell));
+    if(tile < 0) tile = EMPTY_TILE;
+    int& current = chunk.tiles[cell];
+    if(current == tile) return;
+
+    if(current == EMPTY_TILE) ++chunk.tile_count;
+    if(tile == EMPTY_TILE) --chunk.tile_count;
+    current = tile;
+    chunk.dirty = true;
+    InvalidateArea(static_cast<int>(column * _tile_set->GetTileWidth()), static_cast<int>(row * _tile_set->GetTileHeight()), static_cast<int>(_tile_set->GetTileWidth()), static_cast<int>(_tile_set->GetTileHeight()));
+
+    //An emptied chunk is never drawn; don't keep its pixels around.
+    if(chunk.tile_count == 0 && chunk.cache != nullptr) {
+        RenderThread::DestroyBitmap(chunk.cache);
+        chunk.cache = nullptr;
+    }
+}
+
+int TileMap::GetTile(std::size_t layer, unsigned int column, unsigned int row) const {
+    std::size_t cell = 0;
+    const Chunk& chunk = FindChunk(layer, column, row, cell);
+    return chunk.tiles[cell];
+}
+
+void TileMap::Fill(std::size_t layer, int tile) {
+    if(layer >= _layers.size()) throw IndexOutOfBoundsException("layer", "0", "_layers.size() - 1");
+    if(tile < 0) tile = EMPTY_TILE;
+    InvalidateArea(0, 0, static_cast<int>(_columns * _tile_set->GetTileWidth()), static_cast<int>(_rows * _tile_set->GetTileHeight()));
+
+    std::vector<Chunk>& chunks = _layers[layer].chunks;
+    for(unsigned int chunk_y = 0; chunk_y < _chunk_rows; ++chunk_y) {
+        for(unsigned int chunk_x = 0; chunk_x < _chunk_columns; ++chunk_x) {
+            Chunk& chunk = chunks[chunk_y * _chunk_columns + chunk_x];
+            //Cells of edge chunks past the map stay empty.
+            unsigned int width = std::min(CHUNK_SIZE, _columns - chunk_x * CHUNK_SIZE);
+            unsigned int height = std::min(CHUNK_SIZE, _rows - chunk_y * CHUNK_SIZE);
+            for(unsigned int y = 0; y < height; ++y) {
+                std::fill(chunk.tiles.begin() + y * CHUNK_SIZE, chunk.tiles.begin() + y * CHUNK_SIZE + width, tile);
+            }
+            chunk.tile_count = tile == EMPTY_TILE ? 0 : width * height;
+            chunk.dirty = true;
+            if(chunk.tile_count == 0 && chunk.cache != nullptr) {
+                RenderThread::DestroyBitmap(chunk.cache);
+                chunk.cache = nullptr;
+            }
+        }
+    }
+}
+
+void TileMap::Draw(ALLEGRO_BITMAP* dest, const Camera& camera) {
+    if(dest == nullptr) return;
+    int view_x = static_cast<int>(std::floor(Math::ToScreenScale(camera.GetX())));
+    int view_y = static_cast<int>(std::floor(Math::ToScreenScale(camera.GetY())));
+    int view_width = static_cast<int>(std::ceil(Math::ToScreenScale(camera.GetHalfExtents().GetX() * 2.0)));
+    int view_height = static_cast<int>(std::ceil(Math::ToScreenScale(camera.GetHalfExtents().GetY() * 2.0)));
+    const Vector2D& screen_position = camera.GetScreenPosition();
+    DrawView(dest, view_x, view_y, view_width, view_height, static_cast<int>(screen_position.GetX()), static_cast<int>(screen_position.GetY()));
+}
+
+void TileMap::Draw(ALLEGRO_BITMAP* dest, int view_x, int view_y, int view_width, int view_height) {
+    if(dest == nullptr) return;
+    DrawView(dest, view_x, view_y, view_width, view_height, 0, 0);
+}
+
+void TileMap::DrawView(ALLEGRO_BITMAP* dest, int view_x, int view_y, int view_width, int view_height, int screen_x, int screen_y) {
+    if(view_width <= 0 || view_height <= 0 || _layers.empty()) return;
+
+    int tile_width = static_cast<int>(_tile_set->GetTileWidth());
+    int tile_height = static_cast<int>(_tile_set->GetTileHeight());
+    int chunk_width = tile_width * CHUNK_SIZE;
+    int chunk_height = tile_height * CHUNK_SIZE;
+
+    //The visible cells, clamped to the map.
+    int left = std::max(view_x, 0);
+    int top = std::max(view_y, 0);
+    int right = std::min(view_x + view_width, static_cast<int>(_columns) * tile_width);
+    int bottom = std::min(view_y + view_height, static_cast<int>(_rows) * tile_height);
+    if(left >= right || top >= bottom) return;
+    unsigned int first_column = left / tile_width;
+    unsigned int first_row = top / tile_height;
+    unsigned int last_column = (right - 1) / tile_width;
+    unsigned int last_row = (bottom - 1) / tile_height;
+    unsigned int first_chunk_x = first_column / CHUNK_SIZE;
+    unsigned int first_chunk_y = first_row / CHUNK_SIZE;
+    unsigned int last_chunk_x = last_column / CHUNK_SIZE;
+    unsigned int last_chunk_y = last_row / CHUNK_SIZE;
+
+    DrawnView drawn;
+    drawn.offset_x = screen_x - view_x;
+    drawn.offset_y = screen_y - view_y;
+    drawn.clip_x = screen_x;
+    drawn.clip_y = screen_y;
+    drawn.clip_right = screen_x + view_width;
+    drawn.clip_bottom = screen_y + view_height;
+    RememberView(drawn);
+
+    //The recording thread has no display, and the render thread may still be drawing from the
+    //caches, so a recorded view leaves them as they are.
+    if(RenderCommandList::GetRecording() != nullptr) {
+        RecordView(dest, first_column, first_row, last_column, last_row, screen_x - view_x, screen_y - view_y, screen_x, screen_y, screen_x + view_width, screen_y + view_height);
+        return;
+    }
+
+    //Bring the visible cached chunks up to date first; redrawing one changes the target.
+    for(std::vector<Layer>::iterator _iter = _layers.begin(); _iter != _layers.end(); ++_iter) {
+        if(_iter->cached == false) continue;
+        for(unsigned int chunk_y = first_chunk_y; chunk_y <= last_chunk_y; ++chunk_y) {
+            for(unsigned int chunk_x = first_chunk_x; chunk_x <= last_chunk_x; ++chunk_x) {
+                Chunk& chunk = _iter->chunks[chunk_y * _chunk_columns + chunk_x];
+                if(chunk.tile_count == 0) continue;
+                if(chunk.cache != nullptr && chunk.dirty == false) continue;
+                RenderChunk(chunk, chunk_x, chunk_y);
+            }
+        }
+    }
+
+    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
+    al_set_target_bitmap(dest);
+
+    //Keep chunks that straddle the edge of the view inside it.
+    int old_clip_x = 0;
+    int old_clip_y = 0;
+    int old_clip_width = 0;
+    int old_clip_height = 0;
+    al_get_clipping_rectangle(&old_clip_x, &old_clip_y, &old_clip_width, &old_clip_height);
+    int clip_x = std::max(screen_x, old_clip_x);
+    int clip_y = std::max(screen_y, old_clip_y);
+    int clip_right = std::min(screen_x + view_width, old_clip_x + old_clip_width);
+    int clip_bottom = std::min(screen_y + view_height, old_clip_y + old_clip_height);
+    if(clip_x < clip_right && clip_y < clip_bottom) {
+        al_set_clipping_rectangle(clip_x, clip_y, clip_right - clip_x, clip_bottom - clip_y);
+
+        int offset_x = screen_x - view_x;
+        int offset_y = screen_y - view_y;
+        bool was_held = al_is_bitmap_drawing_held();
+        al_hold_bitmap_drawing(true);
+        //Keeps dest locked for the whole view when the software blitter can draw to it.
+        SoftwareBlitter::Begin(dest);
+        for(std::vector<Layer>::iterator _iter = _layers.begin(); _iter != _layers.end(); ++_iter) {
+            for(unsigned int chunk_y = first_chunk_y; chunk_y <= last_chunk_y; ++chunk_y) {
+                for(unsigned int chunk_x = first_chunk_x; chunk_x <= last_chunk_x; ++chunk_x) {
+                    const Chunk& chunk = _iter->chunks[chunk_y * _chunk_columns + chunk_x];
+                    if(chunk.tile_count == 0) continue;
+                    if(_iter->cached && chunk.cache != nullptr) {
+                        float chunk_left = static_cast<float>(offset_x + static_cast<int>(chunk_x) * chunk_width);
+                        float chunk_top = static_cast<float>(offset_y + static_cast<int>(chunk_y) * chunk_height);
+                        if(SoftwareBlitter::Blit(dest, chunk.cache, 0.0f, 0.0f, static_cast<float>(al_get_bitmap_width(chunk.cache)), static_cast<float>(al_get_bitmap_height(chunk.cache)), al_map_rgb(255, 255, 255), chunk_left, chunk_top, 0) == false) {
+                            al_draw_bitmap(chunk.cache, chunk_left, chunk_top, 0);
+                        }
+                        continue;
+                    }
+                    //Uncached, or the cache could not be created: only the visible cells.
+                    unsigned int column_begin = std::max(first_column, chunk_x * CHUNK_SIZE);
+                    unsigned int column_end = std::min(last_column, chunk_x * CHUNK_SIZE + CHUNK_SIZE - 1);
+                    unsigned int row_begin = std::max(first_row, chunk_y * CHUNK_SIZE);
+                    unsigned int row_end = std::min(last_row, chunk_y * CHUNK_SIZE + CHUNK_SIZE - 1);
+                    for(unsigned int row = row_begin; row <= row_end; ++row) {
+                        const int* cells = &chunk.tiles[(row % CHUNK_SIZE) * CHUNK_SIZE];
+                        for(unsigned int column = column_begin; column <= column_end; ++column) {
+                            int tile = cells[column % CHUNK_SIZE];
+                            if(tile == EMPTY_TILE) continue;
+                            _tile_set->DrawTile(dest, static_cast<unsigned int>(tile), offset_x + static_cast<int>(column) * tile_width, offset_y + static_cast<int>(row) * tile_height);
+                        }
+                    }
+                }
+            }
+        }
+        SoftwareBlitter::End();
+        al_hold_bitmap_drawing(was_held);
+    }
+
+    al_set_clipping_rectangle(old_clip_x, old_clip_y, old_clip_width, old_clip_height);
+    al_set_target_bitmap(old_target);
+}
+
+void TileMap::RecordView(ALLEGRO_BITMAP* dest, unsigned int first_column, unsigned int first_row, unsigned int last_column, unsigned int last_row, int offset_x, int offset_y, int clip_x, int clip_y, int clip_right, int clip_bottom) {
+    RenderCommandList* list = RenderCommandList::GetRecording();
+    int tile_width = static_cast<int>(_tile_set->GetTileWidth());
+    int tile_height = static_cast<int>(_tile_set->GetTileHeight());
+    int chunk_width = tile_width * CHUNK_SIZE;
+    int chunk_height = tile_height * CHUNK_SIZE;
+    unsigned int first_chunk_x = first_column / CHUNK_SIZE;
+    unsigned int first_chunk_y = first_row / CHUNK_SIZE;
+    unsigned int last_chunk_x = last_column / CHUNK_SIZE;
+    unsigned int last_chunk_y = last_row / CHUNK_SIZE;
+
+    for(std::vector<Layer>::iterator _iter = _layers.begin(); _iter != _layers.end(); ++_iter) {
+        for(unsigned int chunk_y = first_chunk_y; chunk_y <= last_chunk_y; ++chunk_y) {
+            for(unsigned int chunk_x = first_chunk_x; chunk_x <= last_chunk_x; ++chunk_x) {
+                const Chunk& chunk = _iter->chunks[chunk_y * _chunk_columns + chunk_x];
+                if(chunk.tile_count == 0) continue;
+                //Recorded commands are not clipped, so parts past the view are cut off here.
+                if(_iter->cached && chunk.cache != nullptr && chunk.dirty == false) {
+                    int x = offset_x + static_cast<int>(chunk_x) * chunk_width;
+                    int y = offset_y + static_cast<int>(chunk_y) * chunk_height;
+                    int left = std::max(x, clip_x);
+                    int top = std::max(y, clip_y);
+                    int right = std::min(x + al_get_bitmap_width(chunk.cache), clip_right);
+                    int bottom = std::min(y + al_get_bitmap_height(chunk.cache), clip_bottom);
+                    if(left >= right || top >= bottom) continue;
+                    ALLEGRO_TRANSFORM transform;
+                    al_identity_transform(&transform);
+                    al_translate_transform(&transform, static_cast<float>(left), static_cast<float>(top));
+                    list->AddBitmap(dest, chunk.cache, static_cast<float>(left - x), static_cast<float>(top - y), static_cast<float>(right - left), static_cast<float>(bottom - top), al_map_rgb(255, 255, 255), transform, 0);
+                    continue;
+                }
+                //Uncached, or the cache is out of date: the visible cells, which the list draws as one run of the sheet.
+                unsigned int column_begin = std::max(first_column, chunk_x * CHUNK_SIZE);
+                unsigned int column_end = std::min(last_column, chunk_x * CHUNK_SIZE + CHUNK_SIZE - 1);
+                unsigned int row_begin = std::max(first_row, chunk_y * CHUNK_SIZE);
+                unsigned int row_end = std::min(last_row, chunk_y * CHUNK_SIZE + CHUNK_SIZE - 1);
+                for(unsigned int row = row_begin; row <= row_end; ++row) {
+                    const int* cells = &chunk.tiles[(row % CHUNK_SIZE) * CHUNK_SIZE];
+                    int y = offset_y + static_cast<int>(row) * tile_height;
+                    for(unsigned int column = column_begin; column <= column_end; ++column) {
+                        int tile = cells[column % CHUNK_SIZE];
+                        if(tile == EMPTY_TILE) continue;
+                        int x = offset_x + static_cast<int>(column) * tile_width;
+                        int left = std::max(x, clip_x);
+                        int top = std::max(y, clip_y);
+                        int right = std::min(x + tile_width, clip_right);
+                        int bottom = std::min(y + tile_height, clip_bottom);
+                        if(left >= right || top >= bottom) continue;
+                        _tile_set->DrawTilePart(dest, static_cast<unsigned int>(tile), left - x, top - y, right - left, bottom - top, left, top);
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool TileMap::RenderChunk(Chunk& chunk, unsigned int chunk_x, unsigned int chunk_y) {
+    int tile_width = static_cast<int>(_tile_set->GetTileWidth());
+    int tile_height = static_cast<int>(_tile_set->GetTileHeight());
+    unsigned int columns = std::min(CHUNK_SIZE, _columns - chunk_x * CHUNK_SIZE);
+    unsigned int rows = std::min(CHUNK_SIZE, _rows - chunk_y * CHUNK_SIZE);
+
+    if(chunk.cache == nullptr) {
+        chunk.cache = al_create_bitmap(columns * tile_width, rows * tile_height);
+        if(chunk.cache == nullptr) return false;
+    }
+
+    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
+    al_set_target_bitmap(chunk.cache);
+    al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+    bool was_held = al_is_bitmap_drawing_held();
+    al_hold_bitmap_drawing(true);
+    SoftwareBlitter::Begin(chunk.cache);
+    for(unsigned int row = 0; row < rows; ++row) {
+        const int* cells = &chunk.tiles[row * CHUNK_SIZE];
+        for(unsigned int column = 0; column < columns; ++column) {
+            if(cells[column] == EMPTY_TILE) continue;
+            _tile_set->DrawTile(chunk.cache, static_cast<unsigned int>(cells[column]), column * tile_width, row * tile_height);
+        }
+    }
+    SoftwareBlitter::End();
+    al_hold_bitmap_drawing(was_held);
+    al_set_target_bitmap(old_target);
+
+    chunk.dirty = false;
+    return true;
+}
+
+void TileMap::RememberView(const DrawnView& view) {
+    for(std::vector<DrawnView>::iterator _iter = _drawn_views.begin(); _iter != _drawn_views.end(); ++_iter) {
+        if(_iter->clip_x != view.clip_x || _iter->clip_y != view.clip_y || _iter->clip_right != view.clip_right || _iter->clip_bottom != view.clip_bottom) continue;
+        *_iter = view;
+        return;
+    }
+    _drawn_views.push_back(view);
+}
+
+void TileMap::InvalidateArea(int x, int y, int width, int height) const {
+    if(DirtyRegions::IsEnabled() == false) return;
+    for(std::vector<DrawnView>::const_iterator _iter = _drawn_views.begin(); _iter != _drawn_views.end(); ++_iter) {
+        int left = std::max(x + _iter->offset_x, _iter->clip_x);
+        int top = std::max(y + _iter->offset_y, _iter->clip_y);
+        int right = std::min(x + width + _iter->offset_x, _iter->clip_right);
+        int bottom = std::min(y + height + _iter->offset_y, _iter->clip_bottom);
+        if(left >= right || top >= bottom) continue;
+        DirtyRegions::Invalidate(left, top, right - left, bottom - top);
+    }
+}
+
+void TileMap::ReleaseCache() {
+    for(std::vector<Layer>::iterator _iter = _layers.begin(); _iter != _layers.end(); ++_iter) {
+        for(std::vector<Chunk>::iterator _chunk = _iter->chunks.begin(); _chunk != _iter->chunks.end(); ++_chunk) {
+            if(_chunk->cache == nullptr) continue;
+            RenderThread::DestroyBitmap(_chunk->cache);
+            _chunk->cache = nullptr;
+        }
+    }
+}
+
+unsigned int TileMap::GetColumns() const {
+    return _columns;
+}
+
+unsigned int TileMap::GetRows() const {
+    return _rows;
+}
+
+TileSet& TileMap::GetTileSet() const {
+    return *_tile_set;
+}
+
+A2DE_END
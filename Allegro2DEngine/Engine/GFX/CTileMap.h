@@ -0,0 +1,301 @@
+/**************************************************************************************************
+// file:	Engine\GFX\CTileMap.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the tile map class.
+ **************************************************************************************************/
+#ifndef A2DE_CTILEMAP_H
+#define A2DE_CTILEMAP_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+
+struct ALLEGRO_BITMAP;
+
+A2DE_BEGIN
+
+class TileSet;
+class Camera;
+
+/**************************************************************************************************
+ * <summary>A grid of tiles from one TileSet, in layers drawn bottom to top.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Each layer is stored in square chunks of CHUNK_SIZE tiles. A cached layer draws each
+ *          chunk once into its own bitmap and blits that, redrawing a chunk only after one of its
+ *          tiles changes; use it for layers that rarely change. An uncached layer draws its
+ *          visible tiles every time. Only chunks that overlap the view are touched, and chunks
+ *          with no tiles are skipped. The TileSet must outlive the map.
+ *          While a RenderCommandList records, the map is recorded instead of drawn and caches
+ *          are not redrawn, since the render thread may still be drawing them; a chunk changed
+ *          while the render thread runs records its tiles until the thread stops.
+ *          SetTile and Fill invalidate the DirtyRegions where the map was last drawn.</remarks>
+ **************************************************************************************************/
+class TileMap {
+public:
+
+    /// <summary> The width and height of a chunk in tiles.</summary>
+    static const unsigned int CHUNK_SIZE = 32;
+    /// <summary> The tile index of an empty cell.</summary>
+    static const int EMPTY_TILE = -1;
+
+    /**************************************************************************************************
+     * <summary>Constructor. The map starts with no layers.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="tile_set">The tiles.</param>
+     * <param name="columns"> The width of the map in tiles.</param>
+     * <param name="rows">    The height of the map in tiles.</param>
+     * <exception cref="a2de::InvalidArgumentException">Thrown when the map has no columns or rows.</exception>
+     **************************************************************************************************/
+    TileMap(TileSet& tile_set, unsigned int columns, unsigned int rows);
+
+    /**************************************************************************************************
+     * <summary>Destructor. Destroys the cached chunks.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~TileMap();
+
+    /**************************************************************************************************
+     * <summary>Adds a cached layer of empty cells on top of the others.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>Zero-based index of the new layer.</returns>
+     **************************************************************************************************/
+    std::size_t AddLayer();
+
+    /**************************************************************************************************
+     * <summary>Adds a layer of empty cells on top of the others.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="cached">true to draw the layer from cached chunk bitmaps, false to draw its tiles every time.</param>
+     * <returns>Zero-based index of the new layer.</returns>
+     **************************************************************************************************/
+    std::size_t AddLayer(bool cached);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of layers.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The layer count.</returns>
+     **************************************************************************************************/
+    std::size_t GetLayerCount() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the tile in a cell.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          On a cached layer the cell's chunk is redrawn the next time it is visible.</remarks>
+     * <param name="layer"> Zero-based index of the layer.</param>
+     * <param name="column">Zero-based index of the column.</param>
+     * <param name="row">   Zero-based index of the row.</param>
+     * <param name="tile">  Zero-based index of the tile in the TileSet, or EMPTY_TILE.</param>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the layer or cell is outside the map.</exception>
+     **************************************************************************************************/
+    void SetTile(std::size_t layer, unsigned int column, unsigned int row, int tile);
+
+    /**************************************************************************************************
+     * <summary>Gets the tile in a cell.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="layer"> Zero-based index of the layer.</param>
+     * <param name="column">Zero-based index of the column.</param>
+     * <param name="row">   Zero-based index of the row.</param>
+     * <returns>Zero-based index of the tile in the TileSet, or EMPTY_TILE.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the layer or cell is outside the map.</exception>
+     **************************************************************************************************/
+    int GetTile(std::size_t layer, unsigned int column, unsigned int row) const;
+
+    /**************************************************************************************************
+     * <summary>Fills every cell of a layer with one tile.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="layer">Zero-based index of the layer.</param>
+     * <param name="tile"> Zero-based index of the tile in the TileSet, or EMPTY_TILE.</param>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the layer is past the last layer.</exception>
+     **************************************************************************************************/
+    void Fill(std::size_t layer, int tile);
+
+    /**************************************************************************************************
+     * <summary>Draws the part of the map a camera sees.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The map's top-left corner is the world origin. The view is drawn at the camera's
+     *          screen position and clipped to the camera's extents.</remarks>
+     * <param name="dest">  Destination to draw to. Does nothing if dest is null.</param>
+     * <param name="camera">The camera.</param>
+     **************************************************************************************************/
+    void Draw(ALLEGRO_BITMAP* dest, const Camera& camera);
+
+    /**************************************************************************************************
+     * <summary>Draws part of the map to the top-left corner of a bitmap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">       Destination to draw to. Does nothing if dest is null.</param>
+     * <param name="view_x">     The left edge of the view on the map in pixels.</param>
+     * <param name="view_y">     The top edge of the view on the map in pixels.</param>
+     * <param name="view_width"> The width of the view in pixels.</param>
+     * <param name="view_height">The height of the view in pixels.</param>
+     **************************************************************************************************/
+    void Draw(ALLEGRO_BITMAP* dest, int view_x, int view_y, int view_width, int view_height);
+
+    /**************************************************************************************************
+     * <summary>Destroys every cached chunk. They are redrawn as they come into view.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void ReleaseCache();
+
+    /**************************************************************************************************
+     * <summary>Gets the width of the map in tiles.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The number of columns.</returns>
+     **************************************************************************************************/
+    unsigned int GetColumns() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the height of the map in tiles.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The number of rows.</returns>
+     **************************************************************************************************/
+    unsigned int GetRows() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the tile set.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The tile set.</returns>
+     **************************************************************************************************/
+    TileSet& GetTileSet() const;
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>A square block of cells in one layer.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct Chunk {
+        /// <summary> The cells, row by row, CHUNK_SIZE to a row.</summary>
+        std::vector<int> tiles;
+        /// <summary> The number of cells that are not empty.</summary>
+        unsigned int tile_count;
+        /// <summary> The drawn cells, or null if not drawn yet.</summary>
+        ALLEGRO_BITMAP* cache;
+        /// <summary> true if a cell changed since the cache was drawn.</summary>
+        bool dirty;
+    };
+
+    /**************************************************************************************************
+     * <summary>One layer of the map.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct Layer {
+        /// <summary> true to draw from cached chunk bitmaps.</summary>
+        bool cached;
+        /// <summary> The chunks, row by row.</summary>
+        std::vector<Chunk> chunks;
+    };
+
+    /**************************************************************************************************
+     * <summary>Where a view of the map was drawn, so tile edits can invalidate it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct DrawnView {
+        /// <summary> Added to map x coordinates to place them on dest.</summary>
+        int offset_x;
+        /// <summary> Added to map y coordinates to place them on dest.</summary>
+        int offset_y;
+        /// <summary> The left edge of the view on dest.</summary>
+        int clip_x;
+        /// <summary> The top edge of the view on dest.</summary>
+        int clip_y;
+        /// <summary> The right edge of the view on dest, exclusive.</summary>
+        int clip_right;
+        /// <summary> The bottom edge of the view on dest, exclusive.</summary>
+        int clip_bottom;
+    };
+
+    /**************************************************************************************************
+     * <summary>Draws part of the map.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="dest">       Destination to draw to.</param>
+     * <param name="view_x">     The left edge of the view on the map in pixels.</param>
+     * <param name="view_y">     The top edge of the view on the map in pixels.</param>
+     * <param name="view_width"> The width of the view in pixels.</param>
+     * <param name="view_height">The height of the view in pixels.</param>
+     * <param name="screen_x">   The left edge of the view on dest.</param>
+     * <param name="screen_y">   The top edge of the view on dest.</param>
+     **************************************************************************************************/
+    void DrawView(ALLEGRO_BITMAP* dest, int view_x, int view_y, int view_width, int view_height, int screen_x, int screen_y);
+
+    /**************************************************************************************************
+     * <summary>Records the visible part of the map into the recording RenderCommandList.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Caches are drawn only while up to date and are never redrawn here; other chunks
+     *          record their visible tiles. Everything is cut to the clip rectangle.</remarks>
+     * <param name="dest">        Destination to draw to.</param>
+     * <param name="first_column">The first visible column.</param>
+     * <param name="first_row">   The first visible row.</param>
+     * <param name="last_column"> The last visible column.</param>
+     * <param name="last_row">    The last visible row.</param>
+     * <param name="offset_x">    Added to map x coordinates to place them on dest.</param>
+     * <param name="offset_y">    Added to map y coordinates to place them on dest.</param>
+     * <param name="clip_x">      The left edge of the view on dest.</param>
+     * <param name="clip_y">      The top edge of the view on dest.</param>
+     * <param name="clip_right">  The right edge of the view on dest, exclusive.</param>
+     * <param name="clip_bottom"> The bottom edge of the view on dest, exclusive.</param>
+     **************************************************************************************************/
+    void RecordView(ALLEGRO_BITMAP* dest, unsigned int first_column, unsigned int first_row, unsigned int last_column, unsigned int last_row, int offset_x, int offset_y, int clip_x, int clip_y, int clip_right, int clip_bottom);
+
+    /**************************************************************************************************
+     * <summary>Redraws a chunk's cache bitmap, creating it if needed.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="chunk">  [in,out] The chunk.</param>
+     * <param name="chunk_x">Zero-based index of the chunk's column of chunks.</param>
+     * <param name="chunk_y">Zero-based index of the chunk's row of chunks.</param>
+     * <returns>true if it succeeds, false if the bitmap could not be created.</returns>
+     **************************************************************************************************/
+    bool RenderChunk(Chunk& chunk, unsigned int chunk_x, unsigned int chunk_y);
+
+    /**************************************************************************************************
+     * <summary>Finds the chunk holding a cell.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="layer"> Zero-based index of the layer.</param>
+     * <param name="column">Zero-based index of the column.</param>
+     * <param name="row">   Zero-based index of the row.</param>
+     * <param name="cell">  [out] Zero-based index of the cell in the chunk.</param>
+     * <returns>The chunk.</returns>
+     * <exception cref="a2de::IndexOutOfBoundsException">Thrown when the layer or cell is outside the map.</exception>
+     **************************************************************************************************/
+    const Chunk& FindChunk(std::size_t layer, unsigned int column, unsigned int row, std::size_t& cell) const;
+
+    /**************************************************************************************************
+     * <summary>Remembers where a view was drawn; one entry is kept per place on dest.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="view">The view.</param>
+     **************************************************************************************************/
+    void RememberView(const DrawnView& view);
+
+    /**************************************************************************************************
+     * <summary>Invalidates the dirty regions covering part of the map in every view it was drawn in.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="x">     The left edge on the map in pixels.</param>
+     * <param name="y">     The top edge on the map in pixels.</param>
+     * <param name="width"> The width in pixels.</param>
+     * <param name="height">The height in pixels.</param>
+     **************************************************************************************************/
+    void InvalidateArea(int x, int y, int width, int height) const;
+
+    /// <summary> The tiles.</summary>
+    TileSet* _tile_set;
+    /// <summary> The width of the map in tiles.</summary>
+    unsigned int _columns;
+    /// <summary> The height of the map in tiles.</summary>
+    unsigned int _rows;
+    /// <summary> The width of the map in chunks.</summary>
+    unsigned int _chunk_columns;
+    /// <summary> The height of the map in chunks.</summary>
+    unsigned int _chunk_rows;
+    /// <summary> The layers, bottom first.</summary>
+    std::vector<Layer> _layers;
+    /// <summary> The views drawn so far, one per place on dest.</summary>
+    std::vector<DrawnView> _drawn_views;
+
+    TileMap(const TileMap& other);
+    TileMap& operator=(const TileMap& rhs);
+};
+
+A2DE_END
+
+#endif
@@ -12,16 +12,34 @@
 
 #include <cassert>
 #include "../a2de_exceptions.h"
+#include "CAssetPack.h"
 #include "CBitmapCache.h"
+#include "CRenderCommandList.h"
+#include "CSoftwareBlitter.h"
 
 #include <allegro5/bitmap_draw.h>
+#include <allegro5/transformations.h>
 
-
+#include <algorithm>
 
 A2DE_BEGIN
 
+namespace {
+
+    //While a list records the tile is added to it; the recording thread has no display to draw with.
+    bool RecordRegion(ALLEGRO_BITMAP* dest, ALLEGRO_BITMAP* sheet, float sx, float sy, float sw, float sh, float dx, float dy) {
+        RenderCommandList* list = RenderCommandList::GetRecording();
+        if(list == nullptr) return false;
+        ALLEGRO_TRANSFORM transform;
+        al_identity_transform(&transform);
+        al_translate_transform(&transform, dx, dy);
+        list->AddBitmap(dest, sheet, sx, sy, sw, sh, al_map_rgb(255, 255, 255), transform, 0);
+        return true;
+    }
+}
+
 TileSet* TileSet::CreateTileSet(const std::string& file, int tileWidth, int tileHeight) {
-    if(al_filename_exists(file.c_str()) == 0) {
+    if(AssetPack::FileExists(file) == false) {
         throw FileNotFoundException(file);
     }
     assert(tileWidth > 0);
@@ -62,6 +80,8 @@ TileSet::~TileSet() {
 void TileSet::DrawTile(ALLEGRO_BITMAP* dest, unsigned int column, unsigned int row, int dest_x, int dest_y) {
     if(dest == nullptr) return;
     if(column >= _max_columns || row >= _max_rows) return;
+    if(RecordRegion(dest, _tileSheet, static_cast<float>(column * _tileWidth), static_cast<float>(row * _tileHeight), static_cast<float>(_tileWidth), static_cast<float>(_tileHeight), static_cast<float>(dest_x), static_cast<float>(dest_y))) return;
+    if(SoftwareBlitter::Blit(dest, _tileSheet, static_cast<float>(column * _tileWidth), static_cast<float>(row * _tileHeight), static_cast<float>(_tileWidth), static_cast<float>(_tileHeight), al_map_rgb(255, 255, 255), static_cast<float>(dest_x), static_cast<float>(dest_y), 0)) return;
     al_draw_bitmap_region(_tileSheet, column * _tileWidth, row * _tileHeight, _tileWidth, _tileHeight, dest_x, dest_y, 0);
 }
 
@@ -75,6 +95,27 @@ void TileSet::DrawTile(ALLEGRO_BITMAP* dest, unsigned int index, int dest_x, int
     DrawTile(dest, column, row, dest_x, dest_y);
 }
 
+void TileSet::DrawTilePart(ALLEGRO_BITMAP* dest, unsigned int index, int part_x, int part_y, int part_width, int part_height, int dest_x, int dest_y) {
+    if(dest == nullptr) return;
+    if(index >= _max_tiles) return;
+
+    int left = std::max(part_x, 0);
+    int top = std::max(part_y, 0);
+    int right = std::min(part_x + part_width, static_cast<int>(_tileWidth));
+    int bottom = std::min(part_y + part_height, static_cast<int>(_tileHeight));
+    if(left >= right || top >= bottom) return;
+    dest_x += left - part_x;
+    dest_y += top - part_y;
+
+    float sx = static_cast<float>((index % _max_columns) * _tileWidth + left);
+    float sy = static_cast<float>((index / _max_columns) * _tileHeight + top);
+    float sw = static_cast<float>(right - left);
+    float sh = static_cast<float>(bottom - top);
+    if(RecordRegion(dest, _tileSheet, sx, sy, sw, sh, static_cast<float>(dest_x), static_cast<float>(dest_y))) return;
+    if(SoftwareBlitter::Blit(dest, _tileSheet, sx, sy, sw, sh, al_map_rgb(255, 255, 255), static_cast<float>(dest_x), static_cast<float>(dest_y), 0)) return;
+    al_draw_bitmap_region(_tileSheet, sx, sy, sw, sh, dest_x, dest_y, 0);
+}
+
 unsigned int TileSet::GetTileWidth() const {
     return _tileWidth;
 }
@@ -43,7 +43,8 @@ public:
 
     /**************************************************************************************************
      * <summary>Draw tiles to an ALLEGRO_BITMAP.</summary>
-     * <remarks>Casey Ugone, 4/2/2012.</remarks>
+     * <remarks>Casey Ugone, 4/2/2012.
+     *          Recorded instead when a RenderCommandList is recording.</remarks>
      * <param name="dest">  If non-null, destination ALLEGRO_BITMAP for the tile to draw to.</param>
      * <param name="column">Zero-based index of the column of the tile.</param>
      * <param name="row">   Zero-based index of the row of the tile.</param>
@@ -62,6 +63,22 @@ public:
      **************************************************************************************************/
     void DrawTile(ALLEGRO_BITMAP* dest, unsigned int index, int dest_x, int dest_y);
 
+    /**************************************************************************************************
+     * <summary>Draw part of a tile to an ALLEGRO_BITMAP, such as a tile cut by the edge of a view.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The part is clipped to the tile. Recorded instead when a RenderCommandList is
+     *          recording.</remarks>
+     * <param name="dest">       If non-null, destination ALLEGRO_BITMAP for the tile to draw to.</param>
+     * <param name="index">      Zero-based index of the tile.</param>
+     * <param name="part_x">     The left edge of the part within the tile.</param>
+     * <param name="part_y">     The top edge of the part within the tile.</param>
+     * <param name="part_width"> The width of the part.</param>
+     * <param name="part_height">The height of the part.</param>
+     * <param name="dest_x">     Destination x coordinate of the part in pixels.</param>
+     * <param name="dest_y">     Destination y coordinate of the part in pixels.</param>
+     **************************************************************************************************/
+    void DrawTilePart(ALLEGRO_BITMAP* dest, unsigned int index, int part_x, int part_y, int part_width, int part_height, int dest_x, int dest_y);
+
     /**************************************************************************************************
      * <summary>Gets the tile width in pixels.</summary>
      * <remarks>Casey Ugone, 4/3/2012.</remarks>
@@ -16,6 +16,7 @@ public:
      * <param name="dest">Destination to draw to. Does nothing if dest is null.</param>
      **************************************************************************************************/
     virtual void Draw(ALLEGRO_BITMAP* dest)=0;
+    IDrawable() : _z_index(0) { /* DO NOTHING */ }
     virtual ~IDrawable(){ /* DO NOTHING */ }
 
     void SetZIndex(unsigned long z_index);
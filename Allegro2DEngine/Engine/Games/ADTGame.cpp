@@ -22,6 +22,11 @@
 
 #include "../Input/CMouse.h"
 
+#include "../GFX/CBitmapCache.h"
+#include "../GFX/CAnimationSystem.h"
+#include "../GFX/CRenderThread.h"
+#include "../GFX/CDirtyRegions.h"
+
 A2DE_BEGIN
 
 Game::Game(a2de::GameWindow* window) : _FRAME_RATE(1.0 / 60.0), _MAX_FRAME_TIME(_FRAME_RATE * 2.0), _deltaTime(0.01), _gameTime(), _gameWindow(nullptr), _isQuitting(false), _input_handler(nullptr), _keyboard_input_handler(nullptr), _mouse_input_handler(nullptr), _joystick_input_handler(nullptr) {
@@ -77,6 +82,11 @@ void Game::deinit() {
 
     _input_handler = nullptr;
 
+    a2de::RenderThread::Stop();
+    a2de::DirtyRegions::Disable();
+    a2de::AnimationSystem::Clear();
+    a2de::BitmapCache::StopLoaders();
+
     delete _gameWindow;
     _gameWindow = nullptr;
 }
@@ -131,9 +141,26 @@ void Game::MainLoop() {
         accumulator += frameTime;
         while(accumulator >= _deltaTime) {
             this->Processing(_gameTime, _deltaTime);
+            a2de::AnimationSystem::Update(_deltaTime);
             accumulator -= _deltaTime;
         }
-        this->Render(_gameTime, _deltaTime);
+        //Spend at most a quarter frame uploading images that finished loading in the background.
+        a2de::BitmapCache::UpdateLoads(_FRAME_RATE * 0.25);
+        if(a2de::DirtyRegions::IsEnabled() && a2de::RenderThread::IsRunning() == false) {
+            //Only what changed is drawn, in one pass clipped to it, at the current step.
+            if(a2de::DirtyRegions::BeginFrame()) {
+                this->Render(_gameTime, _deltaTime, 1.0);
+                a2de::DirtyRegions::EndFrame();
+            } else {
+                //Nothing to draw until the next step.
+                al_rest(_deltaTime - accumulator);
+            }
+            continue;
+        }
+        //Recorded for the render thread when it is running, drawn here when it is not.
+        a2de::RenderThread::BeginFrame();
+        this->Render(_gameTime, _deltaTime, accumulator / _deltaTime);
+        a2de::RenderThread::EndFrame();
     }
     _gameTime.Stop();
 
@@ -173,7 +200,7 @@ void Game::Processing(a2de::StopWatch& /*gameTime*/, double /*deltaTime*/) {
 
 }
 
-void Game::Render(a2de::StopWatch& /*gameTime*/, double /*deltaTime*/) {
+void Game::Render(a2de::StopWatch& /*gameTime*/, double /*deltaTime*/, double /*alpha*/) {
 
 }
 
@@ -77,8 +77,10 @@ public:
      * <remarks>Casey Ugone, 1/3/2013.</remarks>
      * <param name="gameTime"> The elapsed time of the game.</param>
      * <param name="deltaTime">The time between frames in seconds.</param>
+     * <param name="alpha">    How far the frame is between the last Processing step and the next, from 0 to 1.
+     *                         Pass it to World::Render to draw bodies between their last two positions.</param>
      **************************************************************************************************/
-    virtual void Render(a2de::StopWatch& gameTime, double deltaTime)=0;
+    virtual void Render(a2de::StopWatch& gameTime, double deltaTime, double alpha)=0;
 
     /**************************************************************************************************
      * <summary>Clean up phase method. This method is called after the game loop to free up any memory. The user is responsible for deleting any
@@ -23,6 +23,7 @@
 #include "MathConstants.h"
 #include "CMiscMath.h"
 #include "../a2de_exceptions.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 A2DE_BEGIN
 
@@ -180,15 +181,7 @@ bool Arc::Intersects(const Vector2D& /*position*/) const {
 }
 
 void Arc::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool /*filled*/) {
-    if(dest == nullptr) return;
-
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-
-    al_set_target_bitmap(dest);
-    al_draw_arc(a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), _startAngle, _endAngle - _startAngle, _radius, color, 0.0);
-
-    al_set_target_bitmap(old_target);
-
+    PrimitiveBatch::DrawArc(dest, a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), _radius, _startAngle, _endAngle - _startAngle, color);
 }
 
 void Arc::CalculateArea() {
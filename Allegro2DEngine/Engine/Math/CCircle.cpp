@@ -21,6 +21,7 @@
 #include "CSpline.h"
 #include "CSector.h"
 #include "CVector2D.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 
 A2DE_BEGIN
@@ -209,15 +210,7 @@ bool Circle::IsTangent(const Line& line) {
 }
 
 void Circle::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool filled) {
-
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
-
-    filled ? al_draw_filled_circle(a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(_radius), color) :
-             al_draw_circle(a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(_radius), color, 0.0);
-
-    al_set_target_bitmap(old_target);
-
+    PrimitiveBatch::DrawCircle(dest, a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(_radius), color, filled);
 }
 
 void Circle::CalculateArea() {
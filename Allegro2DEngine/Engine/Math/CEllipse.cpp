@@ -20,6 +20,7 @@
 #include "CPolygon.h"
 #include "CSpline.h"
 #include "CSector.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 
 A2DE_BEGIN
@@ -236,17 +237,7 @@ void Ellipse::CalculateFoci() {
 }
 
 void Ellipse::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool filled) {
-
-    if(dest == nullptr) return;
-
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
-
-    filled ? al_draw_filled_ellipse(a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(GetHalfWidth()), a2de::Math::ToScreenScale(GetHalfHeight()), color) :
-             al_draw_ellipse(a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(GetHalfWidth()), a2de::Math::ToScreenScale(GetHalfHeight()), color, 0.0);
-
-    al_set_target_bitmap(old_target);
-
+    PrimitiveBatch::DrawEllipse(dest, a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(GetHalfWidth()), a2de::Math::ToScreenScale(GetHalfHeight()), color, filled);
 }
 
 double Ellipse::GetRadiusWidth() const {
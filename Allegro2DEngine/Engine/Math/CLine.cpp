@@ -24,6 +24,7 @@
 #include <algorithm>
 #include "../Math/CMiscMath.h"
 #include "../a2de_exceptions.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 A2DE_BEGIN
 
@@ -153,15 +154,9 @@ bool Line::operator>=(const Line& rhs) const {
 }
 
 void Line::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool /*filled*/) {
-    if(dest == nullptr) return;
-
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
     a2de::Vector2D p1 = GetPointOne();
     a2de::Vector2D p2 = GetPointTwo();
-    al_draw_line(a2de::Math::ToScreenScale(p1.GetX()), a2de::Math::ToScreenScale(p1.GetY()), a2de::Math::ToScreenScale(p2.GetX()), a2de::Math::ToScreenScale(p2.GetY()), color, 0.0);
-    al_set_target_bitmap(old_target);
-
+    PrimitiveBatch::DrawLine(dest, a2de::Math::ToScreenScale(p1.GetX()), a2de::Math::ToScreenScale(p1.GetY()), a2de::Math::ToScreenScale(p2.GetX()), a2de::Math::ToScreenScale(p2.GetY()), color);
 }
 
 Line::LINEINTERSECTIONTYPE Line::Intersects(const Line& line, Point& at) const {
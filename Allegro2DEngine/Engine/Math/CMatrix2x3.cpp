@@ -0,0 +1,144 @@
+/**************************************************************************************************
+// file:	Engine\Math\CMatrix2x3.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the affine 2x3 matrix class.
+ **************************************************************************************************/
+#include "CMatrix2x3.h"
+
+#include "CMatrix3x3.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define A2DE_MATRIX_SSE2
+#include <emmintrin.h>
+#endif
+
+A2DE_BEGIN
+
+static_assert(sizeof(Vector2D) == 2 * sizeof(double), "TransformPoints reads each Vector2D as two packed doubles.");
+
+Matrix2x3::Matrix2x3(const Matrix3x3& matrix) : _indicies() {
+    const double* m = *matrix;
+    _indicies[0] = m[0]; _indicies[1] = m[1]; _indicies[2] = m[2];
+    _indicies[3] = m[3]; _indicies[4] = m[4]; _indicies[5] = m[5];
+}
+
+Matrix2x3 Matrix2x3::GetIdentity() {
+    return Matrix2x3(1.0, 0.0, 0.0, 0.0, 1.0, 0.0);
+}
+
+Matrix2x3 Matrix2x3::GetTranslationMatrix(double x, double y) {
+    return Matrix2x3(1.0, 0.0, x, 0.0, 1.0, y);
+}
+
+Matrix2x3 Matrix2x3::GetTranslationMatrix(const Vector2D& pos) {
+    return GetTranslationMatrix(pos.GetX(), pos.GetY());
+}
+
+Matrix2x3 Matrix2x3::GetRotationMatrix(double angle) {
+    double c = std::cos(angle);
+    double s = std::sin(angle);
+    return Matrix2x3(c, -s, 0.0, s, c, 0.0);
+}
+
+Matrix2x3 Matrix2x3::GetScaleMatrix(double scale_x, double scale_y) {
+    return Matrix2x3(scale_x, 0.0, 0.0, 0.0, scale_y, 0.0);
+}
+
+Matrix2x3 Matrix2x3::GetScaleMatrix(const Vector2D& scale) {
+    return GetScaleMatrix(scale.GetX(), scale.GetY());
+}
+
+Matrix3x3 Matrix2x3::GetMatrix3x3() const {
+    return Matrix3x3(_indicies[0], _indicies[1], _indicies[2],
+                     _indicies[3], _indicies[4], _indicies[5],
+                     0.0, 0.0, 1.0);
+}
+
+void Matrix2x3::Inverse() {
+    *this = Matrix2x3::Inverse(*this);
+}
+
+Matrix2x3 Matrix2x3::Inverse(const Matrix2x3& mat) {
+
+    //Inverse the linear part, then move the translation back through it.
+    //[a b tx]     [ d -b]          [ d -b]   [tx]
+    //[c d ty] ->  [-c  a] / det, -([-c  a] * [ty]) / det
+
+    double det = mat.CalculateDeterminant();
+    assert(Math::IsEqual(det, 0.0) == false);
+    double inv_det = 1.0 / det;
+
+    double a = mat._indicies[0];
+    double b = mat._indicies[1];
+    double tx = mat._indicies[2];
+    double c = mat._indicies[3];
+    double d = mat._indicies[4];
+    double ty = mat._indicies[5];
+
+    return Matrix2x3( d * inv_det, -b * inv_det, (b * ty - d * tx) * inv_det,
+                     -c * inv_det,  a * inv_det, (c * tx - a * ty) * inv_det);
+}
+
+void Matrix2x3::TransformPoints(const Vector2D* points, Vector2D* result, std::size_t count) const {
+#ifdef A2DE_MATRIX_SSE2
+    //A point is [x y] in one register: x' y' = x * column one + y * column two + column three.
+    __m128d column_one = _mm_set_pd(_indicies[3], _indicies[0]);
+    __m128d column_two = _mm_set_pd(_indicies[4], _indicies[1]);
+    __m128d column_three = _mm_set_pd(_indicies[5], _indicies[2]);
+    const double* source = reinterpret_cast<const double*>(points);
+    double* destination = reinterpret_cast<double*>(result);
+    for(std::size_t i = 0; i < count; ++i) {
+        __m128d point = _mm_loadu_pd(source + i * 2);
+        __m128d x = _mm_unpacklo_pd(point, point);
+        __m128d y = _mm_unpackhi_pd(point, point);
+        __m128d transformed = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, column_one), _mm_mul_pd(y, column_two)), column_three);
+        _mm_storeu_pd(destination + i * 2, transformed);
+    }
+#else
+    for(std::size_t i = 0; i < count; ++i) {
+        result[i] = TransformPoint(points[i]);
+    }
+#endif
+}
+
+void Matrix2x3::TransformPoints(const double* x, const double* y, double* result_x, double* result_y, std::size_t count) const {
+    std::size_t i = 0;
+#ifdef A2DE_MATRIX_SSE2
+    //Two points at a time, each element broadcast across the register.
+    __m128d m00 = _mm_set1_pd(_indicies[0]);
+    __m128d m01 = _mm_set1_pd(_indicies[1]);
+    __m128d m02 = _mm_set1_pd(_indicies[2]);
+    __m128d m10 = _mm_set1_pd(_indicies[3]);
+    __m128d m11 = _mm_set1_pd(_indicies[4]);
+    __m128d m12 = _mm_set1_pd(_indicies[5]);
+    for(; i + 2 <= count; i += 2) {
+        __m128d px = _mm_loadu_pd(x + i);
+        __m128d py = _mm_loadu_pd(y + i);
+        __m128d rx = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m00, px), _mm_mul_pd(m01, py)), m02);
+        __m128d ry = _mm_add_pd(_mm_add_pd(_mm_mul_pd(m10, px), _mm_mul_pd(m11, py)), m12);
+        _mm_storeu_pd(result_x + i, rx);
+        _mm_storeu_pd(result_y + i, ry);
+    }
+#endif
+    for(; i < count; ++i) {
+        double px = x[i];
+        double py = y[i];
+        result_x[i] = _indicies[0] * px + _indicies[1] * py + _indicies[2];
+        result_y[i] = _indicies[3] * px + _indicies[4] * py + _indicies[5];
+    }
+}
+
+bool Matrix2x3::operator==(const Matrix2x3& rhs) const {
+    return (   Math::IsEqual(_indicies[0], rhs._indicies[0]) && Math::IsEqual(_indicies[1], rhs._indicies[1]) && Math::IsEqual(_indicies[2], rhs._indicies[2])
+            && Math::IsEqual(_indicies[3], rhs._indicies[3]) && Math::IsEqual(_indicies[4], rhs._indicies[4]) && Math::IsEqual(_indicies[5], rhs._indicies[5]));
+}
+
+bool Matrix2x3::operator!=(const Matrix2x3& rhs) const {
+    return !(*this == rhs);
+}
+
+A2DE_END
@@ -0,0 +1,333 @@
+/**************************************************************************************************
+// file:	Engine\Math\CMatrix2x3.h
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the affine 2x3 matrix class.
+ **************************************************************************************************/
+#ifndef A2DE_CMATRIX2X3_H
+#define A2DE_CMATRIX2X3_H
+
+#include "../a2de_vals.h"
+#include "CVector2D.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+A2DE_BEGIN
+
+class Matrix3x3;
+
+/**************************************************************************************************
+ * <summary>A 2D affine transform: the top two rows of a Matrix3x3 whose bottom row is 0 0 1.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Points are column vectors, so x' = m00 * x + m01 * y + m02. Composing and transforming
+ *          skip the multiplications by the constant bottom row, and no Vector3D is built, so a
+ *          point costs four multiplies and four adds. TransformPoints does whole arrays with SSE2,
+ *          one point per register for arrays of Vector2D and two for separate x and y arrays.</remarks>
+ **************************************************************************************************/
+class Matrix2x3 {
+public:
+
+    /**************************************************************************************************
+     * <summary>Default constructor. The matrix is the identity.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    Matrix2x3();
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="m00">First row, first column.</param>
+     * <param name="m01">First row, second column.</param>
+     * <param name="m02">First row, third column.</param>
+     * <param name="m10">Second row, first column.</param>
+     * <param name="m11">Second row, second column.</param>
+     * <param name="m12">Second row, third column.</param>
+     **************************************************************************************************/
+    Matrix2x3(double m00, double m01, double m02, double m10, double m11, double m12);
+
+    /**************************************************************************************************
+     * <summary>Constructor. Keeps the top two rows of a Matrix3x3.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The bottom row is dropped, so the result only matches for affine matrices.</remarks>
+     * <param name="matrix">The matrix.</param>
+     **************************************************************************************************/
+    explicit Matrix2x3(const Matrix3x3& matrix);
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    Matrix2x3(const Matrix2x3& other);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~Matrix2x3();
+
+    /**************************************************************************************************
+     * <summary>Gets the identity matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The identity matrix.</returns>
+     **************************************************************************************************/
+    static Matrix2x3 GetIdentity();
+
+    /**************************************************************************************************
+     * <summary>Gets a translation matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="x">The x coordinate.</param>
+     * <param name="y">The y coordinate.</param>
+     * <returns>The translation matrix.</returns>
+     **************************************************************************************************/
+    static Matrix2x3 GetTranslationMatrix(double x, double y);
+
+    /**************************************************************************************************
+     * <summary>Gets a translation matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="pos">The position.</param>
+     * <returns>The translation matrix.</returns>
+     **************************************************************************************************/
+    static Matrix2x3 GetTranslationMatrix(const a2de::Vector2D& pos);
+
+    /**************************************************************************************************
+     * <summary>Gets a rotation matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="angle">The angle in radians.</param>
+     * <returns>The rotation matrix.</returns>
+     **************************************************************************************************/
+    static Matrix2x3 GetRotationMatrix(double angle);
+
+    /**************************************************************************************************
+     * <summary>Gets a scale matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="scale_x">The horizontal scale.</param>
+     * <param name="scale_y">The vertical scale.</param>
+     * <returns>The scale matrix.</returns>
+     **************************************************************************************************/
+    static Matrix2x3 GetScaleMatrix(double scale_x, double scale_y);
+
+    /**************************************************************************************************
+     * <summary>Gets a scale matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="scale">The scale.</param>
+     * <returns>The scale matrix.</returns>
+     **************************************************************************************************/
+    static Matrix2x3 GetScaleMatrix(const a2de::Vector2D& scale);
+
+    /**************************************************************************************************
+     * <summary>Gets the Matrix3x3 with this as its top two rows and 0 0 1 as its bottom row.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The matrix.</returns>
+     **************************************************************************************************/
+    Matrix3x3 GetMatrix3x3() const;
+
+    /**************************************************************************************************
+     * <summary>Gets an element.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="row">   The row, 0 or 1.</param>
+     * <param name="column">The column, 0 to 2.</param>
+     * <returns>The element.</returns>
+     **************************************************************************************************/
+    double GetIndex(std::size_t row, std::size_t column) const;
+
+    /**************************************************************************************************
+     * <summary>Sets an element.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="row">   The row, 0 or 1.</param>
+     * <param name="column">The column, 0 to 2.</param>
+     * <param name="value"> The value.</param>
+     **************************************************************************************************/
+    void SetIndex(std::size_t row, std::size_t column, double value);
+
+    /**************************************************************************************************
+     * <summary>Calculates the determinant of the linear part.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Equal to the determinant of the matching Matrix3x3.</remarks>
+     * <returns>The determinant.</returns>
+     **************************************************************************************************/
+    double CalculateDeterminant() const;
+
+    /**************************************************************************************************
+     * <summary>Inverses this matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The determinant must not be zero.</remarks>
+     **************************************************************************************************/
+    void Inverse();
+
+    /**************************************************************************************************
+     * <summary>Inverses the given matrix.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The determinant must not be zero.</remarks>
+     * <param name="mat">The matrix.</param>
+     * <returns>The inverse.</returns>
+     **************************************************************************************************/
+    static Matrix2x3 Inverse(const Matrix2x3& mat);
+
+    /**************************************************************************************************
+     * <summary>Transforms a point, translation included.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="point">The point.</param>
+     * <returns>The transformed point.</returns>
+     **************************************************************************************************/
+    Vector2D TransformPoint(const Vector2D& point) const;
+
+    /**************************************************************************************************
+     * <summary>Transforms a direction, translation left out.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="vector">The direction.</param>
+     * <returns>The transformed direction.</returns>
+     **************************************************************************************************/
+    Vector2D TransformVector(const Vector2D& vector) const;
+
+    /**************************************************************************************************
+     * <summary>Transforms an array of points, translation included.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          result may be the same array as points.</remarks>
+     * <param name="points">The points.</param>
+     * <param name="result">[out] Receives the transformed points.</param>
+     * <param name="count"> The number of points.</param>
+     **************************************************************************************************/
+    void TransformPoints(const Vector2D* points, Vector2D* result, std::size_t count) const;
+
+    /**************************************************************************************************
+     * <summary>Transforms points kept as separate arrays of x and y coordinates, translation included.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Results may be written over the inputs.</remarks>
+     * <param name="x">       The x coordinates.</param>
+     * <param name="y">       The y coordinates.</param>
+     * <param name="result_x">[out] Receives the transformed x coordinates.</param>
+     * <param name="result_y">[out] Receives the transformed y coordinates.</param>
+     * <param name="count">   The number of points.</param>
+     **************************************************************************************************/
+    void TransformPoints(const double* x, const double* y, double* result_x, double* result_y, std::size_t count) const;
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    Matrix2x3& operator=(const Matrix2x3& rhs);
+
+    /**************************************************************************************************
+     * <summary>Multiplication operator. The result applies rhs first, then this.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>The result of the operation.</returns>
+     **************************************************************************************************/
+    Matrix2x3 operator*(const Matrix2x3& rhs) const;
+
+    /**************************************************************************************************
+     * <summary>Multiplication operator. Transforms a point, translation included.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>The result of the operation.</returns>
+     **************************************************************************************************/
+    Vector2D operator*(const Vector2D& rhs) const;
+
+    /**************************************************************************************************
+     * <summary>Multiplication assignment operator.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>The result of the operation.</returns>
+     **************************************************************************************************/
+    Matrix2x3& operator*=(const Matrix2x3& rhs);
+
+    /**************************************************************************************************
+     * <summary>Equality operator.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>true if the parameters are considered equivalent.</returns>
+     **************************************************************************************************/
+    bool operator==(const Matrix2x3& rhs) const;
+
+    /**************************************************************************************************
+     * <summary>Inequality operator.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>true if the parameters are not considered equivalent.</returns>
+     **************************************************************************************************/
+    bool operator!=(const Matrix2x3& rhs) const;
+
+protected:
+private:
+
+    //[00 01 02] [0 1 2]
+    //[10 11 12] [3 4 5]
+
+    /// <summary> The elements, row by row.</summary>
+    std::array<double, 6> _indicies;
+
+};
+
+//Composing and transforming single points are small enough to inline; the array kernels are in the .cpp.
+
+inline Matrix2x3::Matrix2x3() : _indicies() {
+    _indicies[0] = 1.0; _indicies[1] = 0.0; _indicies[2] = 0.0;
+    _indicies[3] = 0.0; _indicies[4] = 1.0; _indicies[5] = 0.0;
+}
+
+inline Matrix2x3::Matrix2x3(double m00, double m01, double m02, double m10, double m11, double m12) : _indicies() {
+    _indicies[0] = m00; _indicies[1] = m01; _indicies[2] = m02;
+    _indicies[3] = m10; _indicies[4] = m11; _indicies[5] = m12;
+}
+
+inline Matrix2x3::Matrix2x3(const Matrix2x3& other) : _indicies(other._indicies) { /* DO NOTHING */ }
+inline Matrix2x3::~Matrix2x3() { /* DO NOTHING */ }
+
+inline double Matrix2x3::GetIndex(std::size_t row, std::size_t column) const {
+    assert(row < 2 && column < 3);
+    return _indicies[row * 3 + column];
+}
+
+inline void Matrix2x3::SetIndex(std::size_t row, std::size_t column, double value) {
+    assert(row < 2 && column < 3);
+    _indicies[row * 3 + column] = value;
+}
+
+inline double Matrix2x3::CalculateDeterminant() const {
+    return _indicies[0] * _indicies[4] - _indicies[1] * _indicies[3];
+}
+
+inline Vector2D Matrix2x3::TransformPoint(const Vector2D& point) const {
+    double x = point.GetX();
+    double y = point.GetY();
+    return Vector2D(_indicies[0] * x + _indicies[1] * y + _indicies[2],
+                    _indicies[3] * x + _indicies[4] * y + _indicies[5]);
+}
+
+inline Vector2D Matrix2x3::TransformVector(const Vector2D& vector) const {
+    double x = vector.GetX();
+    double y = vector.GetY();
+    return Vector2D(_indicies[0] * x + _indicies[1] * y,
+                    _indicies[3] * x + _indicies[4] * y);
+}
+
+inline Matrix2x3& Matrix2x3::operator=(const Matrix2x3& rhs) {
+    _indicies = rhs._indicies;
+    return *this;
+}
+
+inline Matrix2x3 Matrix2x3::operator*(const Matrix2x3& rhs) const {
+    const double* a = &_indicies[0];
+    const double* b = &rhs._indicies[0];
+    return Matrix2x3(a[0] * b[0] + a[1] * b[3], a[0] * b[1] + a[1] * b[4], a[0] * b[2] + a[1] * b[5] + a[2],
+                     a[3] * b[0] + a[4] * b[3], a[3] * b[1] + a[4] * b[4], a[3] * b[2] + a[4] * b[5] + a[5]);
+}
+
+inline Vector2D Matrix2x3::operator*(const Vector2D& rhs) const {
+    return TransformPoint(rhs);
+}
+
+inline Matrix2x3& Matrix2x3::operator*=(const Matrix2x3& rhs) {
+    *this = *this * rhs;
+    return *this;
+}
+
+A2DE_END
+
+#endif
@@ -250,31 +250,28 @@ bool Matrix3x3::operator!=(const Matrix3x3& rhs) {
     return static_cast<const Matrix3x3&>(*this).operator!=(rhs);
 }
 
-a2de::Matrix3x3 Matrix3x3::operator*(const Matrix3x3& rhs) {
-
-    a2de::Vector3D r1(this->GetRowOne());
-    a2de::Vector3D r2(this->GetRowTwo());
-    a2de::Vector3D r3(this->GetRowThree());
-
-    a2de::Vector3D c1(rhs.GetColumnOne());
-    a2de::Vector3D c2(rhs.GetColumnTwo());
-    a2de::Vector3D c3(rhs.GetColumnThree());
-
-    return Matrix3x3(a2de::Vector3D::DotProduct(r1, c1), a2de::Vector3D::DotProduct(r1, c2), a2de::Vector3D::DotProduct(r1, c3),
-                     a2de::Vector3D::DotProduct(r2, c1), a2de::Vector3D::DotProduct(r2, c2), a2de::Vector3D::DotProduct(r2, c3),
-                     a2de::Vector3D::DotProduct(r3, c1), a2de::Vector3D::DotProduct(r3, c2), a2de::Vector3D::DotProduct(r3, c3));
+a2de::Matrix3x3 Matrix3x3::operator*(const Matrix3x3& rhs) const {
+    //Indexed directly; building row and column Vector3Ds costs an atan2 each.
+    const double* a = &_indicies[0];
+    const double* b = &rhs._indicies[0];
+    return Matrix3x3(a[0] * b[0] + a[1] * b[3] + a[2] * b[6], a[0] * b[1] + a[1] * b[4] + a[2] * b[7], a[0] * b[2] + a[1] * b[5] + a[2] * b[8],
+                     a[3] * b[0] + a[4] * b[3] + a[5] * b[6], a[3] * b[1] + a[4] * b[4] + a[5] * b[7], a[3] * b[2] + a[4] * b[5] + a[5] * b[8],
+                     a[6] * b[0] + a[7] * b[3] + a[8] * b[6], a[6] * b[1] + a[7] * b[4] + a[8] * b[7], a[6] * b[2] + a[7] * b[5] + a[8] * b[8]);
 }
 
-a2de::Matrix3x3 Matrix3x3::operator*(double scalar) {
+a2de::Matrix3x3 Matrix3x3::operator*(double scalar) const {
     return Matrix3x3(scalar * _indicies[0], scalar * _indicies[1], scalar * _indicies[2],
                      scalar * _indicies[3], scalar * _indicies[4], scalar * _indicies[5],
                      scalar * _indicies[6], scalar * _indicies[7], scalar * _indicies[8]);
 }
 
 a2de::Vector3D Matrix3x3::operator*(const Vector3D& rhs) const {
-    return Vector3D(a2de::Vector3D::DotProduct(this->GetRowOne(),   rhs),
-                    a2de::Vector3D::DotProduct(this->GetRowTwo(),   rhs),
-                    a2de::Vector3D::DotProduct(this->GetRowThree(), rhs));
+    double x = rhs.GetX();
+    double y = rhs.GetY();
+    double z = rhs.GetZ();
+    return Vector3D(_indicies[0] * x + _indicies[1] * y + _indicies[2] * z,
+                    _indicies[3] * x + _indicies[4] * y + _indicies[5] * z,
+                    _indicies[6] * x + _indicies[7] * y + _indicies[8] * z);
 }
 
 a2de::Vector3D Matrix3x3::operator*(const Vector3D& rhs) {
@@ -286,21 +283,8 @@ const double * const Matrix3x3::operator*() const {
 }
 
 Matrix3x3& Matrix3x3::operator*=(const Matrix3x3& rhs) {
-    if(this == &rhs) return *this;
-
-    _indicies[0] = a2de::Vector3D::DotProduct(this->GetRowOne(), rhs.GetColumnOne());
-    _indicies[1] = a2de::Vector3D::DotProduct(this->GetRowOne(), rhs.GetColumnTwo());
-    _indicies[2] = a2de::Vector3D::DotProduct(this->GetRowOne(), rhs.GetColumnThree());
-
-    _indicies[3] = a2de::Vector3D::DotProduct(this->GetRowTwo(), rhs.GetColumnOne());
-    _indicies[4] = a2de::Vector3D::DotProduct(this->GetRowTwo(), rhs.GetColumnTwo());
-    _indicies[5] = a2de::Vector3D::DotProduct(this->GetRowTwo(), rhs.GetColumnThree());
-
-    _indicies[6] = a2de::Vector3D::DotProduct(this->GetRowThree(), rhs.GetColumnOne());
-    _indicies[7] = a2de::Vector3D::DotProduct(this->GetRowThree(), rhs.GetColumnTwo());
-    _indicies[8] = a2de::Vector3D::DotProduct(this->GetRowThree(), rhs.GetColumnThree());
-
-
+    //Through a temporary, so each row is read before it is overwritten and m *= m squares m.
+    *this = *this * rhs;
     return *this;
 }
 
@@ -399,9 +383,7 @@ Matrix3x3 operator*(double scalar, const Matrix3x3& rhs) {
 }
 
 a2de::Vector3D operator*(const Matrix3x3& lhs, const Vector3D& rhs) {
-    return Vector3D(a2de::Vector3D::DotProduct(lhs.GetRowOne(), rhs),
-                    a2de::Vector3D::DotProduct(lhs.GetRowTwo(), rhs),
-                    a2de::Vector3D::DotProduct(lhs.GetRowThree(), rhs));
+    return lhs.operator*(rhs);
 }
 
 
@@ -352,7 +352,7 @@ public:
      * <param name="rhs">The right hand side.</param>
      * <returns>The result of the operation.</returns>
      **************************************************************************************************/
-    Matrix3x3 operator*(const Matrix3x3& rhs);
+    Matrix3x3 operator*(const Matrix3x3& rhs) const;
 
     /**************************************************************************************************
      * <summary>Multiplication operator.</summary>
@@ -360,7 +360,7 @@ public:
      * <param name="scalar">The scalar.</param>
      * <returns>The result of the operation.</returns>
      **************************************************************************************************/
-    Matrix3x3 operator*(double scalar);
+    Matrix3x3 operator*(double scalar) const;
 
     /**************************************************************************************************
      * <summary>Multiplication operator.</summary>
@@ -14,10 +14,7 @@ A2DE_BEGIN
 
 namespace Math {
 
-    namespace {
-        /// <summary> The meter to pixel scale ratio </summary>
-        double WORLD_SCALE = 0.01;
-    }
+    double WORLD_SCALE = 0.01;
 
 double a2de::Math::DegreeToRadian(double degree) {
     return degree * A2DE_RADIAN;
@@ -41,37 +38,55 @@ CartesianCoordinate PolarToCartesian(const PolarCoordinate& coordinate) {
     return cartesian;
 }
 
-bool IsEqual(double a, double b) {
-    double ZERO_DELTA_EPSILON = 0.0001;
-    return std::fabs(a - b) <= ZERO_DELTA_EPSILON;
-}
-
 void SetWorldScale(double scale) {
     WORLD_SCALE = scale;
 }
 
-double ToWorldScale(double pixel) {
-    return pixel * WORLD_SCALE;
-}
-
-double ToScreenScale(double meter) {
-    return meter / WORLD_SCALE;
-}
-
-a2de::Vector2D ToWorldScale(const a2de::Vector2D& pixel) {
+a2de::Vector3D ToWorldScale(const a2de::Vector3D& pixel) {
     return pixel * WORLD_SCALE;
 }
 
-a2de::Vector2D ToScreenScale(const a2de::Vector2D& meter) {
+a2de::Vector3D ToScreenScale(const a2de::Vector3D& meter) {
     return meter / WORLD_SCALE;
 }
 
-a2de::Vector3D ToWorldScale(const a2de::Vector3D& pixel) {
-    return pixel * WORLD_SCALE;
-}
+bool IntersectSegmentBox(const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& box_min, const a2de::Vector2D& box_max, double& fraction, a2de::Vector2D& normal) {
+
+    //Slab test: clip the segment against the x and y slabs in turn and keep the latest entry.
+    double origin[2] = { start.GetX(), start.GetY() };
+    double direction[2] = { end.GetX() - start.GetX(), end.GetY() - start.GetY() };
+    double minimum[2] = { box_min.GetX(), box_min.GetY() };
+    double maximum[2] = { box_max.GetX(), box_max.GetY() };
+
+    double t_enter = 0.0;
+    double t_exit = 1.0;
+    int enter_axis = -1;
+    double enter_sign = 0.0;
+    for(int axis = 0; axis < 2; ++axis) {
+        if(direction[axis] == 0.0) {
+            if(origin[axis] < minimum[axis] || origin[axis] > maximum[axis]) return false;
+            continue;
+        }
+        double inverse = 1.0 / direction[axis];
+        double t_near = (minimum[axis] - origin[axis]) * inverse;
+        double t_far = (maximum[axis] - origin[axis]) * inverse;
+        double sign = -1.0;
+        if(t_near > t_far) {
+            std::swap(t_near, t_far);
+            sign = 1.0;
+        }
+        if(t_near > t_enter) {
+            t_enter = t_near;
+            enter_axis = axis;
+            enter_sign = sign;
+        }
+        if(t_far < t_exit) t_exit = t_far;
+        if(t_enter > t_exit) return false;
+    }
 
-a2de::Vector3D ToScreenScale(const a2de::Vector3D& meter) {
-    return meter / WORLD_SCALE;
+    fraction = t_enter;
+    normal = a2de::Vector2D(enter_axis == 0 ? enter_sign : 0.0, enter_axis == 1 ? enter_sign : 0.0);
+    return true;
 }
 
 } //End namespace Math
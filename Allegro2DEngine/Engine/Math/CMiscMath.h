@@ -133,6 +133,39 @@ namespace Math {
      **************************************************************************************************/
     a2de::Vector3D ToWorldScale(const a2de::Vector3D& pixels);
 
+    /**************************************************************************************************
+     * <summary>Intersects a line segment with an axis-aligned box.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          If the segment starts inside the box the fraction is zero and the normal is the zero
+     *          vector.</remarks>
+     * <param name="start">  The start of the segment.</param>
+     * <param name="end">    The end of the segment.</param>
+     * <param name="box_min">The minimum corner of the box.</param>
+     * <param name="box_max">The maximum corner of the box.</param>
+     * <param name="fraction">[out] The distance along the segment of the entry point, from 0 to 1.</param>
+     * <param name="normal">[out] The normal of the face that was entered.</param>
+     * <returns>true if the segment touches the box, false if not.</returns>
+     **************************************************************************************************/
+    bool IntersectSegmentBox(const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& box_min, const a2de::Vector2D& box_max, double& fraction, a2de::Vector2D& normal);
+
+    /// <summary> The meter to pixel scale ratio. Change it with SetWorldScale.</summary>
+    extern double WORLD_SCALE;
+
+    //Defined here so they can be inlined. The Vector2D overloads are defined in CVector2D.h.
+
+    inline bool IsEqual(double a, double b) {
+        double ZERO_DELTA_EPSILON = 0.0001;
+        return std::fabs(a - b) <= ZERO_DELTA_EPSILON;
+    }
+
+    inline double ToWorldScale(double pixel) {
+        return pixel * WORLD_SCALE;
+    }
+
+    inline double ToScreenScale(double meter) {
+        return meter / WORLD_SCALE;
+    }
+
 }
 
 A2DE_END
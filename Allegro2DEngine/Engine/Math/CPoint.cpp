@@ -23,6 +23,7 @@
 #include "CVector2D.h"
 
 #include "../a2de_exceptions.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 A2DE_BEGIN
 
@@ -280,10 +281,7 @@ Point& Point::operator/=(double scalar) {
 }
 
 void Point::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool /*filled*/) {
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
-    al_draw_pixel(a2de::Math::ToScreenScale(this->GetX()), a2de::Math::ToScreenScale(this->GetY()), color);
-    al_set_target_bitmap(old_target);
+    PrimitiveBatch::DrawPixel(dest, a2de::Math::ToScreenScale(this->GetX()), a2de::Math::ToScreenScale(this->GetY()), color);
 }
 
 void Point::CalculateArea() { /* DO NOTHING */ }
@@ -24,8 +24,8 @@
 #include <algorithm>
 #include <cfloat>
 #include "../a2de_exceptions.h"
+#include "../GFX/CPrimitiveBatch.h"
 
-#include <iostream>
 
 A2DE_BEGIN
 
@@ -148,11 +148,17 @@ bool Polygon::Intersects(const Polygon& polygon) const {
     }
     return false;
 }
-void Polygon::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& /*color*/, bool /*filled*/) {
+void Polygon::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool filled) {
     if(dest == nullptr) return;
 
-    std::cout << "Polygon drawing not supported in Allegro 5.0.10" << std::endl;
-
+    std::vector<float> vertices;
+    vertices.reserve(_points.size() * 2);
+    for(std::vector<Point>::const_iterator _iter = _points.begin(); _iter != _points.end(); ++_iter) {
+        vertices.push_back(a2de::Math::ToScreenScale(_iter->GetX()));
+        vertices.push_back(a2de::Math::ToScreenScale(_iter->GetY()));
+    }
+    if(vertices.empty()) return;
+    PrimitiveBatch::DrawPolygon(dest, &vertices[0], _points.size(), color, filled);
 }
 
 bool Polygon::Intersects(const Arc& /*arc*/) const {
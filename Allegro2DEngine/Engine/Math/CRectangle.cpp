@@ -25,6 +25,7 @@
 
 #include "CMiscMath.h"
 #include "../a2de_exceptions.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 A2DE_BEGIN
 
@@ -187,13 +188,7 @@ void Rectangle::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool fill
     double x2 = a2de::Math::ToScreenScale(GetX() + GetHalfWidth());
     double y2 = a2de::Math::ToScreenScale(GetY() + GetHalfHeight());
 
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
-
-    filled ? al_draw_filled_rectangle(x1, y1, x2, y2, color) : al_draw_rectangle(x1, y1, x2, y2, color, 0.0);
-
-    al_set_target_bitmap(old_target);
-
+    PrimitiveBatch::DrawRectangle(dest, x1, y1, x2, y2, color, filled);
 }
 
 bool Rectangle::Intersects(const Polygon& polygon) const {
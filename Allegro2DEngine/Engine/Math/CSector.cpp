@@ -20,6 +20,7 @@
 #include "MathConstants.h"
 #include "CMiscMath.h"
 #include "../a2de_exceptions.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 A2DE_BEGIN
 
@@ -144,22 +145,8 @@ Point Sector::GetArcCenterPoint() const {
 
 
 void Sector::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool filled) {
-
-    Line initial(GetPosition(), GetStartPoint().GetPosition(), color);
-    Line terminal(GetPosition(), GetEndPoint().GetPosition(), color);
-
-    initial.Draw(dest, initial.GetColor(), false);
-    terminal.Draw(dest, terminal.GetColor(), false);
-
-    _arc.Draw(dest, color, filled);
-
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-
-    filled ? al_draw_filled_pieslice(a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(GetRadius()), GetStartAngle(), GetEndAngle() - GetStartAngle(), color) :
-             al_draw_pieslice(a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(GetRadius()), GetStartAngle(), GetEndAngle() - GetStartAngle(), color, 0.0);
-
-    al_set_target_bitmap(old_target);
-
+    //The slice's outline already includes both radii and the arc.
+    PrimitiveBatch::DrawPieslice(dest, a2de::Math::ToScreenScale(GetX()), a2de::Math::ToScreenScale(GetY()), a2de::Math::ToScreenScale(GetRadius()), GetStartAngle(), GetEndAngle() - GetStartAngle(), color, filled);
 }
 
 void Sector::CalculateArea() {
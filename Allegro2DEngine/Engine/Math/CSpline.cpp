@@ -20,6 +20,7 @@
 #include "CSector.h"
 
 #include "CMiscMath.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 A2DE_BEGIN
 
@@ -112,16 +113,13 @@ void Spline::AdjustControlPoint(unsigned int number, const Point& value) {
 void Spline::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool /*filled*/) {
     if(dest == nullptr) return;
 
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
     float points[8] = {
         a2de::Math::ToScreenScale(_control_points.at(0).GetX()), a2de::Math::ToScreenScale(_control_points.at(0).GetY()),
         a2de::Math::ToScreenScale(_control_points.at(1).GetX()), a2de::Math::ToScreenScale(_control_points.at(1).GetY()),
         a2de::Math::ToScreenScale(_control_points.at(2).GetX()), a2de::Math::ToScreenScale(_control_points.at(2).GetY()),
         a2de::Math::ToScreenScale(_control_points.at(3).GetX()), a2de::Math::ToScreenScale(_control_points.at(3).GetY()),
         };
-    al_draw_spline(points, color, 0.0);
-    al_set_target_bitmap(old_target);
+    PrimitiveBatch::DrawSpline(dest, points, color);
 }
 
 bool Spline::Intersects(const Shape& shape) const {
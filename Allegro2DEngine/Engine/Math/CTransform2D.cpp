@@ -1,5 +1,7 @@
 #include "CTransform2D.h"
 
+#include <algorithm>
+
 #include "CVector2D.h"
 #include "CVector3D.h"
 
@@ -12,7 +14,12 @@ _scale(1.0, 1.0),
 _rotation(),
 _curChildIndex(0),
 _parent(nullptr),
-_children()
+_children(),
+_rotation_scale(),
+_local(),
+_world(),
+_local_dirty(true),
+_world_dirty(true)
 {
     /* DO NOTHING */
 }
@@ -22,21 +29,31 @@ _position(),
 _scale(1.0, 1.0),
 _rotation(),
 _curChildIndex(0),
-_parent(parent),
-_children()
+_parent(nullptr),
+_children(),
+_rotation_scale(),
+_local(),
+_world(),
+_local_dirty(true),
+_world_dirty(true)
 {
-    /* DO NOTHING */
+    SetParent(parent);
 }
 
 Transform2D::Transform2D(const Transform2D& other) :
 _position(other._position),
 _scale(other._scale),
 _rotation(other._rotation),
-_curChildIndex(other._curChildIndex),
-_parent(other._parent),
-_children(other._children)
+_curChildIndex(0),
+_parent(nullptr),
+_children(),
+_rotation_scale(),
+_local(),
+_world(),
+_local_dirty(true),
+_world_dirty(true)
 {
-    /* DO NOTHING */
+    SetParent(other._parent);
 }
 
 Transform2D& Transform2D::operator=(const Transform2D& rhs) {
@@ -45,30 +62,44 @@ Transform2D& Transform2D::operator=(const Transform2D& rhs) {
     this->_position = rhs._position;
     this->_scale = rhs._scale;
     this->_rotation = rhs._rotation;
-    this->_curChildIndex = rhs._curChildIndex;
-    this->_parent = rhs._parent;
-    this->_children = rhs._children;
+    MarkLocalDirty();
+    SetParent(rhs._parent);
 
     return *this;
 }
 
 Transform2D::~Transform2D() {
+    SetParent(nullptr);
+    for(std::vector<Transform2D*>::iterator _iter = _children.begin(); _iter != _children.end(); ++_iter) {
+        (*_iter)->_parent = nullptr;
+        (*_iter)->MarkWorldDirty();
+    }
     _children.clear();
-    _parent = nullptr;
 }
 
 void Transform2D::SetParent(Transform2D* parent) {
+    if(parent == _parent || parent == this) return;
+    if(_parent != nullptr) {
+        std::vector<Transform2D*>& siblings(_parent->_children);
+        siblings.erase(std::remove(siblings.begin(), siblings.end(), this), siblings.end());
+    }
     _parent = parent;
+    if(_parent != nullptr) _parent->_children.push_back(this);
+    MarkWorldDirty();
 }
 
 void Transform2D::AddChild(Transform2D* child) {
     if(child == nullptr) return;
-    _children.push_back(child);
+    child->SetParent(this);
 }
 
 void Transform2D::RemoveChild(Transform2D* child) {
     if(child == nullptr) return;
     if(_children.empty()) return;
+    if(child->_parent == this) {
+        child->SetParent(nullptr);
+        return;
+    }
     _children.erase(std::remove(_children.begin(), _children.end(), child), _children.end());
 }
 
@@ -118,6 +149,7 @@ std::vector<Transform2D*>::size_type Transform2D::GetChildCount() {
 
 void Transform2D::SetPosition(const a2de::Vector2D& position) {
     _position = position;
+    MarkLocalDirty();
 }
 
 const a2de::Vector2D& Transform2D::GetPosition() const {
@@ -125,11 +157,13 @@ const a2de::Vector2D& Transform2D::GetPosition() const {
 }
 
 a2de::Vector2D& Transform2D::GetPosition() {
+    MarkLocalDirty();
     return const_cast<a2de::Vector2D&>(static_cast<const Transform2D&>(*this).GetPosition());
 }
 
 void Transform2D::SetRotation(double rotation) {
     _rotation = rotation;
+    MarkLocalDirty();
 }
 
 double Transform2D::GetRotation() const {
@@ -142,6 +176,7 @@ double Transform2D::GetRotation() {
 
 void Transform2D::SetScale(const a2de::Vector2D& scale) {
     _scale = scale;
+    MarkLocalDirty();
 }
 
 const a2de::Vector2D& Transform2D::GetScale() const {
@@ -149,16 +184,12 @@ const a2de::Vector2D& Transform2D::GetScale() const {
 }
 
 a2de::Vector2D& Transform2D::GetScale() {
-    return const_cast<a2de::Vector2D&>(static_cast<const Transform2D&>(*this).GetPosition());
+    MarkLocalDirty();
+    return const_cast<a2de::Vector2D&>(static_cast<const Transform2D&>(*this).GetScale());
 }
 
 a2de::Matrix3x3 Transform2D::GetLocalTransform() const {
-    Matrix3x3 p((_parent ? _parent->GetLocalTransform() : a2de::Matrix3x3::GetIdentity()));
-    Matrix3x3 t(a2de::Matrix3x3::GetTranslationMatrix(_position));
-    Matrix3x3 r(a2de::Matrix3x3::GetRotationMatrix(_rotation));
-    Matrix3x3 s(a2de::Matrix3x3::GetScaleMatrix(_scale));
-
-    return (p * t * r * s);
+    return GetWorldTransform();
 }
 
 a2de::Matrix3x3 Transform2D::GetLocalTransform() {
@@ -167,13 +198,58 @@ a2de::Matrix3x3 Transform2D::GetLocalTransform() {
 
 a2de::Matrix3x3 Transform2D::RotateAround(const a2de::Vector2D& point) {
 
-    Matrix3x3 p((_parent ? _parent->GetLocalTransform() : a2de::Matrix3x3::GetIdentity()));
+    UpdateLocal();
+    Matrix3x3 p((_parent ? _parent->GetWorldTransform() : a2de::Matrix3x3::GetIdentity()));
     Matrix3x3 t(a2de::Matrix3x3::GetTranslationMatrix(point));
     Matrix3x3 t_inv(a2de::Matrix3x3::GetTranslationMatrix(-point));
+
+    return p * t * _rotation_scale * t_inv;
+}
+
+const a2de::Matrix3x3& Transform2D::GetWorldTransform() const {
+    if(_world_dirty == false) return _world;
+    UpdateLocal();
+    if(_parent != nullptr) {
+        Matrix3x3 p(_parent->GetWorldTransform());
+        _world = p * _local;
+    } else {
+        _world = _local;
+    }
+    _world_dirty = false;
+    return _world;
+}
+
+void Transform2D::UpdateHierarchy() {
+    //Ancestors first, then each level below; a parent is always clean before its children.
+    std::vector<Transform2D*> queue(1, this);
+    for(std::size_t i = 0; i < queue.size(); ++i) {
+        Transform2D* current = queue[i];
+        current->GetWorldTransform();
+        queue.insert(queue.end(), current->_children.begin(), current->_children.end());
+    }
+}
+
+void Transform2D::MarkLocalDirty() {
+    _local_dirty = true;
+    MarkWorldDirty();
+}
+
+void Transform2D::MarkWorldDirty() {
+    if(_world_dirty) return;
+    _world_dirty = true;
+    for(std::vector<Transform2D*>::iterator _iter = _children.begin(); _iter != _children.end(); ++_iter) {
+        (*_iter)->MarkWorldDirty();
+    }
+}
+
+void Transform2D::UpdateLocal() const {
+    if(_local_dirty == false) return;
     Matrix3x3 r(a2de::Matrix3x3::GetRotationMatrix(_rotation));
     Matrix3x3 s(a2de::Matrix3x3::GetScaleMatrix(_scale));
-
-    return p * t * r * s * t_inv;
+    _rotation_scale = r * s;
+    Matrix3x3 t(a2de::Matrix3x3::GetTranslationMatrix(_position));
+    _local = t * _rotation_scale;
+    _local_dirty = false;
 }
 
 
@@ -11,7 +11,11 @@ A2DE_BEGIN
 
 /**************************************************************************************************
  * <summary>A transform 2 d.</summary>
- * <remarks>Casey Ugone, 10/25/2014.</remarks>
+ * <remarks>Casey Ugone, 10/25/2014.
+ *          The local and world matrices are cached. Changing a transform marks it and every
+ *          transform below it dirty, and a dirty matrix is rebuilt the next time it is asked for,
+ *          so a query costs one product per dirty level instead of one per level. A transform
+ *          has one parent; SetParent, AddChild and RemoveChild keep both sides of the link.</remarks>
  **************************************************************************************************/
 class Transform2D {
 public:
@@ -23,7 +27,7 @@ public:
     Transform2D();
 
     /**************************************************************************************************
-     * <summary>Copy constructor.</summary>
+     * <summary>Constructor. Becomes a child of parent.</summary>
      * <remarks>Casey Ugone, 10/25/2014.</remarks>
      * <param name="parent">[in,out] If non-null, the parent.</param>
      **************************************************************************************************/
@@ -31,41 +35,43 @@ public:
 
     /**************************************************************************************************
      * <summary>Copy constructor.</summary>
-     * <remarks>Casey Ugone, 10/25/2014.</remarks>
+     * <remarks>Casey Ugone, 10/25/2014.
+     *          The copy becomes a child of other's parent. Children are not copied.</remarks>
      * <param name="other">The other.</param>
      **************************************************************************************************/
     Transform2D(const Transform2D& other);
 
     /**************************************************************************************************
      * <summary>Assignment operator.</summary>
-     * <remarks>Casey Ugone, 10/25/2014.</remarks>
+     * <remarks>Casey Ugone, 10/25/2014.
+     *          Takes rhs's position, rotation, scale and parent. This transform keeps its own children.</remarks>
      * <param name="rhs">The right hand side.</param>
      * <returns>A shallow copy of this object.</returns>
      **************************************************************************************************/
     Transform2D& operator=(const Transform2D& rhs);
 
     /**************************************************************************************************
-     * <summary>Destructor.</summary>
+     * <summary>Destructor. Leaves the parent and leaves the children without one.</summary>
      * <remarks>Casey Ugone, 10/25/2014.</remarks>
      **************************************************************************************************/
     virtual ~Transform2D();
 
     /**************************************************************************************************
-     * <summary>Sets the parent transform.</summary>
+     * <summary>Sets the parent transform, leaving the old one.</summary>
      * <remarks>Casey Ugone, 10/25/2014.</remarks>
      * <param name="parent">[in,out] If non-null, the parent.</param>
      **************************************************************************************************/
     void SetParent(Transform2D* parent);
 
     /**************************************************************************************************
-     * <summary>Adds a child transform.</summary>
+     * <summary>Adds a child transform, taking it from its old parent.</summary>
      * <remarks>Casey Ugone, 10/25/2014.</remarks>
      * <param name="child">[in,out] If non-null, the child.</param>
      **************************************************************************************************/
     void AddChild(Transform2D* child);
 
     /**************************************************************************************************
-     * <summary>Removes the child transform described by child.</summary>
+     * <summary>Removes the child transform described by child. It is left without a parent.</summary>
      * <remarks>Casey Ugone, 10/25/2014.</remarks>
      * <param name="child">[in,out] If non-null, the child.</param>
      **************************************************************************************************/
@@ -137,7 +143,9 @@ public:
 
     /**************************************************************************************************
      * <summary>Gets the position elements.</summary>
-     * <remarks>Casey Ugone, 10/25/2014.</remarks>
+     * <remarks>Casey Ugone, 10/25/2014.
+     *          Marks the transform dirty, as the position may be changed through the reference.
+     *          Read through the const overload where it will not be.</remarks>
      * <returns>The position.</returns>
      **************************************************************************************************/
     a2de::Vector2D& GetPosition();
@@ -179,14 +187,17 @@ public:
 
     /**************************************************************************************************
      * <summary>Gets the scale.</summary>
-     * <remarks>Casey Ugone, 10/25/2014.</remarks>
+     * <remarks>Casey Ugone, 10/25/2014.
+     *          Marks the transform dirty, as the scale may be changed through the reference.
+     *          Read through the const overload where it will not be.</remarks>
      * <returns>The scale.</returns>
      **************************************************************************************************/
     a2de::Vector2D& GetScale();
 
     /**************************************************************************************************
      * <summary>Builds a 3x3 Matrix from the Position, Scale, Rotation, parent and child transforms.</summary>
-     * <remarks>Casey Ugone, 10/25/2014.</remarks>
+     * <remarks>Casey Ugone, 10/25/2014.
+     *          The same matrix as GetWorldTransform.</remarks>
      * <returns>The local transform.</returns>
      **************************************************************************************************/
     a2de::Matrix3x3 GetLocalTransform() const;
@@ -205,10 +216,45 @@ public:
      * <returns>An a2de::Matrix3x3.</returns>
      **************************************************************************************************/
     a2de::Matrix3x3 RotateAround(const a2de::Vector2D& point);
+
+    /**************************************************************************************************
+     * <summary>Gets the matrix from this transform's space to the root's, rebuilding it if dirty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The parent's world transform times this transform's translation, rotation and scale.</returns>
+     **************************************************************************************************/
+    const a2de::Matrix3x3& GetWorldTransform() const;
+
+    /**************************************************************************************************
+     * <summary>Rebuilds every dirty matrix of this transform and those below it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Visits the hierarchy breadth-first, so each parent is rebuilt before its children
+     *          and each matrix takes one product. Call it on the root once a frame, after moving
+     *          things and before drawing them.</remarks>
+     **************************************************************************************************/
+    void UpdateHierarchy();
 protected:
 
 private:
 
+    /**************************************************************************************************
+     * <summary>Marks the local and world matrices dirty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void MarkLocalDirty();
+
+    /**************************************************************************************************
+     * <summary>Marks the world matrix of this transform and every one below it dirty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Stops at a transform that is already dirty; everything below a dirty transform is.</remarks>
+     **************************************************************************************************/
+    void MarkWorldDirty();
+
+    /**************************************************************************************************
+     * <summary>Rebuilds the local matrix if it is dirty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void UpdateLocal() const;
+
     /**************************************************************************************************
      * <summary>The position.</summary>
      **************************************************************************************************/
@@ -239,6 +285,31 @@ private:
      **************************************************************************************************/
     std::vector<Transform2D*> _children;
 
+    /**************************************************************************************************
+     * <summary>The rotation times the scale.</summary>
+     **************************************************************************************************/
+    mutable a2de::Matrix3x3 _rotation_scale;
+
+    /**************************************************************************************************
+     * <summary>The translation times the rotation times the scale.</summary>
+     **************************************************************************************************/
+    mutable a2de::Matrix3x3 _local;
+
+    /**************************************************************************************************
+     * <summary>The parent's world transform times the local transform.</summary>
+     **************************************************************************************************/
+    mutable a2de::Matrix3x3 _world;
+
+    /**************************************************************************************************
+     * <summary>true if the local matrices are out of date.</summary>
+     **************************************************************************************************/
+    mutable bool _local_dirty;
+
+    /**************************************************************************************************
+     * <summary>true if the world matrix is out of date.</summary>
+     **************************************************************************************************/
+    mutable bool _world_dirty;
+
 };
 
 A2DE_END
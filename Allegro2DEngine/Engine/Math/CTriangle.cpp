@@ -26,6 +26,7 @@
 #include "CMiscMath.h"
 
 #include "../a2de_exceptions.h"
+#include "../GFX/CPrimitiveBatch.h"
 
 A2DE_BEGIN
 
@@ -234,14 +235,7 @@ void Triangle::Draw(ALLEGRO_BITMAP* dest, const ALLEGRO_COLOR& color, bool fille
     double cx = a2de::Math::ToScreenScale(_pointC.GetX());
     double cy = a2de::Math::ToScreenScale(_pointC.GetY());
 
-
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
-    
-    filled ? al_draw_filled_triangle(ax, ay, bx, by, cx, cy, color) : al_draw_triangle(ax, ay, bx, by, cx, cy, color, 0.0);
-    
-    al_set_target_bitmap(old_target);
-
+    PrimitiveBatch::DrawTriangle(dest, ax, ay, bx, by, cx, cy, color, filled);
 }
 
 void Triangle::CalculateArea() {
@@ -11,6 +11,9 @@
 #include "../a2de_vals.h"
 #include "CMiscMath.h"
 
+#include <cassert>
+#include <cmath>
+
 A2DE_BEGIN
 
 class Vector3D;
@@ -68,12 +71,6 @@ public:
      **************************************************************************************************/
     double GetX() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the x coordinate.</summary>
-     * <remarks>Casey Ugone, 8/19/2011.</remarks>
-     * <returns>The x coordinate.</returns>
-     **************************************************************************************************/
-    double GetX();
 
     /**************************************************************************************************
      * <summary>Get y coordinate.</summary>
@@ -82,12 +79,6 @@ public:
      **************************************************************************************************/
     double GetY() const;
 
-    /**************************************************************************************************
-     * <summary>Get y coordinate.</summary>
-     * <remarks>Casey Ugone, 8/19/2011.</remarks>
-     * <returns>The y coordinate.</returns>
-     **************************************************************************************************/
-    double GetY();
 
     /**************************************************************************************************
      * <summary>Gets the length of the vector.</summary>
@@ -96,12 +87,6 @@ public:
      **************************************************************************************************/
     double GetLength() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the length of the vector.</summary>
-     * <remarks>Casey Ugone, 8/19/2011.</remarks>
-     * <returns>The length.</returns>
-     **************************************************************************************************/
-    double GetLength();
 
     /**************************************************************************************************
      * <summary>Gets the length squared.</summary>
@@ -110,12 +95,6 @@ public:
      **************************************************************************************************/
     double GetLengthSquared() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the length squared.</summary>
-     * <remarks>Casey Ugone, 8/9/2012.</remarks>
-     * <returns>The length squared.</returns>
-     **************************************************************************************************/
-    double GetLengthSquared();
 
 
     /**************************************************************************************************
@@ -156,12 +135,6 @@ public:
      **************************************************************************************************/
     Vector2D GetLeftNormal() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the positive normal.</summary>
-     * <remarks>Casey Ugone, 6/28/2013.</remarks>
-     * <returns>The positive normal.</returns>
-     **************************************************************************************************/
-    Vector2D GetLeftNormal();
 
     /**************************************************************************************************
      * <summary>Gets the negative normal.</summary>
@@ -170,12 +143,6 @@ public:
      **************************************************************************************************/
     Vector2D GetRightNormal() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the negative normal.</summary>
-     * <remarks>Casey Ugone, 3/26/2014.</remarks>
-     * <returns>The negative normal.</returns>
-     **************************************************************************************************/
-    Vector2D GetRightNormal();
 
     /**************************************************************************************************
      * <summary>Gets the projection of this vector onto the argument vector.</summary>
@@ -215,12 +182,6 @@ public:
      **************************************************************************************************/
     Vector2D GetNormal() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the positive normal.</summary>
-     * <remarks>Casey Ugone, 6/28/2013.</remarks>
-     * <returns>The positive normal.</returns>
-     **************************************************************************************************/
-    Vector2D GetNormal();
 
     /**************************************************************************************************
      * <summary>Gets the angle of the vector.</summary>
@@ -229,12 +190,6 @@ public:
      **************************************************************************************************/
     double GetAngle() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the angle.</summary>
-     * <remarks>Casey Ugone, 8/10/2012.</remarks>
-     * <returns>The angle.</returns>
-     **************************************************************************************************/
-    double GetAngle();
 
     /**************************************************************************************************
      * <summary>Gets an angle of a vector.</summary>
@@ -286,12 +241,6 @@ public:
      **************************************************************************************************/
     Vector3D GetHomogeneous() const;
 
-    /**************************************************************************************************
-     * <summary>Gets the homogeneous.</summary>
-     * <remarks>Casey Ugone, 9/19/2014.</remarks>
-     * <returns>The vector in 3D homogeneous coordinates.</returns>
-     **************************************************************************************************/
-    Vector3D GetHomogeneous();
 
     /**************************************************************************************************
      * <summary>Assignment operator.</summary>
@@ -301,13 +250,6 @@ public:
      **************************************************************************************************/
     Vector2D& operator=(const Vector2D& rhs);
 
-    /**************************************************************************************************
-     * <summary>Equality operator.</summary>
-     * <remarks>Casey Ugone, 8/19/2011.</remarks>
-     * <param name="rhs">The right hand side.</param>
-     * <returns>true if the parameters are considered equivalent.</returns>
-     **************************************************************************************************/
-    bool operator==(const Vector2D& rhs);
 
     /**************************************************************************************************
      * <summary>Equality operator.</summary>
@@ -317,13 +259,6 @@ public:
      **************************************************************************************************/
     bool operator==(const Vector2D& rhs) const;
 
-    /**************************************************************************************************
-     * <summary>Inequality operator</summary>
-     * <remarks>Casey Ugone, 7/9/2012.</remarks>
-     * <param name="rhs">The right hand side.</param>
-     * <returns>true if the parameters are considered not equivalent.</returns>
-     **************************************************************************************************/
-    bool operator!=(const Vector2D& rhs);
 
     /**************************************************************************************************
      * <summary>Inequality operator</summary>
@@ -373,13 +308,6 @@ public:
      **************************************************************************************************/
     Vector2D operator+(const Vector2D& rhs) const;
 
-    /**************************************************************************************************
-     * <summary>Addition operator.</summary>
-     * <remarks>Casey Ugone, 8/10/2012.</remarks>
-     * <param name="rhs">The right hand side.</param>
-     * <returns>The result of the operation.</returns>
-     **************************************************************************************************/
-    Vector2D operator+(const Vector2D& rhs);
 
     /**************************************************************************************************
      * <summary>Negation operator.</summary>
@@ -389,13 +317,6 @@ public:
      **************************************************************************************************/
     Vector2D operator-(const Vector2D& rhs) const;
 
-    /**************************************************************************************************
-     * <summary>Negation operator.</summary>
-     * <remarks>Casey Ugone, 8/10/2012.</remarks>
-     * <param name="rhs">The right hand side.</param>
-     * <returns>The result of the operation.</returns>
-     **************************************************************************************************/
-    Vector2D operator-(const Vector2D& rhs);
 
     /**************************************************************************************************
      * <summary>Negation operator.</summary>
@@ -404,12 +325,6 @@ public:
      **************************************************************************************************/
     Vector2D operator-() const;
 
-    /**************************************************************************************************
-     * <summary>Negation operator.</summary>
-     * <remarks>Casey Ugone, 9/19/2014.</remarks>
-     * <returns>The result of the operation.</returns>
-     **************************************************************************************************/
-    Vector2D operator-();
 
     /**************************************************************************************************
      * <summary>Multiplication operator.</summary>
@@ -419,13 +334,6 @@ public:
      **************************************************************************************************/
     Vector2D operator*(const Vector2D& rhs) const;
 
-    /**************************************************************************************************
-     * <summary>Multiplication operator.</summary>
-     * <remarks>Casey Ugone, 8/10/2012.</remarks>
-     * <param name="rhs">The right hand side.</param>
-     * <returns>The result of the operation.</returns>
-     **************************************************************************************************/
-    Vector2D operator*(const Vector2D& rhs);
 
     /**************************************************************************************************
      * <summary>Division operator.</summary>
@@ -435,13 +343,6 @@ public:
      **************************************************************************************************/
     Vector2D operator/(const Vector2D& rhs) const;
 
-    /**************************************************************************************************
-     * <summary>Division operator.</summary>
-     * <remarks>Casey Ugone, 8/10/2012.</remarks>
-     * <param name="rhs">The right hand side.</param>
-     * <returns>The result of the operation.</returns>
-     **************************************************************************************************/
-    Vector2D operator/(const Vector2D& rhs);
 
     /**************************************************************************************************
      * <summary>Addition assignment operator.</summary>
@@ -582,12 +483,189 @@ protected:
     double _x;
     /// <summary> The terminal point y-coordinate.</summary>
     double _y;
-    /// <summary> The angle of the vector in radians. </summary>
-    double _angle;
 
 private:
 };
 
+//Small and called from every physics loop, so defined here where they can be inlined.
+//The components are the only members, so arrays of Vector2D can be read two doubles at a time.
+
+inline Vector2D::Vector2D() : _x(0.0), _y(0.0) { /* DO NOTHING */ }
+inline Vector2D::Vector2D(double x, double y) : _x(x), _y(y) { /* DO NOTHING */ }
+inline Vector2D::Vector2D(const Vector2D& vector) : _x(vector._x), _y(vector._y) { /* DO NOTHING */ }
+inline Vector2D::~Vector2D() { /* DO NOTHING */ }
+
+inline double Vector2D::GetX() const {
+    return _x;
+}
+
+inline double Vector2D::GetY() const {
+    return _y;
+}
+
+inline double Vector2D::GetLength() const {
+    return std::sqrt(GetLengthSquared());
+}
+
+inline double Vector2D::GetLengthSquared() const {
+    if(Math::IsEqual(_x, 0.0) && Math::IsEqual(_y, 0.0)) return 0.0;
+    return (_x * _x + _y * _y);
+}
+
+inline double Vector2D::DotProduct(const Vector2D& rhs) const {
+    return DotProduct(*this, rhs);
+}
+
+inline double Vector2D::DotProduct(const Vector2D& a, const Vector2D& b) {
+    return a._x * b._x + a._y * b._y;
+}
+
+inline Vector2D Vector2D::GetNormal() const {
+    return GetLeftNormal();
+}
+
+inline Vector2D Vector2D::GetLeftNormal() const {
+    return Vector2D(-_y, _x);
+}
+
+inline Vector2D Vector2D::GetRightNormal() const {
+    return Vector2D(_y, -_x);
+}
+
+inline Vector2D& Vector2D::operator=(const Vector2D& rhs) {
+    _x = rhs._x;
+    _y = rhs._y;
+    return *this;
+}
+
+inline bool Vector2D::operator==(const Vector2D& rhs) const {
+    return (Math::IsEqual(_x, rhs._x) && Math::IsEqual(_y, rhs._y));
+}
+
+inline bool Vector2D::operator!=(const Vector2D& rhs) const {
+    return !(*this == rhs);
+}
+
+inline Vector2D& Vector2D::operator+=(double scalar) {
+    SetTerminal(_x + scalar, _y + scalar);
+    return *this;
+}
+
+inline Vector2D& Vector2D::operator-=(double scalar) {
+    SetTerminal(_x - scalar, _y - scalar);
+    return *this;
+}
+
+inline Vector2D& Vector2D::operator*=(double scalar) {
+    SetTerminal(_x * scalar, _y * scalar);
+    return *this;
+}
+
+inline Vector2D& Vector2D::operator/=(double scalar) {
+    assert(Math::IsEqual(scalar, 0.0) == false);
+    SetTerminal(_x / scalar, _y / scalar);
+    return *this;
+}
+
+inline Vector2D Vector2D::operator+(const Vector2D& rhs) const {
+    return Vector2D(_x + rhs._x, _y + rhs._y);
+}
+
+inline Vector2D Vector2D::operator-(const Vector2D& rhs) const {
+    return Vector2D(_x - rhs._x, _y - rhs._y);
+}
+
+inline Vector2D Vector2D::operator-() const {
+    return Vector2D(-_x, -_y);
+}
+
+inline Vector2D Vector2D::operator*(const Vector2D& rhs) const {
+    return Vector2D(_x * rhs._x, _y * rhs._y);
+}
+
+inline Vector2D Vector2D::operator/(const Vector2D& rhs) const {
+    assert(Math::IsEqual(rhs._x, 0.0) == false && Math::IsEqual(rhs._y, 0.0) == false);
+    return Vector2D(_x / rhs._x, _y / rhs._y);
+}
+
+inline Vector2D& Vector2D::operator+=(const Vector2D& rhs) {
+    SetTerminal(_x + rhs._x, _y + rhs._y);
+    return *this;
+}
+
+inline Vector2D& Vector2D::operator-=(const Vector2D& rhs) {
+    SetTerminal(_x - rhs._x, _y - rhs._y);
+    return *this;
+}
+
+inline Vector2D& Vector2D::operator*=(const Vector2D& rhs) {
+    SetTerminal(_x * rhs._x, _y * rhs._y);
+    return *this;
+}
+
+inline Vector2D& Vector2D::operator/=(const Vector2D& rhs) {
+    assert(Math::IsEqual(rhs._x, 0.0) == false && Math::IsEqual(rhs._y, 0.0) == false);
+    SetTerminal(_x / rhs._x, _y / rhs._y);
+    return *this;
+}
+
+inline Vector2D operator+(const Vector2D& v_lhs, double scalar_rhs) {
+    return Vector2D(v_lhs._x + scalar_rhs, v_lhs._y + scalar_rhs);
+}
+
+inline Vector2D operator+(double scalar_lhs, const Vector2D& v_rhs) {
+    return v_rhs + scalar_lhs;
+}
+
+inline Vector2D operator-(const Vector2D& v_lhs, double scalar_rhs) {
+    return Vector2D(v_lhs._x - scalar_rhs, v_lhs._y - scalar_rhs);
+}
+
+inline Vector2D operator-(double scalar_lhs, const Vector2D& v_rhs) {
+    return v_rhs - scalar_lhs;
+}
+
+inline Vector2D operator*(const Vector2D& v_lhs, double scalar_rhs) {
+    return Vector2D(v_lhs._x * scalar_rhs, v_lhs._y * scalar_rhs);
+}
+
+inline Vector2D operator*(double scalar_lhs, const Vector2D& v_rhs) {
+    return v_rhs * scalar_lhs;
+}
+
+inline Vector2D operator/(const Vector2D& v_lhs, double scalar_rhs) {
+    assert(Math::IsEqual(scalar_rhs, 0.0) == false);
+    return Vector2D(v_lhs._x / scalar_rhs, v_lhs._y / scalar_rhs);
+}
+
+inline Vector2D operator/(double scalar_lhs, const Vector2D& v_rhs) {
+    return v_rhs / scalar_lhs;
+}
+
+inline void Vector2D::SetX(double x) {
+    _x = x;
+}
+
+inline void Vector2D::SetY(double y) {
+    _y = y;
+}
+
+inline void Vector2D::SetTerminal(double x, double y) {
+    _x = x;
+    _y = y;
+}
+
+namespace Math {
+
+inline a2de::Vector2D ToWorldScale(const a2de::Vector2D& pixels) {
+    return pixels * WORLD_SCALE;
+}
+
+inline a2de::Vector2D ToScreenScale(const a2de::Vector2D& meters) {
+    return meters / WORLD_SCALE;
+}
+
+} //End namespace Math
 
 A2DE_END
 
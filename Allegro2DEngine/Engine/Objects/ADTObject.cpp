@@ -25,5 +25,8 @@ void Object::SetBody(const a2de::RigidBodyDef& /*body*/) { /* DO NOTHING */ }
 const a2de::RigidBody* Object::GetBody() const { return nullptr; }
 a2de::RigidBody* Object::GetBody() { return const_cast<a2de::RigidBody*>(static_cast<const Object&>(*this).GetBody()); }
 
+ALLEGRO_BITMAP* Object::GetTexture() const { return nullptr; }
+ALLEGRO_BITMAP* Object::GetTexture() { return static_cast<const Object&>(*this).GetTexture(); }
+
 
 A2DE_END
\ No newline at end of file
@@ -86,6 +86,21 @@ public:
      **************************************************************************************************/
     virtual void Draw(ALLEGRO_BITMAP* dest);
 
+    /**************************************************************************************************
+     * <summary>Gets the texture the object draws with.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Used by the render queue to draw objects that share a texture together.</remarks>
+     * <returns>null if the object does not draw with a single texture, else the texture.</returns>
+     **************************************************************************************************/
+    virtual ALLEGRO_BITMAP* GetTexture() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the texture the object draws with.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>null if the object does not draw with a single texture, else the texture.</returns>
+     **************************************************************************************************/
+    virtual ALLEGRO_BITMAP* GetTexture();
+
 
 protected:
 private:
@@ -7,6 +7,8 @@
  **************************************************************************************************/
 #include "AABB.h"
 
+#include "../GFX/CPrimitiveBatch.h"
+
 A2DE_BEGIN
 
 AABB::AABB() : _transform_instance(), _half_extents(), _color() { /* DO NOTHING */ }
@@ -77,12 +79,7 @@ void AABB::Draw(ALLEGRO_BITMAP* dest) {
     double lrx = x + xhe;
     double lry = y + yhe;
 
-    ALLEGRO_BITMAP* old_target = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
-
-    al_draw_rectangle(Math::ToScreenScale(ulx), Math::ToScreenScale(uly), Math::ToScreenScale(lrx), Math::ToScreenScale(lry), _color, 0.0);
-
-    al_set_target_bitmap(old_target);
+    PrimitiveBatch::DrawRectangle(dest, Math::ToScreenScale(ulx), Math::ToScreenScale(uly), Math::ToScreenScale(lrx), Math::ToScreenScale(lry), _color, false);
 }
 
 Line AABB::GetLeft() const {
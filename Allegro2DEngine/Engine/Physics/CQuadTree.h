@@ -153,6 +153,13 @@ public:
      **************************************************************************************************/
     unsigned long Divisions();
 
+    /**************************************************************************************************
+     * <summary>Gets the number of levels on the longest path from this node to a leaf.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>Zero for a leaf.</returns>
+     **************************************************************************************************/
+    unsigned long Depth();
+
     /**************************************************************************************************
      * <summary>Gets the number of elements in tree.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -168,6 +175,26 @@ public:
      **************************************************************************************************/
     std::vector<T> Query(const a2de::Shape& area);
 
+    /**************************************************************************************************
+     * <summary>Queries a given area, appending to an existing container.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="area">             The area.</param>
+     * <param name="selected_elements">[in,out] The selected elements.</param>
+     **************************************************************************************************/
+    void Query(const a2de::Shape& area, std::vector<T>& selected_elements);
+
+    /**************************************************************************************************
+     * <summary>Queries every leaf crossed by a line segment.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Each node's bounds are grown by the margin before testing, so elements that stand in
+     *          for larger objects are found when the segment only touches the object.</remarks>
+     * <param name="start">            The start of the segment.</param>
+     * <param name="end">              The end of the segment.</param>
+     * <param name="margin">           The half extents to grow each node by.</param>
+     * <param name="selected_elements">[in,out] The selected elements.</param>
+     **************************************************************************************************/
+    void Query(const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& margin, std::vector<T>& selected_elements);
+
     /**************************************************************************************************
      * <summary>Gets the nodes by element.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -309,6 +336,17 @@ private:
      **************************************************************************************************/
     void QueryNode(QuadTree<T>* node, const a2de::Shape& area, std::vector<T>& selected_elements);
 
+    /**************************************************************************************************
+     * <summary>Queries a node with a line segment.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="node">             [in,out] If non-null, the node.</param>
+     * <param name="start">            The start of the segment.</param>
+     * <param name="end">              The end of the segment.</param>
+     * <param name="margin">           The half extents to grow each node by.</param>
+     * <param name="selected_elements">[in,out] The selected elements.</param>
+     **************************************************************************************************/
+    void QueryNode(QuadTree<T>* node, const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& margin, std::vector<T>& selected_elements);
+
     /**************************************************************************************************
      * <summary>Removes the element described by elem.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -558,6 +596,37 @@ std::vector<T> QuadTree<T>::Query(const a2de::Shape& area) {
     return selected_elements;
 }
 
+template<typename T>
+void QuadTree<T>::Query(const a2de::Shape& area, std::vector<T>& selected_elements) {
+    QueryNode(this, area, selected_elements);
+}
+
+template<typename T>
+void QuadTree<T>::Query(const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& margin, std::vector<T>& selected_elements) {
+    QueryNode(this, start, end, margin, selected_elements);
+}
+
+template<typename T>
+void QuadTree<T>::QueryNode(QuadTree<T>* node, const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& margin, std::vector<T>& selected_elements) {
+
+    if(node == nullptr) return;
+
+    a2de::Vector2D half_extents = node->_bounds.GetHalfExtents() + margin;
+    a2de::Vector2D box_min = node->_bounds.GetPosition() - half_extents;
+    a2de::Vector2D box_max = node->_bounds.GetPosition() + half_extents;
+    double fraction = 0.0;
+    a2de::Vector2D normal;
+    if(a2de::Math::IntersectSegmentBox(start, end, box_min, box_max, fraction, normal) == false) return;
+
+    if(IsLeaf(node)) {
+        selected_elements.insert(selected_elements.end(), node->_elements.begin(), node->_elements.end());
+        return;
+    }
+    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+        QueryNode(node->_children[i], start, end, margin, selected_elements);
+    }
+}
+
 template<typename T>
 unsigned long QuadTree<T>::GetMaxElementsPerNode() {
     return MAX_ELEMENTS;
@@ -603,6 +672,17 @@ unsigned long QuadTree<T>::Divisions() {
     return num_divisions;
 }
 
+template<typename T>
+unsigned long QuadTree<T>::Depth() {
+    if(IsLeaf(this)) return 0;
+    unsigned long deepest_child = 0;
+    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+        unsigned long child_depth = _children[i]->Depth();
+        if(child_depth > deepest_child) deepest_child = child_depth;
+    }
+    return deepest_child + 1;
+}
+
 template<typename T>
 unsigned long QuadTree<T>::Height() {
 
@@ -648,7 +728,10 @@ void QuadTree<T>::DrawBottomToTop(ALLEGRO_BITMAP* dest) {
 template<typename T>
 void QuadTree<T>::Draw(ALLEGRO_BITMAP* dest, bool top_to_bottom) {
     if(dest == nullptr) return;
+    //Every node's bounds go out in one draw unless the caller already has a batch going.
+    bool batched = PrimitiveBatch::BeginBatch(dest);
     top_to_bottom ? DrawTopToBottom(dest) : DrawBottomToTop(dest);
+    if(batched) PrimitiveBatch::EndBatch();
 }
 
 template<typename T>
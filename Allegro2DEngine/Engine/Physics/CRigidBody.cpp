@@ -19,19 +19,19 @@ A2DE_BEGIN
 double RigidBody::MASS_EQUIVALENCY_TOLERANCE = 0.0001;
 
 RigidBody::RigidBody(double mass, double gravModX, double gravModY, double restitution, double static_friction, double kinetic_friction)
- : _curState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), restitution, static_friction, kinetic_friction) { }
+ : _curState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), restitution, static_friction, kinetic_friction), _collisionMask(nullptr) { }
 
 RigidBody::RigidBody(double mass, const Vector2D& gravMod, const PhysicsMaterial& material)
- : _curState(mass, gravMod, Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()) { }
+ : _curState(mass, gravMod, Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()), _collisionMask(nullptr) { }
 
 RigidBody::RigidBody(double mass, double gravModX, double gravModY, const PhysicsMaterial& material)
- : _curState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()) { }
+ : _curState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()), _collisionMask(nullptr) { }
 
 RigidBody::RigidBody(const State& state) 
- : _curState(state) { }
+ : _curState(state), _collisionMask(nullptr) { }
 
 RigidBody::RigidBody(const RigidBody& other)
- : _curState(other._curState) { }
+ : _curState(other._curState), _collisionMask(other._collisionMask) { }
 
 RigidBody::RigidBody(const RigidBodyDef& body_definition)
 : _curState(body_definition.mass,
@@ -40,7 +40,8 @@ RigidBody::RigidBody(const RigidBodyDef& body_definition)
   Vector2D(body_definition.velocity_x, body_definition.velocity_y),
   body_definition.restitution,
   body_definition.static_friction,
-  body_definition.kinetic_friction) {
+  body_definition.kinetic_friction),
+  _collisionMask(nullptr) {
     /* DO NOTHING */
 }
 
@@ -51,6 +52,7 @@ RigidBody::~RigidBody() {
 RigidBody& RigidBody::operator=(const RigidBody& rhs) {
     if(this == &rhs) return *this;
     this->_curState = rhs._curState;
+    this->_collisionMask = rhs._collisionMask;
     return *this;
 }
 
@@ -320,6 +322,14 @@ void RigidBody::SetCollisionShape(Shape* shape) {
     _curState._density = _curState.CalculateDensity();
 }
 
+void RigidBody::SetCollisionMask(const CollisionMask* mask) {
+    _collisionMask = mask;
+}
+
+const CollisionMask* RigidBody::GetCollisionMask() const {
+    return _collisionMask;
+}
+
 void RigidBody::SetDamper(double value) {
     _curState.SetDamper(value);
 }
@@ -349,4 +359,12 @@ bool RigidBody::IsActive() {
 }
 
 
-A2DE_END
\ No newline at end of file
+void RigidBody::SaveSnapshot(BodySnapshot& body, std::vector<ForceSnapshot>& forces, std::vector<ForceSnapshot>& impulses) const {
+    _curState.SaveSnapshot(body, forces, impulses);
+}
+
+void RigidBody::RestoreSnapshot(const BodySnapshot& body, const std::vector<ForceSnapshot>& forces, const std::vector<ForceSnapshot>& impulses) {
+    _curState.RestoreSnapshot(body, forces, impulses);
+}
+
+A2DE_END
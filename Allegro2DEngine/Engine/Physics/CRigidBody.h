@@ -22,6 +22,7 @@ A2DE_BEGIN
 
 class StopWatch;
 class Rectangle;
+class CollisionMask;
 
 struct RigidBodyDef {
     RigidBodyDef() : mass(0.0),
@@ -674,6 +675,22 @@ public:
      **************************************************************************************************/
     Shape* GetCollisionShape();
 
+    /**************************************************************************************************
+     * <summary>Sets the pixel collision mask tested after the bounding boxes overlap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The mask is centered on the bounding rectangle and not rotated with it. It is not
+     *          owned; use one from BitmapCache and set it again when the sprite's frame changes.</remarks>
+     * <param name="mask">The mask, or null to collide on the bounding rectangle alone.</param>
+     **************************************************************************************************/
+    void SetCollisionMask(const CollisionMask* mask);
+
+    /**************************************************************************************************
+     * <summary>Gets the pixel collision mask.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>null if the body has no mask, else the mask.</returns>
+     **************************************************************************************************/
+    const CollisionMask* GetCollisionMask() const;
+
     /**************************************************************************************************
      * <summary>Sets a damper.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -721,11 +738,31 @@ public:
      **************************************************************************************************/
     bool IsActive();
 
+    /**************************************************************************************************
+     * <summary>Copies the simulated values into a flat snapshot record.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="body">[out] The body record.</param>
+     * <param name="forces">[in,out] The force array to append to.</param>
+     * <param name="impulses">[in,out] The impulse array to append to.</param>
+     **************************************************************************************************/
+    void SaveSnapshot(BodySnapshot& body, std::vector<ForceSnapshot>& forces, std::vector<ForceSnapshot>& impulses) const;
+
+    /**************************************************************************************************
+     * <summary>Restores the simulated values from a flat snapshot record.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="body">The body record.</param>
+     * <param name="forces">The force array the record indexes into.</param>
+     * <param name="impulses">The impulse array the record indexes into.</param>
+     **************************************************************************************************/
+    void RestoreSnapshot(const BodySnapshot& body, const std::vector<ForceSnapshot>& forces, const std::vector<ForceSnapshot>& impulses);
+
 protected:
 
 private:
     /// <summary> The current State </summary>
     State _curState;
+    /// <summary> The pixel collision mask, not owned. </summary>
+    const CollisionMask* _collisionMask;
 
 };
 
@@ -31,6 +31,7 @@
 #include "IBoundingBox.h"
 #include "AABB.h"
 #include "OBB.h"
+#include "CWorldSnapshot.h"
 
 A2DE_BEGIN
 
@@ -44,10 +45,8 @@ State::State(double mass, const Vector2D& gravMod, const Vector2D& position, con
 }
 
 State::State(const State& other)
-     : _mass(other._mass), _gravMod(other._gravMod), _position(other._position), _velocity(other._velocity), _acceleration(other._acceleration), _forces(other._forces), _impulses(other._impulses), _active(other._active), _mat(other._mat), _bounding_rectangle(nullptr), _collision_shape(nullptr), _density(), _damper(DEFAULT_DAMPER_VALUE) {
-    SetBoundingRectangle(other._bounding_rectangle);
-    SetCollisionShape(other._collision_shape);
-    _density = CalculateDensity();
+     : _mass(other._mass), _gravMod(other._gravMod), _position(other._position), _velocity(other._velocity), _acceleration(other._acceleration), _forces(other._forces), _impulses(other._impulses), _active(other._active), _mat(other._mat), _bounding_rectangle(CloneBoundingRectangle(other._bounding_rectangle)), _collision_shape(Shape::Clone(other._collision_shape)), _density(other._density), _damper(other._damper) {
+    /* DO NOTHING */
 }
 
 State& State::operator=(const State& rhs) {
@@ -62,9 +61,9 @@ State& State::operator=(const State& rhs) {
     this->_impulses = rhs._impulses;
     this->_active = rhs._active;
     this->_mat = rhs._mat;
-    SetBoundingRectangle(rhs._bounding_rectangle);
-    SetCollisionShape(rhs._collision_shape);
-    this->_density = CalculateDensity();
+    SetBoundingRectangle(CloneBoundingRectangle(rhs._bounding_rectangle));
+    SetCollisionShape(Shape::Clone(rhs._collision_shape));
+    this->_density = rhs._density;
     this->_damper = rhs._damper;
     return *this;
 }
@@ -203,10 +202,10 @@ void State::Update(double deltaTime) {
         SetPosition(((0.5 * a) * deltaTime * deltaTime) + (v * deltaTime) + p);
     }
     
-    _forces.remove_if([&deltaTime](a2de::State::ForceContainer::value_type& current_force)->bool {
+    _forces.erase(std::remove_if(_forces.begin(), _forces.end(), [&deltaTime](a2de::State::ForceContainer::value_type& current_force)->bool {
         current_force.second -= deltaTime;
         return (current_force.second < 0.0);
-    });
+    }), _forces.end());
 
 }
 
@@ -318,6 +317,68 @@ double State::CalculateDensity() {
     return (_mass / area);
 }
 
+void State::SaveSnapshot(BodySnapshot& body, std::vector<ForceSnapshot>& forces, std::vector<ForceSnapshot>& impulses) const {
+    body.mass = _mass;
+    body.gravity_mod_x = _gravMod.GetX();
+    body.gravity_mod_y = _gravMod.GetY();
+    body.position_x = _position.GetX();
+    body.position_y = _position.GetY();
+    body.velocity_x = _velocity.GetX();
+    body.velocity_y = _velocity.GetY();
+    body.acceleration_x = _acceleration.GetX();
+    body.acceleration_y = _acceleration.GetY();
+    body.damper = _damper;
+    body.density = _density;
+    body.active = _active;
+
+    body.first_force = static_cast<unsigned long>(forces.size());
+    body.force_count = static_cast<unsigned long>(_forces.size());
+    for(ForceContainer::const_iterator _iter = _forces.begin(); _iter != _forces.end(); ++_iter) {
+        ForceSnapshot force = { _iter->first.GetX(), _iter->first.GetY(), _iter->second };
+        forces.push_back(force);
+    }
+
+    body.first_impulse = static_cast<unsigned long>(impulses.size());
+    body.impulse_count = static_cast<unsigned long>(_impulses.size());
+    for(ImpulseContainer::const_iterator _iter = _impulses.begin(); _iter != _impulses.end(); ++_iter) {
+        ForceSnapshot impulse = { _iter->GetX(), _iter->GetY(), 0.0 };
+        impulses.push_back(impulse);
+    }
+}
+
+void State::RestoreSnapshot(const BodySnapshot& body, const std::vector<ForceSnapshot>& forces, const std::vector<ForceSnapshot>& impulses) {
+    _mass = body.mass;
+    _gravMod = Vector2D(body.gravity_mod_x, body.gravity_mod_y);
+    _velocity = Vector2D(body.velocity_x, body.velocity_y);
+    _acceleration = Vector2D(body.acceleration_x, body.acceleration_y);
+    _damper = body.damper;
+    _density = body.density;
+    _active = body.active;
+    SetPosition(body.position_x, body.position_y);
+
+    //clear() keeps capacity so repeated rollbacks do not allocate.
+    _forces.clear();
+    for(unsigned long i = 0; i < body.force_count; ++i) {
+        const ForceSnapshot& force = forces[body.first_force + i];
+        _forces.push_back(std::make_pair(Vector2D(force.x, force.y), force.duration));
+    }
+
+    _impulses.clear();
+    for(unsigned long i = 0; i < body.impulse_count; ++i) {
+        const ForceSnapshot& impulse = impulses[body.first_impulse + i];
+        _impulses.push_back(Vector2D(impulse.x, impulse.y));
+    }
+}
+
+IBoundingBox* State::CloneBoundingRectangle(const IBoundingBox* rectangle) {
+    if(rectangle == nullptr) return nullptr;
+    const OBB* obb = dynamic_cast<const OBB*>(rectangle);
+    if(obb) return new OBB(*obb);
+    const AABB* aabb = dynamic_cast<const AABB*>(rectangle);
+    if(aabb) return new AABB(*aabb);
+    return nullptr;
+}
+
 PhysicsMaterial::PhysicsMaterial(double restitution, double static_friction, double kinetic_friction) : _restitution(restitution), _static_friction(static_friction), _kinetic_friction(kinetic_friction) { }
 
 PhysicsMaterial::PhysicsMaterial(const PhysicsMaterial& other) : _restitution(other._restitution), _static_friction(other._static_friction), _kinetic_friction(other._kinetic_friction) { }
@@ -11,13 +11,15 @@
 #include "../a2de_vals.h"
 #include "../Math/CVector2D.h"
 #include "IUpdatable.h"
-#include <list>
+#include <vector>
 #include "../Math/CRectangle.h"
 
 A2DE_BEGIN
 
 class Shape;
 class IBoundingBox;
+struct BodySnapshot;
+struct ForceSnapshot;
 class AABB;
 class OBB;
 
@@ -123,8 +125,8 @@ private:
 
 class State : public IUpdatable {
     
-    typedef std::list<std::pair<Vector2D, double> > ForceContainer;
-    typedef std::list<Vector2D> ImpulseContainer;
+    typedef std::vector<std::pair<Vector2D, double> > ForceContainer;
+    typedef std::vector<Vector2D> ImpulseContainer;
 
     /**************************************************************************************************
      * <summary>Constructor.</summary>
@@ -711,10 +713,40 @@ class State : public IUpdatable {
      * <summary>Assignment operator.</summary>
      * <remarks>Casey Ugone, 9/3/2012.</remarks>
      * <param name="rhs">The right hand side.</param>
-     * <returns>A shallow copy of this object.</returns>
+     * <returns>A deep copy of this object.</returns>
      **************************************************************************************************/
     State& operator=(const State& rhs);
 
+    /**************************************************************************************************
+     * <summary>Copies the simulated values into a flat snapshot record.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Pending forces and impulses are appended to the supplied arrays and referenced from
+     *          the record by index.</remarks>
+     * <param name="body">[out] The body record.</param>
+     * <param name="forces">[in,out] The force array to append to.</param>
+     * <param name="impulses">[in,out] The impulse array to append to.</param>
+     **************************************************************************************************/
+    void SaveSnapshot(BodySnapshot& body, std::vector<ForceSnapshot>& forces, std::vector<ForceSnapshot>& impulses) const;
+
+    /**************************************************************************************************
+     * <summary>Restores the simulated values from a flat snapshot record.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The bounding rectangle and collision shape are moved to the restored position. The
+     *          material, shape and bounding rectangle are not part of the snapshot.</remarks>
+     * <param name="body">The body record.</param>
+     * <param name="forces">The force array the record indexes into.</param>
+     * <param name="impulses">The impulse array the record indexes into.</param>
+     **************************************************************************************************/
+    void RestoreSnapshot(const BodySnapshot& body, const std::vector<ForceSnapshot>& forces, const std::vector<ForceSnapshot>& impulses);
+
+    /**************************************************************************************************
+     * <summary>Makes a deep copy of a bounding rectangle.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rectangle">The rectangle to copy.</param>
+     * <returns>null if rectangle is null or of an unknown type, else a new copy.</returns>
+     **************************************************************************************************/
+    static IBoundingBox* CloneBoundingRectangle(const IBoundingBox* rectangle);
+
     /// <summary>A body's Mass.</summary>
     double _mass;
     /// <summary>A body's gravity modifier in the X-Y direction a body.</summary>
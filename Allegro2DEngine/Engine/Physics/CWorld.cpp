@@ -15,6 +15,7 @@
 #include "CRigidBody.h"
 
 #include <utility>
+#include <cmath>
 #include <algorithm>
 #include <iterator>
 #include <sstream>
@@ -33,9 +34,20 @@
 
 #include <set>
 
+#ifdef A2DE_PROFILE_PHYSICS
+#include "../Time/CHighResolutionClock.h"
+#define A2DE_PROFILE_START(timer) unsigned long long timer = a2de::HighResolutionClock::GetTicks()
+#define A2DE_PROFILE_STOP(timer, field) _stats.field += a2de::HighResolutionClock::ToSeconds(a2de::HighResolutionClock::GetTicks() - timer)
+#define A2DE_PROFILE_COUNT(statement) statement
+#else
+#define A2DE_PROFILE_START(timer)
+#define A2DE_PROFILE_STOP(timer, field)
+#define A2DE_PROFILE_COUNT(statement)
+#endif
+
 A2DE_BEGIN
 
-World::World(const a2de::WorldDef& world_definition) throw(...) : _dimensions(Vector2D(world_definition.width, world_definition.height)), _cameras(MapCams()), _objects(Objects()), _gh(nullptr), _dh(nullptr), _render_context(nullptr), _grid() {
+World::World(const a2de::WorldDef& world_definition) throw(...) : _dimensions(Vector2D(world_definition.width, world_definition.height)), _cameras(MapCams()), _objects(Objects()), _gh(nullptr), _dh(nullptr), _render_context(nullptr), _grid(), _step(0), _history(0), _deterministic(world_definition.deterministic), _state_hash(0), _stats(), _grid_positions(), _grid_objects(), _query_proxies(), _query_marks(), _query_stamp(0), _query_outside(), _query_oversized(), _query_reaches(), _query_elements(), _query_candidates(), _query_margin(), _query_grid_dirty(true), _query_index_dirty(true), _render_queue(), _previous_positions(), _dirty_camera_positions() {
     a2de::Math::SetWorldScale(world_definition.scale);
     
     try {
@@ -46,7 +58,9 @@ World::World(const a2de::WorldDef& world_definition) throw(...) : _dimensions(Ve
         if(a2de::Math::IsEqual(world_definition.drag_k1, 0.0) == false || a2de::Math::IsEqual(world_definition.drag_k2, 0.0) == false) {
             _dh = new DragForceGenerator(world_definition.drag_k1, world_definition.drag_k2);
         }
-        _render_context = a2de::RenderManager::GetInstance(*al_get_current_display());
+        //Headless worlds (servers, benchmarks) simulate without a display and skip rendering.
+        ALLEGRO_DISPLAY* display = al_get_current_display();
+        if(display) _render_context = a2de::RenderManager::GetInstance(*display);
 
         _grid = new QuadTree<a2de::Vector2D>(a2de::Rectangle(Vector2D(world_definition.width, world_definition.height) / 2.0, Vector2D(world_definition.width, world_definition.height) / 2.0, al_map_rgb(0, 255, 0), false));
 
@@ -110,6 +124,8 @@ bool World::AddObject(Object* obj) {
     if(obj->GetBody()) this->_grid->Add(obj->GetBody()->GetPosition());
 
     this->_objects.push_back(obj);
+    _query_grid_dirty = true;
+    if(obj->GetBody()) InvalidateBody(*obj->GetBody(), obj->GetBody()->GetPosition(), obj->GetBody()->GetPosition());
     return true;
 }
 
@@ -125,6 +141,8 @@ bool World::RemoveObject(Object* obj) {
         if(_gh) _gh->UnregisterBody(obj);
         if(_dh) _dh->UnregisterBody(obj);
         _grid->Remove(obj->GetBody()->GetPosition());
+        _query_grid_dirty = true;
+        InvalidateBody(*obj->GetBody(), obj->GetBody()->GetPosition(), obj->GetBody()->GetPosition());
         return true;
     }
     return false;
@@ -248,52 +266,146 @@ const DragForceGenerator* World::GetDragHandler() const {
 }
 
 void World::Render() {
+    Render(1.0);
+}
 
-    _objects.sort([&](const a2de::Object* elem_objectA, const a2de::Object* elem_objectB) ->bool {
-        return elem_objectA->GetZOrder() < elem_objectB->GetZOrder();
-    });
-
-    std::for_each(_cameras.begin(), _cameras.end(), [&](const std::pair<unsigned char, Camera>& elem_camera)
-    {
-        std::for_each(_objects.begin(), _objects.end(), [&](a2de::Object* elem_object) {
-
-            if(elem_object == nullptr) return;
+void World::Render(double alpha) {
 
-            RigidBody* b = elem_object->GetBody();
-            if(b == nullptr) return;
+    if(_render_context == nullptr) return;
 
-            IBoundingBox* bb = elem_object->GetBody()->GetBoundingRectangle();
-            if(bb == nullptr) return;
+    if(alpha < 0.0) alpha = 0.0;
+    if(alpha > 1.0) alpha = 1.0;
 
-            a2de::Vector2D pos = bb->GetTransform().GetPosition();
-            a2de::Vector2D he = bb->GetHalfExtents();
-            a2de::Rectangle bbr(pos, he);
+    //The object list is left in insertion order; snapshots and deterministic mode depend on it.
+    RefreshQueryIndex();
 
-            if(bbr.Intersects(elem_camera.second.GetArea()) == false) return;
+    for(MapCamsConstIter cameras_iter = _cameras.begin(); cameras_iter != _cameras.end(); ++cameras_iter) {
+        const Camera& camera = cameras_iter->second;
 
-            a2de::Vector2D draw_pos = a2de::World::WorldToCameraPosition(elem_camera.second, elem_object->GetBody()->GetPosition());
+        FindOverlappingProxies(camera.GetArea());
+        _render_queue.Clear();
+        std::size_t candidate_count = _query_candidates.size();
+        for(std::size_t i = 0; i < candidate_count; ++i) {
+            const QueryProxy& proxy = _query_proxies[_query_candidates[i]];
+            RigidBody* b = proxy.object->GetBody();
+            if(b == nullptr) continue;
+            if(b->GetBoundingRectangle() == nullptr) continue;
+            _render_queue.Submit(proxy.object, proxy.ordinal);
+        }
+        _render_queue.Sort();
+
+        //Objects outside the dirty region would only be clipped away, so they are not submitted.
+        bool cull_to_region = a2de::DirtyRegions::IsDrawingRegion() && a2de::DirtyRegions::GetRegionCount() > 0;
+        a2de::Rectangle region;
+        if(cull_to_region) region = a2de::DirtyRegions::GetRegion(0);
+
+        std::size_t item_count = _render_queue.GetSize();
+        for(std::size_t i = 0; i < item_count; ++i) {
+            const RenderQueue::Item& item = _render_queue.GetItem(i);
+            a2de::Object* elem_object = item.object;
+            a2de::Vector2D position = elem_object->GetBody()->GetPosition();
+            if(item.sequence < _previous_positions.size() && _previous_positions[item.sequence].object == elem_object) {
+                const a2de::Vector2D& previous = _previous_positions[item.sequence].position;
+                position = previous + (position - previous) * alpha;
+            }
+            a2de::Rectangle bounds;
+            if(cull_to_region && CalculateScreenBounds(camera, *elem_object->GetBody(), position, bounds) && region.Intersects(bounds) == false) continue;
+            a2de::Vector2D draw_pos = a2de::World::WorldToCameraPosition(camera, position);
             _render_context->RenderObjectAt(elem_object, a2de::Math::ToScreenScale(draw_pos));
-
-        });
-    });
+        }
+    }
 
 }
 
 void World::Update(double deltaTime) {
+    A2DE_PROFILE_COUNT(_stats = WorldStepStats());
+    A2DE_PROFILE_START(step_timer);
+    CapturePreviousPositions();
     UpdateObjectsInWorld(deltaTime);
     ResolveCollisions(deltaTime);
+    InvalidateDirtyRegions();
+    ++_step;
+    _query_index_dirty = true;
+    if(_deterministic) _state_hash = CalculateStateHash(_state_hash);
+    A2DE_PROFILE_STOP(step_timer, total_time);
+}
+
+void World::CapturePreviousPositions() {
+    _previous_positions.clear();
+    for(ObjectsIter _iter = _objects.begin(); _iter != _objects.end(); ++_iter) {
+        RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr) continue;
+        PreviousPosition previous;
+        previous.object = *_iter;
+        previous.position = body->GetPosition();
+        _previous_positions.push_back(previous);
+    }
+}
+
+bool World::CalculateScreenBounds(const Camera& camera, const a2de::RigidBody& body, const a2de::Vector2D& position, a2de::Rectangle& bounds) const {
+    const IBoundingBox* bb = body.GetBoundingRectangle();
+    if(bb == nullptr) return false;
+
+    //Render draws each object offset from where it is to where the camera puts it.
+    a2de::Vector2D draw_pos = a2de::Math::ToScreenScale(a2de::World::WorldToCameraPosition(camera, position));
+    a2de::Vector2D offset = a2de::Math::ToScreenScale(draw_pos - position);
+    a2de::Vector2D center = a2de::Math::ToScreenScale(bb->GetTransform().GetPosition() - body.GetPosition() + position) + offset;
+    a2de::Vector2D half_extents = a2de::Math::ToScreenScale(bb->GetHalfExtents()) + 2.0;
+    bounds = a2de::Rectangle(center, half_extents);
+    return true;
+}
+
+void World::InvalidateBody(const a2de::RigidBody& body, const a2de::Vector2D& old_position, const a2de::Vector2D& new_position) {
+    if(_render_context == nullptr || a2de::DirtyRegions::IsEnabled() == false) return;
+    for(MapCamsConstIter cameras_iter = _cameras.begin(); cameras_iter != _cameras.end(); ++cameras_iter) {
+        a2de::Rectangle old_bounds;
+        a2de::Rectangle new_bounds;
+        if(CalculateScreenBounds(cameras_iter->second, body, old_position, old_bounds) == false) return;
+        CalculateScreenBounds(cameras_iter->second, body, new_position, new_bounds);
+        a2de::DirtyRegions::Invalidate(old_bounds, new_bounds);
+    }
+}
+
+void World::InvalidateDirtyRegions() {
+    if(_render_context == nullptr || a2de::DirtyRegions::IsEnabled() == false) return;
+
+    bool cameras_moved = _dirty_camera_positions.size() != _cameras.size();
+    _dirty_camera_positions.resize(_cameras.size());
+    std::size_t camera_index = 0;
+    for(MapCamsConstIter cameras_iter = _cameras.begin(); cameras_iter != _cameras.end(); ++cameras_iter) {
+        const a2de::Vector2D& position = cameras_iter->second.GetPosition();
+        if(_dirty_camera_positions[camera_index] != position) cameras_moved = true;
+        _dirty_camera_positions[camera_index++] = position;
+    }
+    if(cameras_moved) {
+        a2de::DirtyRegions::InvalidateAll();
+        return;
+    }
+
+    std::size_t previous_count = _previous_positions.size();
+    for(std::size_t i = 0; i < previous_count; ++i) {
+        const PreviousPosition& previous = _previous_positions[i];
+        const RigidBody* body = previous.object->GetBody();
+        if(body == nullptr) continue;
+        if(body->GetPosition() == previous.position) continue;
+        InvalidateBody(*body, previous.position, body->GetPosition());
+    }
 }
 
 void World::UpdateObjectsInWorld(double deltaTime) {
 
+    A2DE_PROFILE_START(force_timer);
     if(_gh) _gh->Update(deltaTime);
     if(_dh) _dh->Update(deltaTime);
+    A2DE_PROFILE_STOP(force_timer, force_generation_time);
 
     if(_objects.empty()) return;
+    A2DE_PROFILE_START(integration_timer);
     std::for_each(_objects.begin(), _objects.end(), [deltaTime](Object* elem)
     {
         elem->Update(deltaTime);
     });
+    A2DE_PROFILE_STOP(integration_timer, integration_time);
 
 }
 
@@ -311,11 +423,17 @@ World::ContactPairs World::BroadPhaseCollision() {
     //For each visible Object in all Cameras: generate a unique Contact Pair.
     //Return the set of Contact Pairs.
 
+    A2DE_PROFILE_START(grid_timer);
     UpdateGrid();
+    A2DE_PROFILE_STOP(grid_timer, grid_time);
+    A2DE_PROFILE_COUNT(_stats.quadtree_depth = _grid->Depth());
+    A2DE_PROFILE_COUNT(_stats.quadtree_node_count = _grid->Divisions() + 1);
 
     ContactPairs cps;
     if(_objects.empty()) return cps; //returns empty cps
 
+    A2DE_PROFILE_START(broad_timer);
+
     for(ObjectsIter objects_iter = _objects.begin(); objects_iter != _objects.end(); ++objects_iter) {
         if((*objects_iter)->GetBody() == nullptr) continue;
         std::vector<a2de::QuadTree<a2de::Vector2D>* > p = this->_grid->GetNodesByLocation((*objects_iter)->GetBody()->GetPosition());
@@ -335,6 +453,7 @@ World::ContactPairs World::BroadPhaseCollision() {
         }
 
         ContactPairs current_cps_pairs = GenerateContactPairs(v);
+        A2DE_PROFILE_COUNT(_stats.candidate_pair_count += current_cps_pairs.size());
 
         //Remove any false positives. FP = non-colliding bounding boxes.
         for(World::ContactPairsIter contacts_iter = current_cps_pairs.begin(); contacts_iter != current_cps_pairs.end(); /* DO NOTHING */ ) {
@@ -344,12 +463,14 @@ World::ContactPairs World::BroadPhaseCollision() {
             IBoundingBox* fBB = first_body->GetBoundingRectangle();
             IBoundingBox* sBB = second_body->GetBoundingRectangle();
             if(fBB == nullptr && sBB == nullptr) {
+                A2DE_PROFILE_COUNT(++_stats.aabb_rejected_pair_count);
                 current_cps_pairs.erase(contacts_iter++);
                 continue;
             }
             a2de::Rectangle fR(fBB->GetTransform().GetPosition(), fBB->GetHalfExtents());
             a2de::Rectangle sR(sBB->GetTransform().GetPosition(), sBB->GetHalfExtents());
             if(fR.Intersects(sR) == false) {
+                A2DE_PROFILE_COUNT(++_stats.aabb_rejected_pair_count);
                 current_cps_pairs.erase(contacts_iter++);
                 continue;
             }
@@ -357,36 +478,130 @@ World::ContactPairs World::BroadPhaseCollision() {
         }
         cps.insert(current_cps_pairs.begin(), current_cps_pairs.end());
     }
+    A2DE_PROFILE_STOP(broad_timer, broad_phase_time);
     return cps;
 }
 
 void World::NarrowPhaseCollision(ContactPairs& contact_pairs, double deltaTime) {
 
-    //For Each contact pair, update the post-collision physics.
-    for(World::ContactPairsIter _iter = contact_pairs.begin(); _iter != contact_pairs.end(); ++_iter) {
+    A2DE_PROFILE_START(contact_timer);
+
+    //Solving a contact changes the bodies seen by the next one, so the order matters.
+    //The set is ordered by pointer value, which differs between machines and runs.
+    if(_deterministic) {
+        std::vector<ContactPair> ordered_pairs(OrderContactPairs(contact_pairs));
+        std::size_t pair_count = ordered_pairs.size();
+        for(std::size_t i = 0; i < pair_count; ++i) {
+            ResolveContact(ordered_pairs[i].GetFirstBody(), ordered_pairs[i].GetSecondBody(), deltaTime);
+        }
+    } else {
+        //For Each contact pair, update the post-collision physics.
+        for(World::ContactPairsIter _iter = contact_pairs.begin(); _iter != contact_pairs.end(); ++_iter) {
+            a2de::RigidBody* first_body = const_cast<a2de::RigidBody*>((*_iter).GetFirstBody());
+            a2de::RigidBody* second_body = const_cast<a2de::RigidBody*>((*_iter).GetSecondBody());
+            ResolveContact(first_body, second_body, deltaTime);
+        }
+    }
+
+    //Shape tests run inside the position solver and are accumulated separately.
+    A2DE_PROFILE_STOP(contact_timer, solver_time);
+    A2DE_PROFILE_COUNT(_stats.solver_time -= _stats.narrow_phase_time);
+}
+
+void World::ResolveContact(a2de::RigidBody* first_body, a2de::RigidBody* second_body, double deltaTime) {
+    if(MasksOverlap(*first_body, *second_body) == false) return;
+
+    first_body->Wake();
+    second_body->Wake();
+
+    //Process contact: Adjust Velocity. Adjust Position.
+    VelocitySolver(first_body, second_body);
+    PositionSolver(first_body, second_body, deltaTime);
+}
+
+bool World::MasksOverlap(const a2de::RigidBody& first, const a2de::RigidBody& second) const {
+    const a2de::CollisionMask* first_mask = first.GetCollisionMask();
+    const a2de::CollisionMask* second_mask = second.GetCollisionMask();
+    if(first_mask == nullptr && second_mask == nullptr) return true;
+    const a2de::IBoundingBox* first_bb = first.GetBoundingRectangle();
+    const a2de::IBoundingBox* second_bb = second.GetBoundingRectangle();
+    if(first_bb == nullptr || second_bb == nullptr) return true;
+
+    //Masks are in pixels; offsets are rounded to the nearest one.
+    a2de::Vector2D first_center(a2de::Math::ToScreenScale(first_bb->GetTransform().GetPosition()));
+    a2de::Vector2D second_center(a2de::Math::ToScreenScale(second_bb->GetTransform().GetPosition()));
+    if(first_mask != nullptr && second_mask != nullptr) {
+        a2de::Vector2D first_corner(first_center - a2de::Vector2D(first_mask->GetWidth(), first_mask->GetHeight()) / 2.0);
+        a2de::Vector2D second_corner(second_center - a2de::Vector2D(second_mask->GetWidth(), second_mask->GetHeight()) / 2.0);
+        a2de::Vector2D offset(second_corner - first_corner);
+        return first_mask->Overlaps(*second_mask, static_cast<int>(std::floor(offset.GetX() + 0.5)), static_cast<int>(std::floor(offset.GetY() + 0.5)));
+    }
+
+    const a2de::CollisionMask* mask = first_mask != nullptr ? first_mask : second_mask;
+    a2de::Vector2D mask_center(first_mask != nullptr ? first_center : second_center);
+    a2de::Vector2D box_center(first_mask != nullptr ? second_center : first_center);
+    a2de::Vector2D box_half_extents(a2de::Math::ToScreenScale(first_mask != nullptr ? second_bb->GetHalfExtents() : first_bb->GetHalfExtents()));
+    a2de::Vector2D mask_corner(mask_center - a2de::Vector2D(mask->GetWidth(), mask->GetHeight()) / 2.0);
+    a2de::Vector2D box_corner(box_center - box_half_extents - mask_corner);
+    return mask->Overlaps(static_cast<int>(std::floor(box_corner.GetX() + 0.5)),
+                          static_cast<int>(std::floor(box_corner.GetY() + 0.5)),
+                          static_cast<int>(std::floor(box_half_extents.GetX() * 2.0 + 0.5)),
+                          static_cast<int>(std::floor(box_half_extents.GetY() * 2.0 + 0.5)));
+}
+
+std::vector<ContactPair> World::OrderContactPairs(const ContactPairs& contact_pairs) const {
+
+    //Only used for lookups; the map's own pointer ordering never leaks into the result.
+    std::map<const a2de::RigidBody*, std::size_t> body_order;
+    std::size_t ordinal = 0;
+    for(Objects::const_iterator _iter = _objects.begin(); _iter != _objects.end(); ++_iter) {
+        const a2de::RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr) continue;
+        body_order.insert(std::make_pair(body, ordinal++));
+    }
+
+    typedef std::pair<std::pair<std::size_t, std::size_t>, ContactPair> OrderedPair;
+    std::vector<OrderedPair> ordered;
+    ordered.reserve(contact_pairs.size());
+    for(ContactPairsConstIter _iter = contact_pairs.begin(); _iter != contact_pairs.end(); ++_iter) {
         a2de::RigidBody* first_body = const_cast<a2de::RigidBody*>((*_iter).GetFirstBody());
         a2de::RigidBody* second_body = const_cast<a2de::RigidBody*>((*_iter).GetSecondBody());
+        std::size_t first_ordinal = body_order[first_body];
+        std::size_t second_ordinal = body_order[second_body];
+        if(second_ordinal < first_ordinal) {
+            std::swap(first_body, second_body);
+            std::swap(first_ordinal, second_ordinal);
+        }
+        ordered.push_back(std::make_pair(std::make_pair(first_ordinal, second_ordinal), ContactPair(first_body, second_body)));
+    }
 
-        first_body->Wake();
-        second_body->Wake();
+    std::sort(ordered.begin(), ordered.end(), [](const OrderedPair& a, const OrderedPair& b)->bool { return a.first < b.first; });
+    ordered.erase(std::unique(ordered.begin(), ordered.end(), [](const OrderedPair& a, const OrderedPair& b)->bool { return a.first == b.first; }), ordered.end());
 
-        //Process contact: Adjust Velocity. Adjust Position.
-        VelocitySolver(first_body, second_body);
-        PositionSolver(first_body, second_body, deltaTime);
+    std::vector<ContactPair> result;
+    result.reserve(ordered.size());
+    for(std::vector<OrderedPair>::const_iterator _iter = ordered.begin(); _iter != ordered.end(); ++_iter) {
+        result.push_back(_iter->second);
     }
-
+    return result;
 }
 
 void World::UpdateGrid() {
 
-    std::vector<a2de::Vector2D> objs;
+    _grid_positions.clear();
+    _grid_objects.clear();
     for(auto _iter = this->_objects.begin(); _iter != this->_objects.end(); ++_iter ) {
         if((*_iter)->GetBody() == nullptr) continue;
+        A2DE_PROFILE_COUNT(++_stats.body_count);
+        A2DE_PROFILE_COUNT(if((*_iter)->GetBody()->IsActive()) ++_stats.awake_body_count);
         a2de::Vector2D collision_position = (*_iter)->GetBody()->GetPosition();
-        objs.push_back(collision_position);
+        _grid_positions.push_back(collision_position);
+        _grid_objects.push_back(*_iter);
     }
     _grid->Clear();
-    _grid->Add(objs);
+    _grid->Add(_grid_positions);
+    _query_grid_dirty = false;
+    _query_index_dirty = true;
 }
 
 void World::QueryAllCameras(std::vector<a2de::Vector2D>& queried_elems) {
@@ -519,9 +734,12 @@ void World::PositionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_
 
     if(first_collision_shape == nullptr && second_collision_shape == nullptr) return;
 
+    A2DE_PROFILE_START(shape_timer);
     std::vector<ContactData> collision_results(ShapeCollisionSolver(first_body, second_body));
+    A2DE_PROFILE_STOP(shape_timer, narrow_phase_time);
 
     if(collision_results.empty()) return;
+    A2DE_PROFILE_COUNT(++_stats.contact_count);
 
     double mass_sum = first_mass + second_mass;
 
@@ -715,6 +933,396 @@ a2de::QuadTree<a2de::Vector2D>* World::GetGrid() {
     return const_cast<a2de::QuadTree<a2de::Vector2D>*>(static_cast<const World&>(*this).GetGrid());
 }
 
+unsigned long World::GetStep() const {
+    return _step;
+}
+
+WorldSnapshot World::Snapshot() const {
+    WorldSnapshot snapshot;
+    Snapshot(snapshot);
+    return snapshot;
+}
+
+void World::Snapshot(WorldSnapshot& snapshot) const {
+    snapshot.Clear();
+    snapshot._step = _step;
+    snapshot._state_hash = _state_hash;
+    for(Objects::const_iterator _iter = _objects.begin(); _iter != _objects.end(); ++_iter) {
+        const RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr) continue;
+        snapshot._bodies.push_back(BodySnapshot());
+        body->SaveSnapshot(snapshot._bodies.back(), snapshot._forces, snapshot._impulses);
+    }
+}
+
+bool World::Restore(const WorldSnapshot& snapshot) {
+    std::size_t body_count = 0;
+    for(ObjectsIter _iter = _objects.begin(); _iter != _objects.end(); ++_iter) {
+        if((*_iter)->GetBody()) ++body_count;
+    }
+    if(body_count != snapshot._bodies.size()) return false;
+
+    std::size_t index = 0;
+    for(ObjectsIter _iter = _objects.begin(); _iter != _objects.end(); ++_iter) {
+        RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr) continue;
+        body->RestoreSnapshot(snapshot._bodies[index++], snapshot._forces, snapshot._impulses);
+    }
+    _step = snapshot._step;
+    _state_hash = snapshot._state_hash;
+    _query_grid_dirty = true;
+    //Nothing to blend from; draw the restored state as is.
+    CapturePreviousPositions();
+    return true;
+}
+
+void World::SetSnapshotHistoryLength(std::size_t steps) {
+    _history.SetCapacity(steps);
+}
+
+const SnapshotHistory& World::GetSnapshotHistory() const {
+    return _history;
+}
+
+bool World::RecordSnapshot() {
+    WorldSnapshot* slot = _history.Next();
+    if(slot == nullptr) return false;
+    Snapshot(*slot);
+    return true;
+}
+
+bool World::Rewind(unsigned long step) {
+    const WorldSnapshot* snapshot = _history.Find(step);
+    if(snapshot == nullptr) return false;
+    if(Restore(*snapshot) == false) return false;
+    _history.DiscardAfter(step);
+    return true;
+}
+
+bool World::IsDeterministic() const {
+    return _deterministic;
+}
+
+void World::SetDeterministic(bool deterministic) {
+    _deterministic = deterministic;
+}
+
+unsigned long long World::GetStateHash() const {
+    return _state_hash;
+}
+
+unsigned long long World::CalculateStateHash(unsigned long long seed) const {
+
+    //64-bit FNV-1a over raw bit patterns. Integer-only, so the hash itself cannot drift.
+    const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+    unsigned long long hash = seed ^ FNV_OFFSET_BASIS;
+    for(Objects::const_iterator _iter = _objects.begin(); _iter != _objects.end(); ++_iter) {
+        const a2de::RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr) continue;
+        double values[5] = { body->GetXPosition(), body->GetYPosition(), body->GetXVelocity(), body->GetYVelocity(), body->IsActive() ? 1.0 : 0.0 };
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+        for(std::size_t i = 0; i < sizeof(values); ++i) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+const WorldStepStats& World::GetStepStats() const {
+    return _stats;
+}
+
+std::vector<Object*> World::QueryAABB(const a2de::Rectangle& area) {
+    std::vector<Object*> results;
+    QueryAABB(area, results);
+    return results;
+}
+
+std::size_t World::QueryAABB(const a2de::Rectangle& area, std::vector<Object*>& results) {
+    RefreshQueryIndex();
+    FindOverlappingProxies(area);
+
+    std::size_t candidate_count = _query_candidates.size();
+    for(std::size_t i = 0; i < candidate_count; ++i) {
+        results.push_back(_query_proxies[_query_candidates[i]].object);
+    }
+    return candidate_count;
+}
+
+std::vector<Object*> World::QueryRadius(const a2de::Vector2D& center, double radius) {
+    std::vector<Object*> results;
+    QueryRadius(center, radius, results);
+    return results;
+}
+
+std::size_t World::QueryRadius(const a2de::Vector2D& center, double radius, std::vector<Object*>& results) {
+    RefreshQueryIndex();
+
+    _query_elements.clear();
+    _grid->Query(a2de::Rectangle(center, a2de::Vector2D(radius, radius) + _query_margin), _query_elements);
+    GatherQueryCandidates(_query_elements);
+
+    double radius_squared = radius * radius;
+    std::size_t found = 0;
+    std::size_t candidate_count = _query_candidates.size();
+    for(std::size_t i = 0; i < candidate_count; ++i) {
+        const QueryProxy& proxy = _query_proxies[_query_candidates[i]];
+        double closest_x = std::min(std::max(center.GetX(), proxy.box_min.GetX()), proxy.box_max.GetX());
+        double closest_y = std::min(std::max(center.GetY(), proxy.box_min.GetY()), proxy.box_max.GetY());
+        double dx = center.GetX() - closest_x;
+        double dy = center.GetY() - closest_y;
+        if((dx * dx) + (dy * dy) > radius_squared) continue;
+        results.push_back(proxy.object);
+        ++found;
+    }
+    return found;
+}
+
+bool World::Raycast(const a2de::Vector2D& start, const a2de::Vector2D& end, RaycastHit& hit) {
+    RefreshQueryIndex();
+    hit = RaycastHit();
+    return Sweep(start, end, a2de::Vector2D(), 0.0, hit, nullptr);
+}
+
+std::size_t World::RaycastAll(const a2de::Vector2D& start, const a2de::Vector2D& end, std::vector<RaycastHit>& hits) {
+    RefreshQueryIndex();
+    std::size_t first = hits.size();
+    RaycastHit closest;
+    Sweep(start, end, a2de::Vector2D(), 0.0, closest, &hits);
+    std::sort(hits.begin() + first, hits.end(), [](const RaycastHit& a, const RaycastHit& b)->bool { return a.fraction < b.fraction; });
+    return hits.size() - first;
+}
+
+bool World::ShapeCast(const a2de::Shape& shape, const a2de::Vector2D& translation, RaycastHit& hit) {
+    RefreshQueryIndex();
+    hit = RaycastHit();
+
+    double radius = 0.0;
+    a2de::Vector2D half_extents(shape.GetHalfExtents());
+    if(shape.GetShapeType() == a2de::Shape::SHAPETYPE_CIRCLE) {
+        radius = static_cast<const a2de::Circle&>(shape).GetRadius();
+        half_extents = a2de::Vector2D(radius, radius);
+    }
+    return Sweep(shape.GetPosition(), shape.GetPosition() + translation, half_extents, radius, hit, nullptr);
+}
+
+std::size_t World::RaycastBatch(const std::vector<RayQuery>& rays, std::vector<RaycastHit>& hits) {
+    RefreshQueryIndex();
+
+    std::size_t ray_count = rays.size();
+    hits.assign(ray_count, RaycastHit());
+    std::size_t hit_count = 0;
+    for(std::size_t i = 0; i < ray_count; ++i) {
+        if(Sweep(rays[i].start, rays[i].end, a2de::Vector2D(), 0.0, hits[i], nullptr)) ++hit_count;
+    }
+    return hit_count;
+}
+
+void World::QueryAABBBatch(const std::vector<a2de::Rectangle>& areas, std::vector<std::vector<Object*> >& results) {
+    RefreshQueryIndex();
+
+    std::size_t area_count = areas.size();
+    results.resize(area_count);
+    for(std::size_t i = 0; i < area_count; ++i) {
+        results[i].clear();
+        QueryAABB(areas[i], results[i]);
+    }
+}
+
+void World::RefreshQueryIndex() {
+    if(_query_grid_dirty) UpdateGrid();
+    if(_query_index_dirty == false) return;
+
+    std::size_t proxy_count = _grid_objects.size();
+    _query_proxies.resize(proxy_count);
+    for(std::size_t i = 0; i < proxy_count; ++i) {
+        QueryProxy& proxy = _query_proxies[i];
+        proxy.grid_position = _grid_positions[i];
+        proxy.object = _grid_objects[i];
+        proxy.ordinal = static_cast<unsigned long>(i);
+        proxy.in_grid = _grid->GetBounds().Intersects(proxy.grid_position);
+
+        a2de::Vector2D center = proxy.grid_position;
+        a2de::Vector2D half_extents;
+        const a2de::RigidBody* body = proxy.object->GetBody();
+        if(body) {
+            center = body->GetPosition();
+            const IBoundingBox* bb = body->GetBoundingRectangle();
+            if(bb) {
+                center = bb->GetTransform().GetPosition();
+                half_extents = bb->GetHalfExtents();
+            }
+        }
+        proxy.box_min = center - half_extents;
+        proxy.box_max = center + half_extents;
+    }
+
+    std::stable_sort(_query_proxies.begin(), _query_proxies.end(), [](const QueryProxy& a, const QueryProxy& b)->bool {
+        if(a.grid_position.GetX() != b.grid_position.GetX()) return a.grid_position.GetX() < b.grid_position.GetX();
+        return a.grid_position.GetY() < b.grid_position.GetY();
+    });
+    _query_outside.clear();
+    for(std::size_t i = 0; i < proxy_count; ++i) {
+        if(_query_proxies[i].in_grid == false) _query_outside.push_back(i);
+    }
+
+    //Bodies have moved since the grid was built. Growing every query by how far a box reaches
+    //from its grid position keeps the results exact without rebuilding the tree. The margin is
+    //sized for the typical box; the few that reach further are tested by every query instead.
+    auto reach = [](const QueryProxy& proxy)->double {
+        double reach_x = std::max(std::fabs(proxy.box_min.GetX() - proxy.grid_position.GetX()), std::fabs(proxy.box_max.GetX() - proxy.grid_position.GetX()));
+        double reach_y = std::max(std::fabs(proxy.box_min.GetY() - proxy.grid_position.GetY()), std::fabs(proxy.box_max.GetY() - proxy.grid_position.GetY()));
+        return std::max(reach_x, reach_y);
+    };
+    double margin = 0.0;
+    if(proxy_count > 0) {
+        _query_reaches.resize(proxy_count);
+        for(std::size_t i = 0; i < proxy_count; ++i) {
+            _query_reaches[i] = reach(_query_proxies[i]);
+        }
+        std::nth_element(_query_reaches.begin(), _query_reaches.begin() + proxy_count / 2, _query_reaches.end());
+        margin = _query_reaches[proxy_count / 2] * 2.0;
+    }
+    _query_margin = a2de::Vector2D(margin, margin);
+    _query_oversized.clear();
+    for(std::size_t i = 0; i < proxy_count; ++i) {
+        if(_query_proxies[i].in_grid && reach(_query_proxies[i]) > margin) _query_oversized.push_back(i);
+    }
+    _query_marks.assign(proxy_count, 0);
+    _query_stamp = 0;
+    _query_index_dirty = false;
+}
+
+void World::GatherQueryCandidates(const std::vector<a2de::Vector2D>& elements) {
+    _query_candidates.clear();
+
+    //Elements on a node boundary are stored in more than one leaf; the stamp filters repeats.
+    if(++_query_stamp == 0) {
+        std::fill(_query_marks.begin(), _query_marks.end(), 0);
+        _query_stamp = 1;
+    }
+
+    std::size_t proxy_count = _query_proxies.size();
+    std::size_t element_count = elements.size();
+    for(std::size_t i = 0; i < element_count; ++i) {
+        const a2de::Vector2D& element = elements[i];
+        std::vector<QueryProxy>::const_iterator first = std::lower_bound(_query_proxies.begin(), _query_proxies.end(), element, [](const QueryProxy& proxy, const a2de::Vector2D& position)->bool {
+            if(proxy.grid_position.GetX() != position.GetX()) return proxy.grid_position.GetX() < position.GetX();
+            return proxy.grid_position.GetY() < position.GetY();
+        });
+        for(std::size_t index = first - _query_proxies.begin(); index < proxy_count; ++index) {
+            const a2de::Vector2D& grid_position = _query_proxies[index].grid_position;
+            if(grid_position.GetX() != element.GetX() || grid_position.GetY() != element.GetY()) break;
+            if(_query_marks[index] == _query_stamp) continue;
+            _query_marks[index] = _query_stamp;
+            _query_candidates.push_back(index);
+        }
+    }
+
+    //The grid rejects positions outside the world bounds, and the margin does not cover oversized
+    //boxes; those bodies are always candidates.
+    std::size_t outside_count = _query_outside.size();
+    for(std::size_t i = 0; i < outside_count; ++i) {
+        std::size_t index = _query_outside[i];
+        if(_query_marks[index] == _query_stamp) continue;
+        _query_marks[index] = _query_stamp;
+        _query_candidates.push_back(index);
+    }
+    std::size_t oversized_count = _query_oversized.size();
+    for(std::size_t i = 0; i < oversized_count; ++i) {
+        std::size_t index = _query_oversized[i];
+        if(_query_marks[index] == _query_stamp) continue;
+        _query_marks[index] = _query_stamp;
+        _query_candidates.push_back(index);
+    }
+}
+
+void World::FindOverlappingProxies(const a2de::Rectangle& area) {
+
+    a2de::Vector2D area_min = area.GetPosition() - area.GetHalfExtents();
+    a2de::Vector2D area_max = area.GetPosition() + area.GetHalfExtents();
+
+    _query_elements.clear();
+    _grid->Query(a2de::Rectangle(area.GetPosition(), area.GetHalfExtents() + _query_margin), _query_elements);
+    GatherQueryCandidates(_query_elements);
+
+    std::size_t kept = 0;
+    std::size_t candidate_count = _query_candidates.size();
+    for(std::size_t i = 0; i < candidate_count; ++i) {
+        const QueryProxy& proxy = _query_proxies[_query_candidates[i]];
+        if(proxy.box_max.GetX() < area_min.GetX() || proxy.box_min.GetX() > area_max.GetX()) continue;
+        if(proxy.box_max.GetY() < area_min.GetY() || proxy.box_min.GetY() > area_max.GetY()) continue;
+        _query_candidates[kept++] = _query_candidates[i];
+    }
+    _query_candidates.resize(kept);
+}
+
+bool World::CastQueryProxy(const QueryProxy& proxy, const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& half_extents, double radius, RaycastHit& hit) const {
+
+    //Sweeping a box against a box is a ray against the box grown by the swept half extents.
+    double fraction = 0.0;
+    a2de::Vector2D normal;
+    if(a2de::Math::IntersectSegmentBox(start, end, proxy.box_min - half_extents, proxy.box_max + half_extents, fraction, normal) == false) return false;
+
+    a2de::Vector2D delta = end - start;
+    a2de::Vector2D point = start + delta * fraction;
+
+    if(radius > 0.0) {
+        //A circle grows the box with rounded corners. If the entry point is in a corner region the
+        //circle has to reach the corner itself.
+        bool beyond_x = point.GetX() < proxy.box_min.GetX() || point.GetX() > proxy.box_max.GetX();
+        bool beyond_y = point.GetY() < proxy.box_min.GetY() || point.GetY() > proxy.box_max.GetY();
+        if(beyond_x && beyond_y) {
+            a2de::Vector2D corner(point.GetX() < proxy.box_min.GetX() ? proxy.box_min.GetX() : proxy.box_max.GetX(), point.GetY() < proxy.box_min.GetY() ? proxy.box_min.GetY() : proxy.box_max.GetY());
+            a2de::Vector2D offset = start - corner;
+            double a = delta.GetLengthSquared();
+            double b = offset.DotProduct(delta);
+            double c = offset.GetLengthSquared() - (radius * radius);
+            if(c > 0.0) {
+                if(a2de::Math::IsEqual(a, 0.0) || b > 0.0) return false;
+                double discriminant = (b * b) - (a * c);
+                if(discriminant < 0.0) return false;
+                fraction = (-b - std::sqrt(discriminant)) / a;
+                if(fraction > 1.0) return false;
+                point = start + delta * fraction;
+                normal = (point - corner) * (1.0 / radius);
+            } else {
+                fraction = 0.0;
+                point = start;
+                normal = a2de::Vector2D();
+            }
+        }
+    }
+
+    hit.object = proxy.object;
+    hit.point = point;
+    hit.normal = normal;
+    hit.fraction = fraction;
+    return true;
+}
+
+bool World::Sweep(const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& half_extents, double radius, RaycastHit& hit, std::vector<RaycastHit>* all_hits) {
+
+    _query_elements.clear();
+    _grid->Query(start, end, _query_margin + half_extents, _query_elements);
+    GatherQueryCandidates(_query_elements);
+
+    bool found = false;
+    std::size_t candidate_count = _query_candidates.size();
+    for(std::size_t i = 0; i < candidate_count; ++i) {
+        RaycastHit current;
+        if(CastQueryProxy(_query_proxies[_query_candidates[i]], start, end, half_extents, radius, current) == false) continue;
+        if(all_hits) all_hits->push_back(current);
+        if(found && hit.fraction <= current.fraction) continue;
+        hit = current;
+        found = true;
+    }
+    return found;
+}
+
 void World::DeallocateWorld() {
 
     delete _grid;
@@ -22,6 +22,9 @@
 #include "../Math/CRectangle.h"
 #include "CQuadTree.h"
 #include "CContactData.h"
+#include "CWorldSnapshot.h"
+#include "CWorldQuery.h"
+#include "../GFX/CRenderQueue.h"
 
 A2DE_BEGIN
 
@@ -51,6 +54,7 @@ struct WorldDef {
         drag_k1 = 0.0;
         drag_k2 = 0.0;
         scale = 0.01;
+        deterministic = false;
     }
     /// <summary> The width of the world in meters.</summary>
     double width;
@@ -66,6 +70,66 @@ struct WorldDef {
     double drag_k2;
     /// <summary> The meters-to-pixels ratio for world scale.</summary>
     double scale;
+    /// <summary> true to resolve contacts in a fixed order and track a per-step state hash.</summary>
+    bool deterministic;
+};
+
+/**************************************************************************************************
+* <summary>Cost breakdown of the most recent World step.</summary>
+* <remarks>Casey Ugone, 10/19/2026.
+*          Only filled in when the engine is built with A2DE_PROFILE_PHYSICS defined. Times are in
+*          seconds of wall time.</remarks>
+**************************************************************************************************/
+struct WorldStepStats {
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    WorldStepStats() {
+        force_generation_time = 0.0;
+        integration_time = 0.0;
+        grid_time = 0.0;
+        broad_phase_time = 0.0;
+        narrow_phase_time = 0.0;
+        solver_time = 0.0;
+        total_time = 0.0;
+        body_count = 0;
+        awake_body_count = 0;
+        candidate_pair_count = 0;
+        aabb_rejected_pair_count = 0;
+        contact_count = 0;
+        quadtree_depth = 0;
+        quadtree_node_count = 0;
+    }
+    /// <summary> Time spent in the gravity and drag generators.</summary>
+    double force_generation_time;
+    /// <summary> Time spent updating objects.</summary>
+    double integration_time;
+    /// <summary> Time spent rebuilding the spatial partition grid.</summary>
+    double grid_time;
+    /// <summary> Time spent generating and culling contact pairs, excluding the grid rebuild.</summary>
+    double broad_phase_time;
+    /// <summary> Time spent testing collision shapes.</summary>
+    double narrow_phase_time;
+    /// <summary> Time spent adjusting velocities and positions, excluding shape tests.</summary>
+    double solver_time;
+    /// <summary> Time spent in Update.</summary>
+    double total_time;
+    /// <summary> The number of objects with a body.</summary>
+    unsigned long body_count;
+    /// <summary> The number of awake bodies after integration.</summary>
+    unsigned long awake_body_count;
+    /// <summary> The number of pairs produced by the grid before the bounding box test.</summary>
+    unsigned long candidate_pair_count;
+    /// <summary> The number of candidate pairs whose bounding boxes did not overlap.</summary>
+    unsigned long aabb_rejected_pair_count;
+    /// <summary> The number of pairs whose collision shapes touched.</summary>
+    unsigned long contact_count;
+    /// <summary> The number of levels in the grid.</summary>
+    unsigned long quadtree_depth;
+    /// <summary> The number of nodes in the grid.</summary>
+    unsigned long quadtree_node_count;
 };
 
 
@@ -124,7 +188,9 @@ public:
 
     /**************************************************************************************************
      * <summary>Constructor.</summary>
-     * <remarks>Casey Ugone, 8/15/2013.</remarks>
+     * <remarks>Casey Ugone, 8/15/2013.
+     *          If no display is current the world is headless: it simulates normally but Render
+     *          does nothing.</remarks>
      * <param name="world_definition">The world definition.</param>
      **************************************************************************************************/
     World(const a2de::WorldDef& world_definition);
@@ -186,11 +252,26 @@ public:
     void SetDimensions(double width, double height);
 
     /**************************************************************************************************
-     * <summary>Renders the world.</summary>
-     * <remarks>Casey Ugone, 10/10/2014.</remarks>
+     * <summary>Renders the world. Does nothing for a headless world.</summary>
+     * <remarks>Casey Ugone, 10/10/2014.
+     *          Each camera draws only the objects the grid reports inside its area, ordered by
+     *          z-order, then texture, then their position in the object list.</remarks>
      **************************************************************************************************/
     void Render();
 
+    /**************************************************************************************************
+     * <summary>Renders the world between the last two steps. Does nothing for a headless world.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Each body is drawn at its position before the last Update blended toward its
+     *          current one, so the world can step at a lower rate than it is drawn without
+     *          stuttering. Bodies added since the last Update, and every body after Restore, are
+     *          drawn where they are.</remarks>
+     * <param name="alpha">How far between the last two steps to draw, from 0 (the previous step)
+     *                     to 1 (the current step). Game passes the fraction of a step left in its
+     *                     accumulator.</param>
+     **************************************************************************************************/
+    void Render(double alpha);
+
     /**************************************************************************************************
      * <summary>Adds a camera.</summary>
      * <remarks>Casey Ugone, 3/16/2012.</remarks>
@@ -371,9 +452,318 @@ public:
      **************************************************************************************************/
     a2de::QuadTree<a2de::Vector2D>* GetGrid();
 
+    /**************************************************************************************************
+     * <summary>Gets the number of times Update has been called.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The step.</returns>
+     **************************************************************************************************/
+    unsigned long GetStep() const;
+
+    /**************************************************************************************************
+     * <summary>Captures the simulated state of every body in the world.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The snapshot.</returns>
+     **************************************************************************************************/
+    WorldSnapshot Snapshot() const;
+
+    /**************************************************************************************************
+     * <summary>Captures the simulated state of every body in the world into an existing snapshot.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The snapshot's storage is reused; this does not allocate once it has grown to fit.</remarks>
+     * <param name="snapshot">[out] The snapshot to fill.</param>
+     **************************************************************************************************/
+    void Snapshot(WorldSnapshot& snapshot) const;
+
+    /**************************************************************************************************
+     * <summary>Restores the simulated state of every body in the world.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Bodies are matched by their order in the object list. The grid is rebuilt on the next
+     *          Update.</remarks>
+     * <param name="snapshot">The snapshot.</param>
+     * <returns>true if it succeeds, false if the number of bodies has changed since the snapshot was taken.</returns>
+     **************************************************************************************************/
+    bool Restore(const WorldSnapshot& snapshot);
+
+    /**************************************************************************************************
+     * <summary>Sets the number of steps kept by the snapshot history. Zero disables it.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="steps">The number of steps.</param>
+     **************************************************************************************************/
+    void SetSnapshotHistoryLength(std::size_t steps);
+
+    /**************************************************************************************************
+     * <summary>Gets the snapshot history.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The snapshot history.</returns>
+     **************************************************************************************************/
+    const SnapshotHistory& GetSnapshotHistory() const;
+
+    /**************************************************************************************************
+     * <summary>Records the current state in the snapshot history.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if it succeeds, false if the history is disabled.</returns>
+     **************************************************************************************************/
+    bool RecordSnapshot();
+
+    /**************************************************************************************************
+     * <summary>Restores the state recorded at a step and discards every later step.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="step">The step.</param>
+     * <returns>true if it succeeds, false if the step is not in the history or cannot be restored.</returns>
+     **************************************************************************************************/
+    bool Rewind(unsigned long step);
+
+    /**************************************************************************************************
+     * <summary>Query if the world runs in deterministic lockstep mode.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if deterministic, false if not.</returns>
+     **************************************************************************************************/
+    bool IsDeterministic() const;
+
+    /**************************************************************************************************
+     * <summary>Enables or disables deterministic lockstep mode.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          When enabled contacts are resolved in object order instead of pointer order and a
+     *          rolling hash of every body is updated each step. Two worlds built by adding the same
+     *          objects in the same order produce the same hash as long as they stay in sync.</remarks>
+     * <param name="deterministic">true to enable.</param>
+     **************************************************************************************************/
+    void SetDeterministic(bool deterministic);
+
+    /**************************************************************************************************
+     * <summary>Gets the rolling state hash. Only updated in deterministic mode.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The hash of every step's body state since the world was created or last restored.</returns>
+     **************************************************************************************************/
+    unsigned long long GetStateHash() const;
+
+    /**************************************************************************************************
+     * <summary>Calculates a hash of the current body state.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Hashes the exact bit patterns of each body's position, velocity and awake flag in
+     *          object order.</remarks>
+     * <param name="seed">The value to start hashing from.</param>
+     * <returns>The hash.</returns>
+     **************************************************************************************************/
+    unsigned long long CalculateStateHash(unsigned long long seed) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the cost breakdown of the most recent step.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          All zeros unless the engine is built with A2DE_PROFILE_PHYSICS defined.</remarks>
+     * <returns>The step statistics.</returns>
+     **************************************************************************************************/
+    const WorldStepStats& GetStepStats() const;
+
+    /**************************************************************************************************
+     * <summary>Finds every object whose bounding rectangle overlaps an area.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Queries are served by the spatial partition grid and test against the same bounding
+     *          rectangles as the broad phase.</remarks>
+     * <param name="area">The area in world units.</param>
+     * <returns>The objects.</returns>
+     **************************************************************************************************/
+    std::vector<Object*> QueryAABB(const a2de::Rectangle& area);
+
+    /**************************************************************************************************
+     * <summary>Finds every object whose bounding rectangle overlaps an area.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="area">   The area in world units.</param>
+     * <param name="results">[in,out] The container to append the objects to.</param>
+     * <returns>The number of objects found.</returns>
+     **************************************************************************************************/
+    std::size_t QueryAABB(const a2de::Rectangle& area, std::vector<Object*>& results);
+
+    /**************************************************************************************************
+     * <summary>Finds every object whose bounding rectangle is within a distance of a point.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="center">The center in world units.</param>
+     * <param name="radius">The radius in world units.</param>
+     * <returns>The objects.</returns>
+     **************************************************************************************************/
+    std::vector<Object*> QueryRadius(const a2de::Vector2D& center, double radius);
+
+    /**************************************************************************************************
+     * <summary>Finds every object whose bounding rectangle is within a distance of a point.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="center"> The center in world units.</param>
+     * <param name="radius"> The radius in world units.</param>
+     * <param name="results">[in,out] The container to append the objects to.</param>
+     * <returns>The number of objects found.</returns>
+     **************************************************************************************************/
+    std::size_t QueryRadius(const a2de::Vector2D& center, double radius, std::vector<Object*>& results);
+
+    /**************************************************************************************************
+     * <summary>Finds the first object crossed by a line segment.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="start">The start of the ray in world units.</param>
+     * <param name="end">  The end of the ray in world units.</param>
+     * <param name="hit">  [out] The closest hit.</param>
+     * <returns>true if something was hit, false if not.</returns>
+     **************************************************************************************************/
+    bool Raycast(const a2de::Vector2D& start, const a2de::Vector2D& end, RaycastHit& hit);
+
+    /**************************************************************************************************
+     * <summary>Finds every object crossed by a line segment.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="start">The start of the ray in world units.</param>
+     * <param name="end">  The end of the ray in world units.</param>
+     * <param name="hits"> [in,out] The container to append the hits to, nearest first.</param>
+     * <returns>The number of hits.</returns>
+     **************************************************************************************************/
+    std::size_t RaycastAll(const a2de::Vector2D& start, const a2de::Vector2D& end, std::vector<RaycastHit>& hits);
+
+    /**************************************************************************************************
+     * <summary>Sweeps a shape along a translation and finds the first object it touches.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The shape is swept as its axis-aligned half extents; circles keep their rounded
+     *          corners.</remarks>
+     * <param name="shape">      The shape at its starting position.</param>
+     * <param name="translation">The distance to sweep the shape in world units.</param>
+     * <param name="hit">        [out] The closest hit.</param>
+     * <returns>true if something was hit, false if not.</returns>
+     **************************************************************************************************/
+    bool ShapeCast(const a2de::Shape& shape, const a2de::Vector2D& translation, RaycastHit& hit);
+
+    /**************************************************************************************************
+     * <summary>Finds the first object crossed by each of a set of line segments.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Cheaper than calling Raycast in a loop: the grid is refreshed once and the scratch
+     *          storage is shared by every ray.</remarks>
+     * <param name="rays">The rays.</param>
+     * <param name="hits">[out] One hit per ray. Misses have a null object.</param>
+     * <returns>The number of rays that hit something.</returns>
+     **************************************************************************************************/
+    std::size_t RaycastBatch(const std::vector<RayQuery>& rays, std::vector<RaycastHit>& hits);
+
+    /**************************************************************************************************
+     * <summary>Finds the objects overlapping each of a set of areas.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="areas">  The areas in world units.</param>
+     * <param name="results">[out] One container of objects per area.</param>
+     **************************************************************************************************/
+    void QueryAABBBatch(const std::vector<a2de::Rectangle>& areas, std::vector<std::vector<Object*> >& results);
+
 protected:
 private:
 
+    /**************************************************************************************************
+     * <summary>An object's entry in the query index.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct QueryProxy {
+        /// <summary> The position the object was added to the grid at.</summary>
+        a2de::Vector2D grid_position;
+        /// <summary> The minimum corner of the current bounding rectangle.</summary>
+        a2de::Vector2D box_min;
+        /// <summary> The maximum corner of the current bounding rectangle.</summary>
+        a2de::Vector2D box_max;
+        /// <summary> The object.</summary>
+        a2de::Object* object;
+        /// <summary> The object's position among the bodies in the object list.</summary>
+        unsigned long ordinal;
+        /// <summary> false if the grid position was outside the world bounds.</summary>
+        bool in_grid;
+    };
+
+    /**************************************************************************************************
+     * <summary>A body's position before the last step.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    struct PreviousPosition {
+        /// <summary> The object the body belongs to.</summary>
+        a2de::Object* object;
+        /// <summary> The position.</summary>
+        a2de::Vector2D position;
+    };
+
+    /**************************************************************************************************
+     * <summary>Records where every body is, in object list order, for Render to blend from.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void CapturePreviousPositions();
+
+    /**************************************************************************************************
+     * <summary>Calculates the screen area a body's bounding rectangle is drawn over by a camera.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Places the body the way Render does, padded by a pixel or two for outlines.</remarks>
+     * <param name="camera">  The camera.</param>
+     * <param name="body">    The body.</param>
+     * <param name="position">The body position to place it at.</param>
+     * <param name="bounds">  [out] The screen area.</param>
+     * <returns>true if it succeeds, false if the body has no bounding rectangle.</returns>
+     **************************************************************************************************/
+    bool CalculateScreenBounds(const Camera& camera, const a2de::RigidBody& body, const a2de::Vector2D& position, a2de::Rectangle& bounds) const;
+
+    /**************************************************************************************************
+     * <summary>Marks the screen areas a body covered and now covers in every camera as dirty.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="body">        The body.</param>
+     * <param name="old_position">The position it was drawn at.</param>
+     * <param name="new_position">The position it will be drawn at.</param>
+     **************************************************************************************************/
+    void InvalidateBody(const a2de::RigidBody& body, const a2de::Vector2D& old_position, const a2de::Vector2D& new_position);
+
+    /**************************************************************************************************
+     * <summary>Reports what the last step changed on screen to DirtyRegions.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The whole screen is dirty if a camera moved, else the bodies that moved are.</remarks>
+     **************************************************************************************************/
+    void InvalidateDirtyRegions();
+
+    /**************************************************************************************************
+     * <summary>Brings the grid and query index up to date with the bodies.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The grid is only rebuilt when objects were added, removed or restored; movement since
+     *          the last step is absorbed by growing the query margin instead. The margin only
+     *          covers the typical body; one that reaches much further is always a candidate.</remarks>
+     **************************************************************************************************/
+    void RefreshQueryIndex();
+
+    /**************************************************************************************************
+     * <summary>Maps grid elements back to query proxies, skipping duplicates.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="elements">The grid elements.</param>
+     **************************************************************************************************/
+    void GatherQueryCandidates(const std::vector<a2de::Vector2D>& elements);
+
+    /**************************************************************************************************
+     * <summary>Finds the query proxies whose bounding rectangle overlaps an area.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The query index must be up to date. The proxy indices are left in the candidate
+     *          list.</remarks>
+     * <param name="area">The area.</param>
+     **************************************************************************************************/
+    void FindOverlappingProxies(const a2de::Rectangle& area);
+
+    /**************************************************************************************************
+     * <summary>Sweeps a box or circle against a query proxy.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="proxy">       The proxy.</param>
+     * <param name="start">       The start of the sweep.</param>
+     * <param name="end">         The end of the sweep.</param>
+     * <param name="half_extents">The half extents of the swept box. Zero for a ray.</param>
+     * <param name="radius">      The radius of the swept circle, or zero for a box.</param>
+     * <param name="hit">         [out] The hit.</param>
+     * <returns>true if the proxy was hit, false if not.</returns>
+     **************************************************************************************************/
+    bool CastQueryProxy(const QueryProxy& proxy, const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& half_extents, double radius, RaycastHit& hit) const;
+
+    /**************************************************************************************************
+     * <summary>Sweeps a box or circle through the world.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          The query index must be up to date.</remarks>
+     * <param name="start">       The start of the sweep.</param>
+     * <param name="end">         The end of the sweep.</param>
+     * <param name="half_extents">The half extents of the swept box. Zero for a ray.</param>
+     * <param name="radius">      The radius of the swept circle, or zero for a box.</param>
+     * <param name="hit">         [out] The closest hit.</param>
+     * <param name="all_hits">    [in,out] If non-null, every hit is appended here.</param>
+     * <returns>true if something was hit, false if not.</returns>
+     **************************************************************************************************/
+    bool Sweep(const a2de::Vector2D& start, const a2de::Vector2D& end, const a2de::Vector2D& half_extents, double radius, RaycastHit& hit, std::vector<RaycastHit>* all_hits);
+
+
     /**************************************************************************************************
      * <summary>Deallocates the world.</summary>
      * <remarks>Casey Ugone, 8/15/2013.</remarks>
@@ -401,6 +791,36 @@ private:
      **************************************************************************************************/
     void NarrowPhaseCollision(a2de::World::ContactPairs& contact_pairs, double deltaTime);
 
+    /**************************************************************************************************
+     * <summary>Wakes both bodies and runs the velocity and position solvers.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="first_body">[in,out] If non-null, the first body.</param>
+     * <param name="second_body">[in,out] If non-null, the second body.</param>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void ResolveContact(a2de::RigidBody* first_body, a2de::RigidBody* second_body, double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Tests the collision masks of two bodies whose bounding rectangles overlap.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Each mask is centered on its body's bounding rectangle. A body without a mask is
+     *          tested as its whole bounding rectangle.</remarks>
+     * <param name="first">The first body.</param>
+     * <param name="second">The second body.</param>
+     * <returns>true if neither body has a mask or solid pixels overlap, false if not.</returns>
+     **************************************************************************************************/
+    bool MasksOverlap(const a2de::RigidBody& first, const a2de::RigidBody& second) const;
+
+    /**************************************************************************************************
+     * <summary>Orders contact pairs by the position of their bodies in the object list.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Each pair is oriented so the earlier body comes first and mirrored duplicates are
+     *          removed.</remarks>
+     * <param name="contact_pairs">The contact pairs.</param>
+     * <returns>The ordered contact pairs.</returns>
+     **************************************************************************************************/
+    std::vector<ContactPair> OrderContactPairs(const a2de::World::ContactPairs& contact_pairs) const;
+
     /**************************************************************************************************
      * <summary>Interpenetration solver.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -506,6 +926,69 @@ private:
    /// <summary> The spatial partition grid </summary>
    a2de::QuadTree<a2de::Vector2D>* _grid;
 
+   /// <summary> The number of completed steps </summary>
+   unsigned long _step;
+
+   /// <summary> The recent snapshots </summary>
+   SnapshotHistory _history;
+
+   /// <summary> true if contacts are resolved in a fixed order </summary>
+   bool _deterministic;
+
+   /// <summary> The rolling state hash </summary>
+   unsigned long long _state_hash;
+
+   /// <summary> The most recent step's statistics </summary>
+   WorldStepStats _stats;
+
+   /// <summary> The positions added to the grid by the last rebuild </summary>
+   std::vector<a2de::Vector2D> _grid_positions;
+
+   /// <summary> The objects added to the grid by the last rebuild, parallel to the positions </summary>
+   std::vector<a2de::Object*> _grid_objects;
+
+   /// <summary> The query index, sorted by grid position </summary>
+   std::vector<QueryProxy> _query_proxies;
+
+   /// <summary> Per-proxy stamps used to skip duplicate grid elements </summary>
+   std::vector<unsigned long> _query_marks;
+
+   /// <summary> The stamp of the current query </summary>
+   unsigned long _query_stamp;
+
+   /// <summary> The proxies whose grid position was outside the world bounds </summary>
+   std::vector<std::size_t> _query_outside;
+
+   /// <summary> The proxies reaching further from their grid position than the margin </summary>
+   std::vector<std::size_t> _query_oversized;
+
+   /// <summary> Scratch storage for finding the median distance a proxy reaches from its grid position </summary>
+   std::vector<double> _query_reaches;
+
+   /// <summary> Scratch storage for grid elements </summary>
+   std::vector<a2de::Vector2D> _query_elements;
+
+   /// <summary> Scratch storage for candidate proxy indices </summary>
+   std::vector<std::size_t> _query_candidates;
+
+   /// <summary> Twice the median distance from a grid position to the edge of its bounding rectangle </summary>
+   a2de::Vector2D _query_margin;
+
+   /// <summary> true if the grid no longer matches the object list </summary>
+   bool _query_grid_dirty;
+
+   /// <summary> true if the bodies have moved since the query index was built </summary>
+   bool _query_index_dirty;
+
+   /// <summary> The objects to draw for the current camera </summary>
+   RenderQueue _render_queue;
+
+   /// <summary> The body positions before the last step, in the order of the query proxies </summary>
+   std::vector<PreviousPosition> _previous_positions;
+
+   /// <summary> The camera positions at the last step, to tell when the whole screen is dirty </summary>
+   std::vector<a2de::Vector2D> _dirty_camera_positions;
+
 };
 
 A2DE_END
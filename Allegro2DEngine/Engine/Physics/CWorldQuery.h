@@ -0,0 +1,68 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CWorldQuery.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the world query structures
+ **************************************************************************************************/
+#ifndef A2DE_CWORLDQUERY_H
+#define A2DE_CWORLDQUERY_H
+
+#include "../a2de_vals.h"
+#include "../Math/CVector2D.h"
+
+A2DE_BEGIN
+
+class Object;
+
+/**************************************************************************************************
+* <summary>A line segment to cast into the world.</summary>
+* <remarks>Casey Ugone, 10/19/2026.</remarks>
+**************************************************************************************************/
+struct RayQuery {
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    RayQuery() : start(), end() { /* DO NOTHING */ }
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="start">The start of the ray.</param>
+     * <param name="end">  The end of the ray.</param>
+     **************************************************************************************************/
+    RayQuery(const a2de::Vector2D& start, const a2de::Vector2D& end) : start(start), end(end) { /* DO NOTHING */ }
+
+    /// <summary> The start of the ray in world units.</summary>
+    a2de::Vector2D start;
+    /// <summary> The end of the ray in world units.</summary>
+    a2de::Vector2D end;
+};
+
+/**************************************************************************************************
+* <summary>The result of a raycast or shape cast.</summary>
+* <remarks>Casey Ugone, 10/19/2026.</remarks>
+**************************************************************************************************/
+struct RaycastHit {
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    RaycastHit() : object(nullptr), point(), normal(), fraction(0.0) { /* DO NOTHING */ }
+
+    /// <summary> The object that was hit, or null if nothing was hit.</summary>
+    a2de::Object* object;
+    /// <summary> The point of contact. For shape casts, the position of the shape at contact.</summary>
+    a2de::Vector2D point;
+    /// <summary> The surface normal at the point of contact. Zero if the cast started inside the object.</summary>
+    a2de::Vector2D normal;
+    /// <summary> The distance along the cast of the contact, from 0 at the start to 1 at the end.</summary>
+    double fraction;
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,171 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CWorldSnapshot.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the world snapshot classes
+ **************************************************************************************************/
+#include "CWorldSnapshot.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include "../a2de_exceptions.h"
+
+A2DE_BEGIN
+
+BodySnapshot::BodySnapshot() {
+    std::memset(this, 0, sizeof(BodySnapshot));
+}
+
+WorldSnapshot::WorldSnapshot() : _step(0), _state_hash(0), _bodies(), _forces(), _impulses() { /* DO NOTHING */ }
+
+WorldSnapshot::WorldSnapshot(const WorldSnapshot& other) : _step(other._step), _state_hash(other._state_hash), _bodies(other._bodies), _forces(other._forces), _impulses(other._impulses) { /* DO NOTHING */ }
+
+WorldSnapshot& WorldSnapshot::operator=(const WorldSnapshot& rhs) {
+    if(this == &rhs) return *this;
+
+    //assign reuses existing capacity, which is what keeps the history ring allocation free.
+    this->_step = rhs._step;
+    this->_state_hash = rhs._state_hash;
+    this->_bodies.assign(rhs._bodies.begin(), rhs._bodies.end());
+    this->_forces.assign(rhs._forces.begin(), rhs._forces.end());
+    this->_impulses.assign(rhs._impulses.begin(), rhs._impulses.end());
+
+    return *this;
+}
+
+WorldSnapshot::~WorldSnapshot() { /* DO NOTHING */ }
+
+unsigned long WorldSnapshot::GetStep() const {
+    return _step;
+}
+
+std::size_t WorldSnapshot::GetBodyCount() const {
+    return _bodies.size();
+}
+
+unsigned long long WorldSnapshot::GetStateHash() const {
+    return _state_hash;
+}
+
+const BodySnapshot& WorldSnapshot::GetBody(std::size_t index) const {
+    if(index >= _bodies.size()) throw a2de::IndexOutOfBoundsException("index", "0", "_bodies.size() - 1");
+    return _bodies[index];
+}
+
+bool WorldSnapshot::IsEmpty() const {
+    return _bodies.empty();
+}
+
+void WorldSnapshot::Clear() {
+    _step = 0;
+    _state_hash = 0;
+    _bodies.clear();
+    _forces.clear();
+    _impulses.clear();
+}
+
+WorldSnapshotDelta WorldSnapshot::CreateDelta(const WorldSnapshot& base) const {
+    WorldSnapshotDelta delta;
+    delta._base_step = base._step;
+    delta._step = _step;
+    delta._state_hash = _state_hash;
+    delta._base_body_count = base._bodies.size();
+    delta._body_count = _bodies.size();
+
+    bool same_layout = base._bodies.size() == _bodies.size();
+    std::size_t body_count = _bodies.size();
+    for(std::size_t i = 0; i < body_count; ++i) {
+        if(same_layout && std::memcmp(&base._bodies[i], &_bodies[i], sizeof(BodySnapshot)) == 0) continue;
+        delta._indices.push_back(static_cast<unsigned long>(i));
+        delta._bodies.push_back(_bodies[i]);
+    }
+
+    //Force and impulse arrays are short-lived and indexed by the body records; storing them whole
+    //keeps the body offsets valid without re-basing them.
+    delta._forces = _forces;
+    delta._impulses = _impulses;
+
+    return delta;
+}
+
+bool WorldSnapshot::ApplyDelta(const WorldSnapshotDelta& delta) {
+    if(delta._base_step != _step) return false;
+    if(delta._base_body_count != _bodies.size()) return false;
+
+    _bodies.resize(delta._body_count);
+    std::size_t changed_count = delta._indices.size();
+    for(std::size_t i = 0; i < changed_count; ++i) {
+        _bodies[delta._indices[i]] = delta._bodies[i];
+    }
+    _forces.assign(delta._forces.begin(), delta._forces.end());
+    _impulses.assign(delta._impulses.begin(), delta._impulses.end());
+    _step = delta._step;
+    _state_hash = delta._state_hash;
+    return true;
+}
+
+WorldSnapshotDelta::WorldSnapshotDelta() : _base_step(0), _step(0), _state_hash(0), _base_body_count(0), _body_count(0), _indices(), _bodies(), _forces(), _impulses() { /* DO NOTHING */ }
+
+unsigned long WorldSnapshotDelta::GetBaseStep() const {
+    return _base_step;
+}
+
+unsigned long WorldSnapshotDelta::GetStep() const {
+    return _step;
+}
+
+std::size_t WorldSnapshotDelta::GetChangedBodyCount() const {
+    return _indices.size();
+}
+
+SnapshotHistory::SnapshotHistory(std::size_t max_steps) : _ring(max_steps), _head(0), _size(0) { /* DO NOTHING */ }
+
+std::size_t SnapshotHistory::GetCapacity() const {
+    return _ring.size();
+}
+
+void SnapshotHistory::SetCapacity(std::size_t max_steps) {
+    _ring.resize(max_steps);
+    Clear();
+}
+
+std::size_t SnapshotHistory::GetSize() const {
+    return _size;
+}
+
+WorldSnapshot* SnapshotHistory::Next() {
+    if(_ring.empty()) return nullptr;
+    WorldSnapshot* slot = &_ring[_head];
+    _head = (_head + 1) % _ring.size();
+    if(_size < _ring.size()) ++_size;
+    return slot;
+}
+
+const WorldSnapshot* SnapshotHistory::Find(unsigned long step) const {
+    std::size_t capacity = _ring.size();
+    for(std::size_t i = 0; i < _size; ++i) {
+        //Walk backwards from the newest entry; rollbacks almost always target recent steps.
+        std::size_t index = (_head + capacity - 1 - i) % capacity;
+        if(_ring[index].GetStep() == step) return &_ring[index];
+    }
+    return nullptr;
+}
+
+void SnapshotHistory::DiscardAfter(unsigned long step) {
+    std::size_t capacity = _ring.size();
+    while(_size > 0) {
+        std::size_t newest = (_head + capacity - 1) % capacity;
+        if(_ring[newest].GetStep() <= step) break;
+        _head = newest;
+        --_size;
+    }
+}
+
+void SnapshotHistory::Clear() {
+    _head = 0;
+    _size = 0;
+}
+
+A2DE_END
@@ -0,0 +1,333 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CWorldSnapshot.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the world snapshot classes
+ **************************************************************************************************/
+#ifndef A2DE_CWORLDSNAPSHOT_H
+#define A2DE_CWORLDSNAPSHOT_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+#include <cstddef>
+
+A2DE_BEGIN
+
+class World;
+class WorldSnapshotDelta;
+
+/**************************************************************************************************
+ * <summary>Flat copy of the simulated portion of a single rigid body.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Plain data only: no shapes, bounding boxes or containers. Pending forces and impulses
+ *          are stored in the owning snapshot and referenced by index.</remarks>
+ **************************************************************************************************/
+struct BodySnapshot {
+
+    /**************************************************************************************************
+     * <summary>Default constructor. Zeroes every byte so records can be compared with memcmp.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    BodySnapshot();
+
+    /// <summary> The mass.</summary>
+    double mass;
+    /// <summary> The gravity modifier in the x-direction.</summary>
+    double gravity_mod_x;
+    /// <summary> The gravity modifier in the y-direction.</summary>
+    double gravity_mod_y;
+    /// <summary> The x position.</summary>
+    double position_x;
+    /// <summary> The y position.</summary>
+    double position_y;
+    /// <summary> The x velocity.</summary>
+    double velocity_x;
+    /// <summary> The y velocity.</summary>
+    double velocity_y;
+    /// <summary> The x acceleration.</summary>
+    double acceleration_x;
+    /// <summary> The y acceleration.</summary>
+    double acceleration_y;
+    /// <summary> The velocity damper.</summary>
+    double damper;
+    /// <summary> The cached density.</summary>
+    double density;
+    /// <summary> Index of the first pending force in the snapshot's force array.</summary>
+    unsigned long first_force;
+    /// <summary> Number of pending forces.</summary>
+    unsigned long force_count;
+    /// <summary> Index of the first pending impulse in the snapshot's impulse array.</summary>
+    unsigned long first_impulse;
+    /// <summary> Number of pending impulses.</summary>
+    unsigned long impulse_count;
+    /// <summary> true if the body is awake.</summary>
+    bool active;
+};
+
+/**************************************************************************************************
+ * <summary>Flat copy of a pending force or impulse.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.</remarks>
+ **************************************************************************************************/
+struct ForceSnapshot {
+    /// <summary> The x component.</summary>
+    double x;
+    /// <summary> The y component.</summary>
+    double y;
+    /// <summary> The remaining duration in seconds. Always zero for impulses.</summary>
+    double duration;
+};
+
+/**************************************************************************************************
+ * <summary>The complete simulated state of a World at one step.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Bodies are stored in World object order. A snapshot is only valid for the World that
+ *          produced it as long as no objects with bodies have been added or removed.</remarks>
+ **************************************************************************************************/
+class WorldSnapshot {
+public:
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    WorldSnapshot();
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    WorldSnapshot(const WorldSnapshot& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator. Reuses existing storage when it is large enough.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A deep copy of this object.</returns>
+     **************************************************************************************************/
+    WorldSnapshot& operator=(const WorldSnapshot& rhs);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    ~WorldSnapshot();
+
+    /**************************************************************************************************
+     * <summary>Gets the World step the snapshot was taken at.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The step.</returns>
+     **************************************************************************************************/
+    unsigned long GetStep() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the number of bodies stored.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The body count.</returns>
+     **************************************************************************************************/
+    std::size_t GetBodyCount() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the World's rolling state hash at the time the snapshot was taken.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The state hash.</returns>
+     **************************************************************************************************/
+    unsigned long long GetStateHash() const;
+
+    /**************************************************************************************************
+     * <summary>Gets a stored body.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="index">Zero-based index of the body in World object order.</param>
+     * <exception cref="IndexOutOfBoundsException">Thrown when the index is out of range.</exception>
+     * <returns>The body.</returns>
+     **************************************************************************************************/
+    const BodySnapshot& GetBody(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Determines if the snapshot holds no bodies.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>true if empty, false if not.</returns>
+     **************************************************************************************************/
+    bool IsEmpty() const;
+
+    /**************************************************************************************************
+     * <summary>Clears the snapshot without releasing its storage.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Creates a delta that turns base into this snapshot.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.
+     *          Only bodies whose records differ from base are stored. If the body counts differ
+     *          every body is stored.</remarks>
+     * <param name="base">The snapshot the delta will be applied to.</param>
+     * <returns>The delta.</returns>
+     **************************************************************************************************/
+    WorldSnapshotDelta CreateDelta(const WorldSnapshot& base) const;
+
+    /**************************************************************************************************
+     * <summary>Applies a delta created against this snapshot.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="delta">The delta.</param>
+     * <returns>true if it succeeds, false if the delta was not created against this snapshot.</returns>
+     **************************************************************************************************/
+    bool ApplyDelta(const WorldSnapshotDelta& delta);
+
+protected:
+private:
+
+    /// <summary> The World step.</summary>
+    unsigned long _step;
+    /// <summary> The World's rolling state hash.</summary>
+    unsigned long long _state_hash;
+    /// <summary> The bodies in World object order.</summary>
+    std::vector<BodySnapshot> _bodies;
+    /// <summary> The pending forces of every body.</summary>
+    std::vector<ForceSnapshot> _forces;
+    /// <summary> The pending impulses of every body.</summary>
+    std::vector<ForceSnapshot> _impulses;
+
+    friend class World;
+};
+
+/**************************************************************************************************
+ * <summary>The difference between two snapshots.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.</remarks>
+ **************************************************************************************************/
+class WorldSnapshotDelta {
+public:
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    WorldSnapshotDelta();
+
+    /**************************************************************************************************
+     * <summary>Gets the step of the snapshot the delta applies to.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The base step.</returns>
+     **************************************************************************************************/
+    unsigned long GetBaseStep() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the step of the snapshot the delta produces.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The step.</returns>
+     **************************************************************************************************/
+    unsigned long GetStep() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the number of changed bodies.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The changed body count.</returns>
+     **************************************************************************************************/
+    std::size_t GetChangedBodyCount() const;
+
+protected:
+private:
+
+    /// <summary> The base step.</summary>
+    unsigned long _base_step;
+    /// <summary> The resulting step.</summary>
+    unsigned long _step;
+    /// <summary> The resulting state hash.</summary>
+    unsigned long long _state_hash;
+    /// <summary> The body count of the base snapshot.</summary>
+    std::size_t _base_body_count;
+    /// <summary> The body count of the resulting snapshot.</summary>
+    std::size_t _body_count;
+    /// <summary> The indices of the changed bodies.</summary>
+    std::vector<unsigned long> _indices;
+    /// <summary> The changed bodies, parallel to _indices.</summary>
+    std::vector<BodySnapshot> _bodies;
+    /// <summary> The complete pending force array of the resulting snapshot.</summary>
+    std::vector<ForceSnapshot> _forces;
+    /// <summary> The complete pending impulse array of the resulting snapshot.</summary>
+    std::vector<ForceSnapshot> _impulses;
+
+    friend class WorldSnapshot;
+};
+
+/**************************************************************************************************
+ * <summary>Fixed size ring buffer of the most recent World snapshots.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Slots are recycled in place so recording a step does not allocate once the buffer has
+ *          filled.</remarks>
+ **************************************************************************************************/
+class SnapshotHistory {
+public:
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="max_steps">The number of steps to keep.</param>
+     **************************************************************************************************/
+    SnapshotHistory(std::size_t max_steps);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of steps kept.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The capacity.</returns>
+     **************************************************************************************************/
+    std::size_t GetCapacity() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the number of steps kept. Discards all recorded steps.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="max_steps">The number of steps to keep.</param>
+     **************************************************************************************************/
+    void SetCapacity(std::size_t max_steps);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of steps recorded.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The size.</returns>
+     **************************************************************************************************/
+    std::size_t GetSize() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the slot for the next step, overwriting the oldest one when full.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>null if the capacity is zero, else the slot to fill.</returns>
+     **************************************************************************************************/
+    WorldSnapshot* Next();
+
+    /**************************************************************************************************
+     * <summary>Finds the snapshot taken at a step.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="step">The step.</param>
+     * <returns>null if the step is not in the history, else the snapshot.</returns>
+     **************************************************************************************************/
+    const WorldSnapshot* Find(unsigned long step) const;
+
+    /**************************************************************************************************
+     * <summary>Discards every step recorded after the given step.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="step">The last step to keep.</param>
+     **************************************************************************************************/
+    void DiscardAfter(unsigned long step);
+
+    /**************************************************************************************************
+     * <summary>Discards all recorded steps without releasing storage.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+protected:
+private:
+
+    /// <summary> The slots.</summary>
+    std::vector<WorldSnapshot> _ring;
+    /// <summary> Index of the slot Next will return.</summary>
+    std::size_t _head;
+    /// <summary> The number of recorded steps.</summary>
+    std::size_t _size;
+};
+
+A2DE_END
+
+#endif
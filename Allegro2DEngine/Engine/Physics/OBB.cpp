@@ -12,6 +12,8 @@
 #include "../Math/CVector4D.h"
 #include <allegro5/allegro_primitives.h>
 
+#include "../GFX/CPrimitiveBatch.h"
+
 A2DE_BEGIN
 
 OBB::OBB() : _transform_instance(), _half_extents(), _points(4), _color() { /* DO NOTHING */ }
@@ -116,18 +118,13 @@ void OBB::Draw(ALLEGRO_BITMAP* dest) {
     double btrx = _points[POINTS_BOTTOM_RIGHT].GetX();
     double btry = _points[POINTS_BOTTOM_RIGHT].GetY();
 
-    ALLEGRO_BITMAP* old_target_bitmap = al_get_target_bitmap();
-    al_set_target_bitmap(dest);
-
-    //al_draw_triangle(a2de::Math::ToScreenScale(tplx), a2de::Math::ToScreenScale(tply), a2de::Math::ToScreenScale(tprx), a2de::Math::ToScreenScale(tpry), a2de::Math::ToScreenScale(btrx), a2de::Math::ToScreenScale(btry), this->_color, 0.0);
-    //al_draw_triangle(a2de::Math::ToScreenScale(tplx), a2de::Math::ToScreenScale(tply), a2de::Math::ToScreenScale(btrx), a2de::Math::ToScreenScale(btry), a2de::Math::ToScreenScale(btlx), a2de::Math::ToScreenScale(btly), this->_color, 0.0);
-
-    al_draw_line(a2de::Math::ToScreenScale(btlx), a2de::Math::ToScreenScale(btly), a2de::Math::ToScreenScale(tplx), a2de::Math::ToScreenScale(tply), this->_color, 0.0);
-    al_draw_line(a2de::Math::ToScreenScale(tplx), a2de::Math::ToScreenScale(tply), a2de::Math::ToScreenScale(tprx), a2de::Math::ToScreenScale(tpry), this->_color, 0.0);
-    al_draw_line(a2de::Math::ToScreenScale(tprx), a2de::Math::ToScreenScale(tpry), a2de::Math::ToScreenScale(btrx), a2de::Math::ToScreenScale(btry), this->_color, 0.0);
-    al_draw_line(a2de::Math::ToScreenScale(btrx), a2de::Math::ToScreenScale(btry), a2de::Math::ToScreenScale(btlx), a2de::Math::ToScreenScale(btly), this->_color, 0.0);
-
-    al_set_target_bitmap(old_target_bitmap);
+    float corners[8] = {
+        static_cast<float>(a2de::Math::ToScreenScale(tplx)), static_cast<float>(a2de::Math::ToScreenScale(tply)),
+        static_cast<float>(a2de::Math::ToScreenScale(tprx)), static_cast<float>(a2de::Math::ToScreenScale(tpry)),
+        static_cast<float>(a2de::Math::ToScreenScale(btrx)), static_cast<float>(a2de::Math::ToScreenScale(btry)),
+        static_cast<float>(a2de::Math::ToScreenScale(btlx)), static_cast<float>(a2de::Math::ToScreenScale(btly)),
+        };
+    PrimitiveBatch::DrawPolygon(dest, corners, 4, this->_color, false);
 }
 
 const a2de::Transform2D& OBB::GetTransform() const {
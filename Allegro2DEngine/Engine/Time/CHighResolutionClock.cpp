@@ -0,0 +1,53 @@
+/**************************************************************************************************
+// file:	Engine\Time\CHighResolutionClock.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the high resolution clock class
+ **************************************************************************************************/
+#include "CHighResolutionClock.h"
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <chrono>
+#endif
+
+A2DE_BEGIN
+
+unsigned long long HighResolutionClock::GetTicks() {
+#ifdef _WIN32
+    LARGE_INTEGER ticks;
+    QueryPerformanceCounter(&ticks);
+    return static_cast<unsigned long long>(ticks.QuadPart);
+#else
+    return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+unsigned long long HighResolutionClock::GetFrequency() {
+#ifdef _WIN32
+    //Fixed at boot; query it once.
+    static unsigned long long frequency = 0;
+    if(frequency == 0) {
+        LARGE_INTEGER result;
+        QueryPerformanceFrequency(&result);
+        frequency = static_cast<unsigned long long>(result.QuadPart);
+    }
+    return frequency;
+#else
+    return 1000000000ULL;
+#endif
+}
+
+double HighResolutionClock::ToSeconds(unsigned long long ticks) {
+    return static_cast<double>(ticks) / static_cast<double>(GetFrequency());
+}
+
+A2DE_END
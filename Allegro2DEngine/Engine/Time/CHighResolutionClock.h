@@ -0,0 +1,60 @@
+/**************************************************************************************************
+// file:	Engine\Time\CHighResolutionClock.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the high resolution clock class
+ **************************************************************************************************/
+#ifndef A2DE_CHIGHRESOLUTIONCLOCK_H
+#define A2DE_CHIGHRESOLUTIONCLOCK_H
+
+#include "../a2de_vals.h"
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>Monotonic, high resolution tick source for profiling.</summary>
+ * <remarks>Casey Ugone, 10/19/2026.
+ *          Uses QueryPerformanceCounter on Windows, where std::chrono's high resolution clock is
+ *          only as fine as the system clock, and steady_clock elsewhere. Unlike Timer and StopWatch
+ *          it measures wall time, not processor time.</remarks>
+ **************************************************************************************************/
+class HighResolutionClock {
+public:
+
+    /**************************************************************************************************
+     * <summary>Gets the current tick count.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The ticks since an arbitrary fixed point.</returns>
+     **************************************************************************************************/
+    static unsigned long long GetTicks();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of ticks per second.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <returns>The frequency.</returns>
+     **************************************************************************************************/
+    static unsigned long long GetFrequency();
+
+    /**************************************************************************************************
+     * <summary>Converts a tick count to seconds.</summary>
+     * <remarks>Casey Ugone, 10/19/2026.</remarks>
+     * <param name="ticks">The ticks.</param>
+     * <returns>The number of seconds.</returns>
+     **************************************************************************************************/
+    static double ToSeconds(unsigned long long ticks);
+
+private:
+    //Creation of object of type HighResolutionClock is illegal,
+    //all methods are static anyway.
+    //Use of these methods will result in a linker error.
+    HighResolutionClock();
+    HighResolutionClock(const HighResolutionClock&);
+    HighResolutionClock& operator=(const HighResolutionClock&);
+    ~HighResolutionClock();
+
+};
+
+A2DE_END
+
+#endif
@@ -14,10 +14,23 @@
 #include "GFX/CAnimatedSprite.h"
 #include "GFX/CSpriteHandler.h"
 #include "GFX/CBitmapCache.h"
+#include "GFX/CCollisionMask.h"
 #include "GFX/CAnimationFrame.h"
 #include "GFX/CAnimationFrameSet.h"
 #include "GFX/CAnimationHandler.h"
+#include "GFX/CAnimationSystem.h"
 #include "GFX/CTileSet.h"
+#include "GFX/CRenderQueue.h"
+#include "GFX/CTextureAtlas.h"
+#include "GFX/CPixelCache.h"
+#include "GFX/CAssetPack.h"
+#include "GFX/CTileMap.h"
+#include "GFX/CPrimitiveBatch.h"
+#include "GFX/CRenderCommandList.h"
+#include "GFX/CRenderThread.h"
+#include "GFX/CDirtyRegions.h"
+#include "GFX/CSoftwareBlitter.h"
+#include "GFX/CParticleEmitter.h"
 
 
 #endif
\ No newline at end of file
@@ -26,5 +26,6 @@
 #include "Math/CSpline.h"
 #include "Math/CTransform.h"
 #include "Math/CTransform2D.h"
+#include "Math/CMatrix2x3.h"
 
 #endif
\ No newline at end of file
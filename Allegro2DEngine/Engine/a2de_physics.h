@@ -23,5 +23,7 @@
 #include "Physics/CPhysicsArea.h"
 #include "Physics/CFluidPhysicsArea.h"
 #include "Physics/CContactPair.h"
+#include "Physics/CWorldSnapshot.h"
+#include "Physics/CWorldQuery.h"
 
 #endif
\ No newline at end of file
@@ -13,5 +13,6 @@
 #include "Time/CTimer.h"
 #include "Time/CStopwatch.h"
 #include "Time/CAlarm.h"
+#include "Time/CHighResolutionClock.h"
 
 #endif
\ No newline at end of file
@@ -12,6 +12,10 @@
 #define DEBUGMODE
 #endif
 
+//Define A2DE_PROFILE_PHYSICS to collect the per-phase timings and counters
+//returned by World::GetStepStats. Without it the instrumentation compiles away.
+//#define A2DE_PROFILE_PHYSICS
+
 #include <allegro5/base.h>
 
 #if ALLEGRO_VERSION == 5
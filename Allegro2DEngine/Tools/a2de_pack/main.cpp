@@ -0,0 +1,89 @@
+/**************************************************************************************************
+// file:	Tools\a2de_pack\main.cpp
+// A2DE
+// Copyright (c) 2014 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Asset pack builder. Stores every file under the given directories, and any files
+//          given directly, in one pack for AssetPack::Mount.
+//
+//          Build as a console executable against the Engine sources. Link allegro,
+//          allegro_image and allegro_memfile.
+//
+//          Files are stored under the paths they were found by, so run it from the directory the
+//          game runs from and pass the same relative paths the game loads, e.g.
+//          a2de_pack data.a2pk Data
+//
+//          usage: a2de_pack output_file path [path...]
+ **************************************************************************************************/
+#include "../../Engine/a2de_vals.h"
+#include "../../Engine/GFX/CAssetPack.h"
+
+#include <allegro5/allegro.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+void CollectFiles(ALLEGRO_FS_ENTRY* directory, std::vector<std::string>& files) {
+    if(al_open_directory(directory) == false) return;
+    ALLEGRO_FS_ENTRY* entry = nullptr;
+    while((entry = al_read_directory(directory)) != nullptr) {
+        if(al_get_fs_entry_mode(entry) & ALLEGRO_FILEMODE_ISDIR) {
+            CollectFiles(entry, files);
+        } else {
+            files.push_back(al_get_fs_entry_name(entry));
+        }
+        al_destroy_fs_entry(entry);
+    }
+    al_close_directory(directory);
+}
+
+}
+
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        std::fprintf(stderr, "usage: %s output_file path [path...]\n", argv[0]);
+        return 1;
+    }
+
+    if(al_init() == false) {
+        std::fprintf(stderr, "Allegro failed to initialize.\n");
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    for(int i = 2; i < argc; ++i) {
+        ALLEGRO_FS_ENTRY* entry = al_create_fs_entry(argv[i]);
+        if(entry == nullptr || al_fs_entry_exists(entry) == false) {
+            std::fprintf(stderr, "'%s' does not exist.\n", argv[i]);
+            if(entry != nullptr) al_destroy_fs_entry(entry);
+            return 1;
+        }
+        //Directories are walked; al_get_fs_entry_name keeps the path relative as given.
+        if(al_get_fs_entry_mode(entry) & ALLEGRO_FILEMODE_ISDIR) {
+            CollectFiles(entry, files);
+        } else {
+            files.push_back(argv[i]);
+        }
+        al_destroy_fs_entry(entry);
+    }
+    if(files.empty()) {
+        std::fprintf(stderr, "Nothing to pack.\n");
+        return 1;
+    }
+
+    if(a2de::AssetPack::Build(argv[1], files) == false) {
+        std::fprintf(stderr, "Could not write '%s'.\n", argv[1]);
+        return 1;
+    }
+    if(a2de::AssetPack::Mount(argv[1]) == false) {
+        std::fprintf(stderr, "'%s' was written but does not mount.\n", argv[1]);
+        return 1;
+    }
+    a2de::AssetPack::UnmountAll();
+
+    std::printf("Packed %lu files into '%s'.\n", static_cast<unsigned long>(files.size()), argv[1]);
+    return 0;
+}